@@ -3,7 +3,7 @@
  *
  * Generator: C/C++
  * Specification: gl
- * Extensions: 94
+ * Extensions: 97
  *
  * APIs:
  *  - gl:compatibility=4.6
@@ -19,10 +19,10 @@
  *  - MX = False
  *
  * Commandline:
- *    --merge --api='gl:compatibility=4.6,gles1:common=1.0' --extensions='GL_ARB_ES2_compatibility,GL_ARB_ES3_1_compatibility,GL_ARB_base_instance,GL_ARB_blend_func_extended,GL_ARB_buffer_storage,GL_ARB_clear_buffer_object,GL_ARB_clear_texture,GL_ARB_clip_control,GL_ARB_compute_shader,GL_ARB_copy_buffer,GL_ARB_copy_image,GL_ARB_direct_state_access,GL_ARB_draw_elements_base_vertex,GL_ARB_draw_indirect,GL_ARB_fragment_program,GL_ARB_fragment_shader,GL_ARB_framebuffer_no_attachments,GL_ARB_framebuffer_object,GL_ARB_geometry_shader4,GL_ARB_get_program_binary,GL_ARB_get_texture_sub_image,GL_ARB_gpu_shader_fp64,GL_ARB_imaging,GL_ARB_internalformat_query,GL_ARB_internalformat_query2,GL_ARB_invalidate_subdata,GL_ARB_map_buffer_range,GL_ARB_multi_bind,GL_ARB_multi_draw_indirect,GL_ARB_multitexture,GL_ARB_polygon_offset_clamp,GL_ARB_program_interface_query,GL_ARB_provoking_vertex,GL_ARB_sampler_objects,GL_ARB_separate_shader_objects,GL_ARB_shader_atomic_counters,GL_ARB_shader_image_load_store,GL_ARB_shader_objects,GL_ARB_shader_storage_buffer_object,GL_ARB_shader_subroutine,GL_ARB_shading_language_100,GL_ARB_sync,GL_ARB_tessellation_shader,GL_ARB_texture_barrier,GL_ARB_texture_buffer_range,GL_ARB_texture_multisample,GL_ARB_texture_non_power_of_two,GL_ARB_texture_storage,GL_ARB_texture_storage_multisample,GL_ARB_texture_view,GL_ARB_timer_query,GL_ARB_transform_feedback2,GL_ARB_transform_feedback3,GL_ARB_transform_feedback_instanced,GL_ARB_uniform_buffer_object,GL_ARB_vertex_array_object,GL_ARB_vertex_attrib_64bit,GL_ARB_vertex_attrib_binding,GL_ARB_vertex_buffer_object,GL_ARB_vertex_program,GL_ARB_vertex_shader,GL_ARB_vertex_type_2_10_10_10_rev,GL_ARB_viewport_array,GL_EXT_blend_equation_separate,GL_EXT_blend_func_separate,GL_EXT_blend_minmax,GL_EXT_blend_subtract,GL_EXT_copy_texture,GL_EXT_framebuffer_blit,GL_EXT_framebuffer_multisample,GL_EXT_framebuffer_object,GL_EXT_geometry_shader4,GL_EXT_packed_depth_stencil,GL_EXT_subtexture,GL_EXT_texture_array,GL_EXT_texture_object,GL_EXT_texture_sRGB,GL_EXT_vertex_array,GL_INGR_blend_func_separate,GL_KHR_debug,GL_KHR_robustness,GL_NV_geometry_program4,GL_NV_vertex_program,GL_OES_single_precision,GL_SGIS_texture_edge_clamp,GL_EXT_sRGB,GL_OES_blend_equation_separate,GL_OES_blend_func_separate,GL_OES_blend_subtract,GL_OES_depth24,GL_OES_depth32,GL_OES_framebuffer_object,GL_OES_packed_depth_stencil,GL_OES_texture_npot' c --alias --header-only
+ *    --merge --api='gl:compatibility=4.6,gles1:common=1.0' --extensions='GL_ARB_ES2_compatibility,GL_ARB_ES3_1_compatibility,GL_ARB_ES3_compatibility,GL_ARB_base_instance,GL_ARB_blend_func_extended,GL_ARB_buffer_storage,GL_ARB_clear_buffer_object,GL_ARB_clear_texture,GL_ARB_clip_control,GL_ARB_compute_shader,GL_ARB_copy_buffer,GL_ARB_copy_image,GL_ARB_direct_state_access,GL_ARB_draw_elements_base_vertex,GL_ARB_draw_indirect,GL_ARB_fragment_program,GL_ARB_fragment_shader,GL_ARB_framebuffer_no_attachments,GL_ARB_framebuffer_object,GL_ARB_geometry_shader4,GL_ARB_get_program_binary,GL_ARB_get_texture_sub_image,GL_ARB_gpu_shader_fp64,GL_ARB_imaging,GL_ARB_internalformat_query,GL_ARB_internalformat_query2,GL_ARB_invalidate_subdata,GL_ARB_map_buffer_range,GL_ARB_multi_bind,GL_ARB_multi_draw_indirect,GL_ARB_multitexture,GL_ARB_polygon_offset_clamp,GL_ARB_program_interface_query,GL_ARB_provoking_vertex,GL_ARB_sampler_objects,GL_ARB_separate_shader_objects,GL_ARB_shader_atomic_counters,GL_ARB_shader_image_load_store,GL_ARB_shader_objects,GL_ARB_shader_storage_buffer_object,GL_ARB_shader_subroutine,GL_ARB_shading_language_100,GL_ARB_sync,GL_ARB_tessellation_shader,GL_ARB_texture_barrier,GL_ARB_texture_buffer_range,GL_ARB_texture_multisample,GL_ARB_texture_non_power_of_two,GL_ARB_texture_storage,GL_ARB_texture_storage_multisample,GL_ARB_texture_view,GL_ARB_timer_query,GL_ARB_transform_feedback2,GL_ARB_transform_feedback3,GL_ARB_transform_feedback_instanced,GL_ARB_uniform_buffer_object,GL_ARB_vertex_array_object,GL_ARB_vertex_attrib_64bit,GL_ARB_vertex_attrib_binding,GL_ARB_vertex_buffer_object,GL_ARB_vertex_program,GL_ARB_vertex_shader,GL_ARB_vertex_type_2_10_10_10_rev,GL_ARB_viewport_array,GL_EXT_blend_equation_separate,GL_EXT_blend_func_separate,GL_EXT_blend_minmax,GL_EXT_blend_subtract,GL_EXT_copy_texture,GL_EXT_framebuffer_blit,GL_EXT_framebuffer_multisample,GL_EXT_framebuffer_object,GL_EXT_geometry_shader4,GL_EXT_packed_depth_stencil,GL_EXT_subtexture,GL_EXT_texture_compression_s3tc,GL_EXT_texture_array,GL_EXT_texture_object,GL_EXT_texture_sRGB,GL_EXT_vertex_array,GL_INGR_blend_func_separate,GL_KHR_debug,GL_KHR_parallel_shader_compile,GL_KHR_robustness,GL_NV_geometry_program4,GL_NV_vertex_program,GL_OES_single_precision,GL_SGIS_texture_edge_clamp,GL_EXT_sRGB,GL_OES_blend_equation_separate,GL_OES_blend_func_separate,GL_OES_blend_subtract,GL_OES_depth24,GL_OES_depth32,GL_OES_framebuffer_object,GL_OES_packed_depth_stencil,GL_OES_texture_npot' c --alias --header-only
  *
  * Online:
- *    http://gen.glad.sh/#profile=gl%3Dcompatibility%2Cgles1%3Dcommon&api=gl%3D4.6%2Cgles1%3D1.0&extensions=GL_ARB_copy_buffer%2CGL_ARB_fragment_shader%2CGL_ARB_framebuffer_object%2CGL_ARB_geometry_shader4%2CGL_ARB_get_program_binary%2CGL_ARB_imaging%2CGL_ARB_multitexture%2CGL_ARB_separate_shader_objects%2CGL_ARB_shader_objects%2CGL_ARB_shading_language_100%2CGL_ARB_texture_non_power_of_two%2CGL_ARB_vertex_buffer_object%2CGL_ARB_vertex_program%2CGL_ARB_vertex_shader%2CGL_EXT_blend_equation_separate%2CGL_EXT_blend_func_separate%2CGL_EXT_blend_minmax%2CGL_EXT_blend_subtract%2CGL_EXT_copy_texture%2CGL_EXT_framebuffer_blit%2CGL_EXT_framebuffer_multisample%2CGL_EXT_framebuffer_object%2CGL_EXT_geometry_shader4%2CGL_EXT_packed_depth_stencil%2CGL_EXT_sRGB%2CGL_EXT_subtexture%2CGL_EXT_texture_array%2CGL_EXT_texture_object%2CGL_EXT_texture_sRGB%2CGL_EXT_vertex_array%2CGL_INGR_blend_func_separate%2CGL_KHR_debug%2CGL_NV_geometry_program4%2CGL_NV_vertex_program%2CGL_OES_blend_equation_separate%2CGL_OES_blend_func_separate%2CGL_OES_blend_subtract%2CGL_OES_depth24%2CGL_OES_depth32%2CGL_OES_framebuffer_object%2CGL_OES_packed_depth_stencil%2CGL_OES_single_precision%2CGL_OES_texture_npot%2CGL_SGIS_texture_edge_clamp&options=ALIAS%2CALIAS%2CHEADER_ONLY%2CMERGE%2CMERGE&generator=c
+ *    http://gen.glad.sh/#profile=gl%3Dcompatibility%2Cgles1%3Dcommon&api=gl%3D4.6%2Cgles1%3D1.0&extensions=GL_ARB_copy_buffer%2CGL_ARB_fragment_shader%2CGL_ARB_framebuffer_object%2CGL_ARB_geometry_shader4%2CGL_ARB_get_program_binary%2CGL_ARB_imaging%2CGL_ARB_multitexture%2CGL_ARB_separate_shader_objects%2CGL_ARB_shader_objects%2CGL_ARB_shading_language_100%2CGL_ARB_texture_non_power_of_two%2CGL_ARB_vertex_buffer_object%2CGL_ARB_vertex_program%2CGL_ARB_vertex_shader%2CGL_EXT_blend_equation_separate%2CGL_EXT_blend_func_separate%2CGL_EXT_blend_minmax%2CGL_EXT_blend_subtract%2CGL_EXT_copy_texture%2CGL_EXT_framebuffer_blit%2CGL_EXT_framebuffer_multisample%2CGL_EXT_framebuffer_object%2CGL_EXT_geometry_shader4%2CGL_EXT_packed_depth_stencil%2CGL_EXT_sRGB%2CGL_EXT_subtexture%2CGL_EXT_texture_compression_s3tc%2CGL_EXT_texture_array%2CGL_EXT_texture_object%2CGL_EXT_texture_sRGB%2CGL_EXT_vertex_array%2CGL_INGR_blend_func_separate%2CGL_KHR_debug%2CGL_KHR_parallel_shader_compile%2CGL_NV_geometry_program4%2CGL_NV_vertex_program%2CGL_OES_blend_equation_separate%2CGL_OES_blend_func_separate%2CGL_OES_blend_subtract%2CGL_OES_depth24%2CGL_OES_depth32%2CGL_OES_framebuffer_object%2CGL_OES_packed_depth_stencil%2CGL_OES_single_precision%2CGL_OES_texture_npot%2CGL_SGIS_texture_edge_clamp&options=ALIAS%2CALIAS%2CHEADER_ONLY%2CMERGE%2CMERGE&generator=c
  *
  */
 
@@ -474,6 +474,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_COMPILE 0x1300
 #define GL_COMPILE_AND_EXECUTE 0x1301
 #define GL_COMPILE_STATUS 0x8B81
+#define GL_COMPLETION_STATUS_KHR 0x91B1
 #define GL_COMPRESSED_ALPHA 0x84E9
 #define GL_COMPRESSED_INTENSITY 0x84EC
 #define GL_COMPRESSED_LUMINANCE 0x84EA
@@ -489,8 +490,12 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_COMPRESSED_RGBA 0x84EE
 #define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
 #define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
 #define GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT 0x8E8E
 #define GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT 0x8E8F
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
 #define GL_COMPRESSED_RG_RGTC2 0x8DBD
 #define GL_COMPRESSED_SIGNED_R11_EAC 0x9271
 #define GL_COMPRESSED_SIGNED_RED_RGTC1 0x8DBC
@@ -3016,6 +3021,8 @@ GLAD_API_CALL int SF_GLAD_GL_VERSION_ES_CM_1_0;
 GLAD_API_CALL int SF_GLAD_GL_ARB_ES2_compatibility;
 #define GL_ARB_ES3_1_compatibility 1
 GLAD_API_CALL int SF_GLAD_GL_ARB_ES3_1_compatibility;
+#define GL_ARB_ES3_compatibility 1
+GLAD_API_CALL int SF_GLAD_GL_ARB_ES3_compatibility;
 #define GL_ARB_base_instance 1
 GLAD_API_CALL int SF_GLAD_GL_ARB_base_instance;
 #define GL_ARB_blend_func_extended 1
@@ -3160,6 +3167,8 @@ GLAD_API_CALL int SF_GLAD_GL_EXT_geometry_shader4;
 GLAD_API_CALL int SF_GLAD_GL_EXT_packed_depth_stencil;
 #define GL_EXT_subtexture 1
 GLAD_API_CALL int SF_GLAD_GL_EXT_subtexture;
+#define GL_EXT_texture_compression_s3tc 1
+GLAD_API_CALL int SF_GLAD_GL_EXT_texture_compression_s3tc;
 #define GL_EXT_texture_array 1
 GLAD_API_CALL int SF_GLAD_GL_EXT_texture_array;
 #define GL_EXT_texture_object 1
@@ -3172,6 +3181,8 @@ GLAD_API_CALL int SF_GLAD_GL_EXT_vertex_array;
 GLAD_API_CALL int SF_GLAD_GL_INGR_blend_func_separate;
 #define GL_KHR_debug 1
 GLAD_API_CALL int SF_GLAD_GL_KHR_debug;
+#define GL_KHR_parallel_shader_compile 1
+GLAD_API_CALL int SF_GLAD_GL_KHR_parallel_shader_compile;
 #define GL_KHR_robustness 1
 GLAD_API_CALL int SF_GLAD_GL_KHR_robustness;
 #define GL_NV_geometry_program4 1
@@ -7506,6 +7517,7 @@ int SF_GLAD_GL_VERSION_4_6 = 0;
 int SF_GLAD_GL_VERSION_ES_CM_1_0 = 0;
 int SF_GLAD_GL_ARB_ES2_compatibility = 0;
 int SF_GLAD_GL_ARB_ES3_1_compatibility = 0;
+int SF_GLAD_GL_ARB_ES3_compatibility = 0;
 int SF_GLAD_GL_ARB_base_instance = 0;
 int SF_GLAD_GL_ARB_blend_func_extended = 0;
 int SF_GLAD_GL_ARB_buffer_storage = 0;
@@ -7578,12 +7590,14 @@ int SF_GLAD_GL_EXT_framebuffer_object = 0;
 int SF_GLAD_GL_EXT_geometry_shader4 = 0;
 int SF_GLAD_GL_EXT_packed_depth_stencil = 0;
 int SF_GLAD_GL_EXT_subtexture = 0;
+int SF_GLAD_GL_EXT_texture_compression_s3tc = 0;
 int SF_GLAD_GL_EXT_texture_array = 0;
 int SF_GLAD_GL_EXT_texture_object = 0;
 int SF_GLAD_GL_EXT_texture_sRGB = 0;
 int SF_GLAD_GL_EXT_vertex_array = 0;
 int SF_GLAD_GL_INGR_blend_func_separate = 0;
 int SF_GLAD_GL_KHR_debug = 0;
+int SF_GLAD_GL_KHR_parallel_shader_compile = 0;
 int SF_GLAD_GL_KHR_robustness = 0;
 int SF_GLAD_GL_NV_geometry_program4 = 0;
 int SF_GLAD_GL_NV_vertex_program = 0;
@@ -11903,6 +11917,7 @@ static int sf_glad_gl_find_extensions_gl( int version) {
 
     SF_GLAD_GL_ARB_ES2_compatibility = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_ES2_compatibility");
     SF_GLAD_GL_ARB_ES3_1_compatibility = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_ES3_1_compatibility");
+    SF_GLAD_GL_ARB_ES3_compatibility = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_ES3_compatibility");
     SF_GLAD_GL_ARB_base_instance = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_base_instance");
     SF_GLAD_GL_ARB_blend_func_extended = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_blend_func_extended");
     SF_GLAD_GL_ARB_buffer_storage = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_buffer_storage");
@@ -11975,12 +11990,14 @@ static int sf_glad_gl_find_extensions_gl( int version) {
     SF_GLAD_GL_EXT_geometry_shader4 = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_EXT_geometry_shader4");
     SF_GLAD_GL_EXT_packed_depth_stencil = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_EXT_packed_depth_stencil");
     SF_GLAD_GL_EXT_subtexture = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_EXT_subtexture");
+    SF_GLAD_GL_EXT_texture_compression_s3tc = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_EXT_texture_compression_s3tc");
     SF_GLAD_GL_EXT_texture_array = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_EXT_texture_array");
     SF_GLAD_GL_EXT_texture_object = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_EXT_texture_object");
     SF_GLAD_GL_EXT_texture_sRGB = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_EXT_texture_sRGB");
     SF_GLAD_GL_EXT_vertex_array = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_EXT_vertex_array");
     SF_GLAD_GL_INGR_blend_func_separate = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_INGR_blend_func_separate");
     SF_GLAD_GL_KHR_debug = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_KHR_debug");
+    SF_GLAD_GL_KHR_parallel_shader_compile = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_KHR_parallel_shader_compile");
     SF_GLAD_GL_KHR_robustness = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_KHR_robustness");
     SF_GLAD_GL_NV_geometry_program4 = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_NV_geometry_program4");
     SF_GLAD_GL_NV_vertex_program = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_NV_vertex_program");
@@ -111,8 +111,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float       m_radius;     //!< Radius of the circle
-    std::size_t m_pointCount; //!< Number of points composing the circle
+    float           m_radius;     //!< Radius of the circle
+    std::size_t     m_pointCount; //!< Number of points composing the circle
+    const Vector2f* m_unitCircle; //!< Shared table of the points of a circle of radius 1 with the same point count
 };
 
 } // namespace sf
@@ -34,14 +34,24 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    template <typename T> class HashTable;
+}
+
 class InputStream;
+class Shader;
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
@@ -173,6 +183,12 @@ public:
     /// Be aware that using a negative value for the outline
     /// thickness will cause distorted rendering.
     ///
+    /// When the textures of a character size are full, the glyphs
+    /// that were not used for the longest time are evicted and
+    /// will be rasterized again when requested. Therefore the
+    /// returned reference may be invalidated by subsequent calls
+    /// to getGlyph, and should not be stored.
+    ///
     /// \param codePoint        Unicode code point of the character to get
     /// \param characterSize    Reference character size
     /// \param bold             Retrieve the bold version or the regular one?
@@ -201,6 +217,53 @@ public:
     ////////////////////////////////////////////////////////////
     bool hasGlyph(Uint32 codePoint) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the glyphs of a string in the background
+    ///
+    /// The glyphs of \a string which are not loaded yet are
+    /// rasterized by a worker thread, so that the calling thread
+    /// doesn't stall when they are first needed. This is typically
+    /// used during loading screens, to warm up the cache with
+    /// the characters that are about to be displayed.
+    ///
+    /// The rasterized glyphs are stored into the textures of the
+    /// font by commitPrefetchedGlyphs, or when getGlyph is called
+    /// for a glyph which is not loaded yet.
+    ///
+    /// \param string           String containing the characters to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    ///
+    /// \see commitPrefetchedGlyphs, isPrefetching
+    ///
+    ////////////////////////////////////////////////////////////
+    void prefetch(const String& string, unsigned int characterSize, bool bold = false, float outlineThickness = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the glyphs rasterized in the background into the textures
+    ///
+    /// Glyphs which are placed next to each other in a texture
+    /// are uploaded together, so calling this function once
+    /// per frame is cheaper than letting getGlyph upload them
+    /// one by one. This function must be called from the thread
+    /// that draws the texts.
+    ///
+    /// \see prefetch
+    ///
+    ////////////////////////////////////////////////////////////
+    void commitPrefetchedGlyphs() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether glyphs are being rasterized in the background
+    ///
+    /// \return True if some prefetched glyphs are not rasterized yet
+    ///
+    /// \see prefetch
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPrefetching() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the kerning offset of two glyphs
     ///
@@ -268,13 +331,49 @@ public:
     /// are requested, thus it is not very relevant. It is mainly
     /// used internally by sf::Text.
     ///
+    /// This function returns the first texture of the character
+    /// size, use the other overload to access the textures that
+    /// are created when the first one is full.
+    ///
     /// \param characterSize Reference character size
     ///
     /// \return Texture containing the glyphs of the requested size
     ///
+    /// \see getTextureCount
+    ///
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve one of the textures containing the loaded glyphs of a certain size
+    ///
+    /// When a texture is full, glyphs are stored into a new
+    /// one rather than growing the texture indefinitely. The
+    /// texture that contains a glyph is given by its
+    /// sf::Glyph::textureIndex member.
+    ///
+    /// \param characterSize Reference character size
+    /// \param index         Index of the texture, in range [0 .. getTextureCount(characterSize) - 1]
+    ///
+    /// \return Texture containing glyphs of the requested size
+    ///
+    /// \see getTextureCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int characterSize, unsigned int index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of textures used by the glyphs of a certain size
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Number of textures containing glyphs of the requested size
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getTextureCount(unsigned int characterSize) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the smooth filter
     ///
@@ -301,6 +400,60 @@ public:
     ////////////////////////////////////////////////////////////
     bool isSmooth() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the distance field mode
+    ///
+    /// In distance field mode, the glyphs are rasterized once,
+    /// at the size returned by getDistanceFieldSize, and the
+    /// alpha channel of their pixels stores the distance to the
+    /// outline of the glyph rather than its coverage: 0.5 on the
+    /// outline, 1 and 0 at getDistanceFieldSpread pixels inside
+    /// and outside of it. The same glyphs can then be drawn sharply
+    /// at any size and scale, with a shader. sf::Text does it
+    /// automatically, and renders the bold style and the outline
+    /// in the shader too; they are thus ignored by getGlyph
+    /// in this mode.
+    ///
+    /// Changing the mode discards all the loaded glyphs.
+    /// The distance field mode is disabled by default.
+    ///
+    /// \param enabled True to enable the distance field mode, false to disable it
+    ///
+    /// \see isDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceFieldEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the distance field mode is enabled or not
+    ///
+    /// \return True if the distance field mode is enabled, false if it is disabled
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceFieldEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size of the glyphs in distance field mode
+    ///
+    /// \return Character size at which the distance field glyphs are rasterized
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getDistanceFieldSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the range of the distances stored in distance field mode
+    ///
+    /// \return Distance to the outline of the glyphs, in pixels, beyond which the distance fields are clamped
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    float getDistanceFieldSpread() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -313,23 +466,78 @@ public:
 
 private:
 
+    friend class Text;
+
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a row of glyphs
     ///
     ////////////////////////////////////////////////////////////
     struct Row
     {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
+        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight), lastUse(0) {}
+
+        unsigned int        width;   //!< Current width of the row
+        unsigned int        top;     //!< Y position of the row into the texture
+        unsigned int        height;  //!< Height of the row
+        Uint64              lastUse; //!< Value of the page's use counter when a glyph of the row was last requested
+        std::vector<Uint64> glyphs;  //!< Keys of the glyphs stored in the row
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a glyph stored in a page
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CachedGlyph
+    {
+        Glyph       glyph; //!< The glyph itself
+        std::size_t row;   //!< Index of the row containing the glyph's pixels in its texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a glyph to load in the background
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphRequest
+    {
+        Uint32       glyphIndex;       //!< Index of the glyph to load in the font
+        unsigned int characterSize;    //!< Reference character size
+        bool         bold;             //!< Load the bold version or the regular one?
+        float        outlineThickness; //!< Thickness of outline
+    };
 
-        unsigned int width;  //!< Current width of the row
-        unsigned int top;    //!< Y position of the row into the texture
-        unsigned int height; //!< Height of the row
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a glyph rasterized in the background
+    ///
+    ////////////////////////////////////////////////////////////
+    struct RasterizedGlyph
+    {
+        unsigned int       characterSize; //!< Reference character size
+        Uint64             key;           //!< Key of the glyph in the page of its character size
+        Glyph              glyph;         //!< Metrics of the glyph, the texture rectangle only has the size of the pixels
+        std::vector<Uint8> pixels;        //!< Pixels of the glyph, including padding
     };
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint64, Glyph> GlyphTable; //!< Table mapping a codepoint to its glyph
+    typedef priv::HashTable<std::size_t> GlyphTable;           //!< Table mapping a glyph key to the index of its glyph
+    typedef priv::HashTable<float> KerningTable;               //!< Table mapping a pair of codepoints to their kerning
+    typedef priv::HashTable<Uint32> GlyphIndexTable;           //!< Table mapping a codepoint to the index of its glyph in the font
+    typedef std::multimap<unsigned int, std::size_t> RowTable; //!< Table mapping a row height to the index of a row that has free space
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a texture of a page of glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Atlas
+    {
+        Atlas();
+
+        Texture          texture;  //!< Texture containing the pixels of the glyphs
+        unsigned int     nextRow;  //!< Y position of the next new row in the texture
+        std::vector<Row> rows;     //!< List containing the position of all the existing rows
+        RowTable         openRows; //!< Rows which still have free space, sorted by height
+    };
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -338,11 +546,17 @@ private:
     struct Page
     {
         Page();
-
-        GlyphTable       glyphs;  //!< Table mapping code points to their corresponding glyph
-        Texture          texture; //!< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; //!< Y position of the next new row in the texture
-        std::vector<Row> rows;    //!< List containing the position of all the existing rows
+        Page(const Page& copy);
+        ~Page();
+        Page& operator =(const Page& right);
+
+        GlyphTable*              glyphTable; //!< Table mapping glyph keys to the index of their corresponding glyph
+        std::deque<CachedGlyph>  glyphs;     //!< Storage of the glyphs, a deque so that references to them remain valid when new ones are added
+        std::vector<std::size_t> freeGlyphs; //!< Indices of the glyphs which were evicted and can be reused
+        KerningTable*            kernings;   //!< Table mapping pairs of code points to their kerning
+        std::deque<Atlas>        atlases;    //!< Textures containing the pixels of the glyphs
+        Uint64                   useCounter; //!< Counter incremented every time a glyph is requested, to find the least recently used rows
+        Uint64                   generation; //!< Unique number that changes every time glyphs are evicted, so that texts lay them out again
     };
 
     ////////////////////////////////////////////////////////////
@@ -351,30 +565,146 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop loading glyphs in the background and discard the pending ones
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelPrefetch() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the glyphs requested by prefetch, until there are no more
+    ///
+    /// This function is the entry point of the loading thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizePrefetchedGlyphs();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the metrics and pixels of a glyph
+    ///
+    /// The texture rectangle of the glyph is left at (0, 0),
+    /// its size is the size of the pixels without padding.
+    ///
+    /// \param glyphIndex       Index of the glyph to load in the font
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    /// \param glyph            Glyph to fill
+    /// \param pixelBuffer      Buffer to fill with the glyph's pixels, including padding
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeGlyph(Uint32 glyphIndex, unsigned int characterSize, bool bold, float outlineThickness, Glyph& glyph, std::vector<Uint8>& pixelBuffer) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve room in the textures of a page for a rasterized glyph
+    ///
+    /// \param page  Page of glyphs to store the glyph into
+    /// \param glyph Rasterized glyph, its texture rectangle is updated
+    ///
+    /// \return Rectangle to write the glyph's pixels to, including padding
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect placeGlyph(Page& page, CachedGlyph& glyph) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store a loaded glyph into the cache of a page
+    ///
+    /// \param page  Page of glyphs to store the glyph into
+    /// \param key   Key of the glyph
+    /// \param glyph Glyph to store
+    ///
+    /// \return Index of the stored glyph in the page
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t insertGlyph(Page& page, Uint64 key, const CachedGlyph& glyph) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the glyph of a character in the font
+    ///
+    /// Characters that the font maps to the same glyph (such as
+    /// all the missing characters, which use glyph 0) share a
+    /// single entry in the glyph cache.
+    ///
+    /// \param codePoint Unicode code point of the character
+    ///
+    /// \return Index of the glyph in the font, 0 if the font doesn't have the character
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getGlyphIndex(Uint32 codePoint) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
-    /// \param codePoint        Unicode code point of the character to load
+    /// \param glyphIndex       Index of the glyph to load in the font
     /// \param characterSize    Reference character size
     /// \param bold             Retrieve the bold version or the regular one?
     /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
     ///
-    /// \return The glyph corresponding to \a codePoint and \a characterSize
+    /// \return The glyph corresponding to \a glyphIndex and \a characterSize
     ///
     ////////////////////////////////////////////////////////////
-    Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
+    CachedGlyph loadGlyph(Uint32 glyphIndex, unsigned int characterSize, bool bold, float outlineThickness) const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Find a suitable rectangle within the texture for a glyph
+    /// \brief Find a suitable rectangle within the textures for a glyph
+    ///
+    /// If all the textures of the page are full and no new one
+    /// can be created, the least recently used row that can
+    /// hold the glyph is evicted.
     ///
     /// \param page   Page of glyphs to search in
     /// \param width  Width of the rectangle
     /// \param height Height of the rectangle
+    /// \param glyph  Glyph to store the index of the selected texture and row into
     ///
     /// \return Found rectangle within the texture
     ///
     ////////////////////////////////////////////////////////////
-    IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
+    IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height, CachedGlyph& glyph) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate a new row in a texture of a page, growing it if necessary
+    ///
+    /// \param atlas       Texture to add a row to
+    /// \param width       Width of the glyph that the row is created for
+    /// \param height      Height of the row
+    /// \param maximumSize Size that the texture may not grow beyond
+    ///
+    /// \return Pointer to the new row, or NULL if the texture is full
+    ///
+    ////////////////////////////////////////////////////////////
+    Row* createRow(Atlas& atlas, unsigned int width, unsigned int height, unsigned int maximumSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the glyphs of a row from a page
+    ///
+    /// \param page  Page of glyphs the row belongs to
+    /// \param atlas Texture containing the row
+    /// \param index Index of the row in the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void evictRow(Page& page, Atlas& atlas, std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page of glyphs of a character size, creating it if necessary
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page of glyphs of the character size
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& loadPage(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a new empty texture to a page of glyphs
+    ///
+    /// \param page Page of glyphs to add the texture to
+    /// \param size Width and height of the new texture
+    ///
+    /// \return The new texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Atlas& createAtlas(Page& page, unsigned int size) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
@@ -386,25 +716,69 @@ private:
     ////////////////////////////////////////////////////////////
     bool setCurrentSize(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layout generation of a character size
+    ///
+    /// The generation changes when glyphs of the character size
+    /// are evicted or when its page is created again, which may
+    /// move the glyphs in the textures. Adding glyphs or growing
+    /// the textures doesn't change it, since glyphs are addressed
+    /// in pixels and never move in these cases.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Unique number identifying the placement of the glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLayoutGeneration(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader drawing the distance field glyphs
+    ///
+    /// The shader is created the first time it is requested, and
+    /// destroyed with the font, while the OpenGL contexts still exist.
+    /// The Programmable backend of RenderTarget needs its own variant,
+    /// which reads the sf_* vertex attributes and uniforms instead
+    /// of the fixed-function built-ins.
+    ///
+    /// \param programmable True to get the variant for the Programmable backend
+    ///
+    /// \return Pointer to the shader, or NULL if shaders are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    Shader* getDistanceFieldShader(bool programmable) const;
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; //!< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, Page> PageTable;                   //!< Table mapping a character size to its page (texture)
+    typedef std::set<std::pair<unsigned int, Uint64> > PendingGlyphs; //!< Set of character sizes and keys of glyphs being loaded in the background
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    void*                      m_library;     //!< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
-    void*                      m_face;        //!< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
-    void*                      m_streamRec;   //!< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
-    void*                      m_stroker;     //!< Pointer to the stroker (it is typeless to avoid exposing implementation details)
-    int*                       m_refCount;    //!< Reference counter used by implicit sharing
-    bool                       m_isSmooth;    //!< Status of the smooth filter
-    Info                       m_info;        //!< Information about the font
-    mutable PageTable          m_pages;       //!< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; //!< Pixel buffer holding a glyph's pixels before being written to the texture
+    void*                                m_library;         //!< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
+    void*                                m_face;            //!< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
+    void*                                m_streamRec;       //!< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
+    void*                                m_stroker;         //!< Pointer to the stroker (it is typeless to avoid exposing implementation details)
+    int*                                 m_refCount;        //!< Reference counter used by implicit sharing
+    Mutex*                               m_faceMutex;       //!< Mutex protecting the FreeType objects, shared like them by implicit sharing
+    bool                                 m_isSmooth;        //!< Status of the smooth filter
+    bool                                 m_isDistanceField; //!< Are the glyphs rasterized as distance fields?
+    Info                                 m_info;            //!< Information about the font
+    mutable PageTable                    m_pages;           //!< Table containing the glyphs pages by character size
+    GlyphIndexTable*                     m_glyphIndices;    //!< Cache of the glyph indices of the code points, for all character sizes
+    mutable std::vector<Uint8>           m_pixelBuffer;     //!< Pixel buffer holding a glyph's pixels before being written to the texture
+    mutable Thread                       m_loadingThread;   //!< Thread rasterizing the prefetched glyphs
+    mutable Mutex                        m_loadingMutex;    //!< Mutex protecting the members shared with the loading thread
+    mutable std::deque<GlyphRequest>     m_loadingQueue;    //!< Glyphs waiting to be rasterized by the loading thread
+    mutable std::vector<RasterizedGlyph> m_loadedGlyphs;    //!< Glyphs rasterized by the loading thread, waiting to be stored into the textures
+    mutable PendingGlyphs                m_pendingGlyphs;   //!< Glyphs either waiting to be rasterized or to be stored
+    mutable bool                         m_isLoading;       //!< Is the loading thread running?
+    mutable Shader*                      m_distanceFieldShader; //!< Shader drawing the distance field glyphs, created on first use
+    mutable Shader*                      m_programmableDistanceFieldShader; //!< Variant of m_distanceFieldShader for the Programmable backend
     #ifdef SFML_SYSTEM_ANDROID
-    void*                      m_stream; //!< Asset file streamer (if loaded from file)
+    void*                                m_stream; //!< Asset file streamer (if loaded from file)
     #endif
 };
 
@@ -477,6 +851,19 @@ private:
 /// with this class. However, it may be useful to access the
 /// font metrics or rasterized glyphs for advanced usage.
 ///
+/// Glyphs are rasterized the first time they are requested,
+/// which can make the first frame displaying a new text stall.
+/// To avoid it, the glyphs can be rasterized in the background
+/// with the prefetch function, typically during a loading screen:
+/// \code
+/// font.prefetch("0123456789 points", 30);
+///
+/// while (font.isPrefetching())
+///     drawLoadingScreen();
+///
+/// font.commitPrefetchedGlyphs();
+/// \endcode
+///
 /// Note that if the font is a bitmap font, it is not scalable,
 /// thus not all requested sizes will be available to use. This
 /// needs to be taken into consideration when using sf::Text.
@@ -46,16 +46,17 @@ public:
     /// \brief Default constructor
     ///
     ////////////////////////////////////////////////////////////
-    Glyph() : advance(0) {}
+    Glyph() : advance(0), textureIndex(0) {}
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float     advance;     //!< Offset to move horizontally to the next character
-    int       lsbDelta;    //!< Left offset after forced autohint. Internally used by getKerning()
-    int       rsbDelta;    //!< Right offset after forced autohint. Internally used by getKerning()
-    FloatRect bounds;      //!< Bounding rectangle of the glyph, in coordinates relative to the baseline
-    IntRect   textureRect; //!< Texture coordinates of the glyph inside the font's texture
+    float        advance;      //!< Offset to move horizontally to the next character
+    int          lsbDelta;     //!< Left offset after forced autohint. Internally used by getKerning()
+    int          rsbDelta;     //!< Right offset after forced autohint. Internally used by getKerning()
+    FloatRect    bounds;       //!< Bounding rectangle of the glyph, in coordinates relative to the baseline
+    IntRect      textureRect;  //!< Texture coordinates of the glyph inside the font's texture
+    unsigned int textureIndex; //!< Index of the font's texture that contains the glyph (see Font::getTexture)
 };
 
 } // namespace sf
@@ -72,7 +73,8 @@ public:
 ///
 /// The sf::Glyph structure provides the information needed
 /// to handle the glyph:
-/// \li its coordinates in the font's texture
+/// \li its coordinates in the font's texture, and which of
+///     the font's textures contains it
 /// \li its bounding rectangle
 /// \li the offset to apply to get the starting position of the next glyph
 ///
@@ -47,6 +47,15 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function releasing pixels adopted by an image
+    ///
+    /// \param pixels   Pixels to release
+    /// \param userData User data that was given with the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*PixelDeleter)(Uint8* pixels, void* userData);
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -55,12 +64,30 @@ public:
     ////////////////////////////////////////////////////////////
     Image();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Image(const Image& copy);
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
     ////////////////////////////////////////////////////////////
     ~Image();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& operator =(const Image& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the image and fill it with a unique color
     ///
@@ -86,12 +113,53 @@ public:
     ////////////////////////////////////////////////////////////
     void create(unsigned int width, unsigned int height, const Uint8* pixels);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image by taking the contents of a pixel buffer
+    ///
+    /// The \a pixels buffer is assumed to contain 32-bits RGBA
+    /// pixels. Its storage is moved into the image without
+    /// copying the pixels, and \a pixels is left empty.
+    /// If \a pixels doesn't contain at least width * height * 4
+    /// values, an empty image is created and \a pixels is left
+    /// unchanged.
+    ///
+    /// \param width  Width of the image
+    /// \param height Height of the image
+    /// \param pixels Buffer of pixels to move into the image
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(unsigned int width, unsigned int height, std::vector<Uint8>& pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image by adopting an externally allocated array of pixels
+    ///
+    /// The \a pixel array is assumed to contain 32-bits RGBA pixels,
+    /// and have the given \a width and \a height. The image
+    /// takes ownership of the array without copying it, and
+    /// releases it by calling \a deleter with \a pixels and
+    /// \a userData once it no longer needs it. This lets pixels
+    /// coming from a custom allocator or a third-party decoder
+    /// be used directly.
+    /// If \a width or \a height is 0, the array is released
+    /// immediately and an empty image is created.
+    ///
+    /// \param width    Width of the image
+    /// \param height   Height of the image
+    /// \param pixels   Array of pixels to adopt
+    /// \param deleter  Function to call to release the array
+    /// \param userData User data to pass to \a deleter
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(unsigned int width, unsigned int height, Uint8* pixels, PixelDeleter deleter, void* userData = NULL);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// like progressive jpeg. DDS and KTX files containing
+    /// BC1/BC2/BC3 (DXT) or ETC2 compressed pixels are decoded
+    /// as well; only their first mipmap level is loaded.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -108,7 +176,9 @@ public:
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// like progressive jpeg. DDS and KTX files containing
+    /// BC1/BC2/BC3 (DXT) or ETC2 compressed pixels are decoded
+    /// as well; only their first mipmap level is loaded.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -126,7 +196,9 @@ public:
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// like progressive jpeg. DDS and KTX files containing
+    /// BC1/BC2/BC3 (DXT) or ETC2 compressed pixels are decoded
+    /// as well; only their first mipmap level is loaded.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -216,6 +288,66 @@ public:
     ////////////////////////////////////////////////////////////
     void copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), bool applyAlpha = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill a rectangle of the image with a color
+    ///
+    /// If \a rectangle is empty, the whole image is filled.
+    /// The rectangle is clipped to the bounds of the image.
+    ///
+    /// \param color     Fill color
+    /// \param rectangle Sub-rectangle of the image to fill
+    ///
+    /// \see blend
+    ///
+    ////////////////////////////////////////////////////////////
+    void fill(const Color& color, const IntRect& rectangle = IntRect(0, 0, 0, 0));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blend a color over a rectangle of the image
+    ///
+    /// The color is blended with its alpha value, exactly like
+    /// a copy with \a applyAlpha set to true would do with
+    /// a source image filled with \a color.
+    /// If \a rectangle is empty, the whole image is blended.
+    /// The rectangle is clipped to the bounds of the image.
+    ///
+    /// \param color     Color to blend
+    /// \param rectangle Sub-rectangle of the image to blend
+    ///
+    /// \see fill, copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void blend(const Color& color, const IntRect& rectangle = IntRect(0, 0, 0, 0));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color components of all pixels by their alpha
+    ///
+    /// This converts the image to premultiplied alpha, which is
+    /// the representation expected by blend modes such as
+    /// sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha).
+    /// The results are rounded to the nearest integer.
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reorder the color components of all pixels
+    ///
+    /// Each parameter is the index (0 for red, 1 for green,
+    /// 2 for blue, 3 for alpha) of the original component that
+    /// is written to the corresponding component. For example,
+    /// swizzle(2, 1, 0, 3) swaps red and blue, which converts
+    /// between RGBA and BGRA pixels.
+    /// Indices greater than 3 are wrapped.
+    ///
+    /// \param red   Index of the source of the red component
+    /// \param green Index of the source of the green component
+    /// \param blue  Index of the source of the blue component
+    /// \param alpha Index of the source of the alpha component
+    ///
+    ////////////////////////////////////////////////////////////
+    void swizzle(unsigned int red, unsigned int green, unsigned int blue, unsigned int alpha);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the color of a pixel
     ///
@@ -278,11 +410,25 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the current pixels and take ownership of new ones
+    ///
+    /// \param width    Width of the new pixels
+    /// \param height   Height of the new pixels
+    /// \param pixels   Array of pixels to adopt (can be null)
+    /// \param deleter  Function to call to release the array
+    /// \param userData User data to pass to \a deleter
+    ///
+    ////////////////////////////////////////////////////////////
+    void adopt(unsigned int width, unsigned int height, Uint8* pixels, PixelDeleter deleter, void* userData);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u           m_size;   //!< Image size
-    std::vector<Uint8> m_pixels; //!< Pixels of the image
+    Vector2u     m_size;     //!< Image size
+    Uint8*       m_pixels;   //!< Pixels of the image, null if the image is empty
+    PixelDeleter m_deleter;  //!< Function releasing the pixels
+    void*        m_userData; //!< User data passed to the pixel deleter
 };
 
 } // namespace sf
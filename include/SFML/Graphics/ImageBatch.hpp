@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEBATCH_HPP
+#define SFML_IMAGEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+class Thread;
+
+////////////////////////////////////////////////////////////
+/// \brief Load many images in parallel, on worker threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageBatch : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits until the running workers are finished.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image file on disk to the batch
+    ///
+    /// See sf::Image::loadFromFile for the supported formats.
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return Index of the image in the batch
+    ///
+    /// \see addFromMemory, addFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image file in memory to the batch
+    ///
+    /// The data is not copied, it must remain valid until
+    /// the image is loaded.
+    /// See sf::Image::loadFromMemory for the supported formats.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return Index of the image in the batch
+    ///
+    /// \see addFromFile, addFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addFromMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image read from a custom stream to the batch
+    ///
+    /// The stream is read by a worker thread, it must remain
+    /// valid and must not be used elsewhere until the image
+    /// is loaded.
+    /// See sf::Image::loadFromStream for the supported formats.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return Index of the image in the batch
+    ///
+    /// \see addFromFile, addFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the pending images
+    ///
+    /// This function starts \a threadCount worker threads which
+    /// decode the images that were added and not loaded yet,
+    /// and returns immediately. Images added while the workers
+    /// are running are loaded by them as well; images added
+    /// after they stopped need another call to launch.
+    /// If a previous batch is still loading, this function
+    /// waits for it to finish first.
+    ///
+    /// \param threadCount Number of worker threads to use
+    ///
+    /// \see wait, isLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    void launch(unsigned int threadCount = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the workers have loaded all the images
+    ///
+    /// The error messages of the images that failed to load
+    /// are written to sf::err() by this function.
+    ///
+    /// \see launch
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether worker threads are still loading images
+    ///
+    /// \return True if images are being loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLoading() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the progress of the loading
+    ///
+    /// The progress is the number of images that were processed,
+    /// successfully or not, divided by the number of images in
+    /// the batch. An empty batch has a progress of 1.
+    ///
+    /// \return Progress, between 0 and 1
+    ///
+    ////////////////////////////////////////////////////////////
+    float getProgress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images in the batch
+    ///
+    /// \return Number of images that were added
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getImageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether an image was successfully loaded
+    ///
+    /// This function returns false while the image is waiting
+    /// or being loaded, and if it failed to load.
+    ///
+    /// \param index Index of the image
+    ///
+    /// \return True if the image is loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLoaded(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a loaded image
+    ///
+    /// While an image is not loaded (see isLoaded), it may still
+    /// be written by a worker thread: this function returns an
+    /// empty image instead. The reference to a loaded image
+    /// remains valid until the batch is cleared or destroyed.
+    ///
+    /// \param index Index of the image
+    ///
+    /// \return Reference to the image
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& getImage(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images from the batch
+    ///
+    /// This function waits for the running workers to finish
+    /// before releasing the images.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load pending images until there are none left
+    ///
+    /// This function is the entry point of the worker threads.
+    ///
+    ////////////////////////////////////////////////////////////
+    void loadImages();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Image of the batch and the source it is loaded from
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Item
+    {
+        enum Source
+        {
+            File,   //!< Load from a file on disk
+            Memory, //!< Load from a file in memory
+            Stream  //!< Load from a custom stream
+        };
+
+        enum Status
+        {
+            Pending, //!< Not processed yet
+            Loaded,  //!< Successfully loaded
+            Failed   //!< Failed to load
+        };
+
+        Item();
+
+        Source       source;   //!< Where the image is loaded from
+        Status       status;   //!< Loading status of the image
+        std::string  filename; //!< Path of the file, for File sources
+        const void*  data;     //!< File data, for Memory sources
+        std::size_t  size;     //!< Size of the file data, for Memory sources
+        InputStream* stream;   //!< Stream to read, for Stream sources
+        Image        image;    //!< Loaded image
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the error messages collected from the workers to sf::err()
+    ///
+    /// This function must be called by the thread that owns the batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reportErrors() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an item to the batch
+    ///
+    /// \param item Item to add
+    ///
+    /// \return Index of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addItem(const Item& item);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Item>     m_items;          //!< Images of the batch, in order of addition
+    std::vector<Thread*> m_threads;        //!< Worker threads of the last launch
+    std::size_t          m_nextItem;       //!< Index of the next item to load
+    std::size_t          m_completedItems; //!< Number of items processed
+    unsigned int         m_runningThreads; //!< Number of workers that haven't finished yet
+    mutable std::string  m_errors;         //!< Error messages of the workers, not written to sf::err() yet
+    Image                m_emptyImage;     //!< Image returned for the images that are not loaded
+    mutable Mutex        m_mutex;          //!< Mutex protecting the loading state
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageBatch
+/// \ingroup graphics
+///
+/// sf::ImageBatch decodes many images in parallel, to reduce
+/// the time spent loading assets. Images are added from files,
+/// memory or streams, then decoded by a pool of worker threads
+/// while the calling thread keeps running; progress can be
+/// polled to display a loading screen.
+///
+/// The workers don't write to sf::err(), which is not
+/// thread-safe: the error messages of the images that failed
+/// to load are written by the calling thread, the next time
+/// it calls wait, isLoading or getProgress.
+///
+/// Only the decoding happens on the workers: creating textures
+/// from the loaded images must still be done on a thread with
+/// an active OpenGL context, typically the main thread.
+///
+/// Usage example:
+/// \code
+/// sf::ImageBatch batch;
+/// for (std::size_t i = 0; i < filenames.size(); ++i)
+///     batch.addFromFile(filenames[i]);
+///
+/// batch.launch();
+/// while (batch.isLoading())
+/// {
+///     drawLoadingScreen(batch.getProgress());
+///     window.display();
+/// }
+///
+/// std::vector<sf::Texture> textures(batch.getImageCount());
+/// for (std::size_t i = 0; i < batch.getImageCount(); ++i)
+/// {
+///     if (batch.isLoaded(i))
+///         textures[i].loadFromImage(batch.getImage(i));
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
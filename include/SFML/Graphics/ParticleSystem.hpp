@@ -0,0 +1,377 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PARTICLESYSTEM_HPP
+#define SFML_PARTICLESYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class StreamingVertexBuffer;
+}
+
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Large set of short-lived textured quads that move
+///        under a constant acceleration
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleSystem : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty system, with no texture and particles
+    /// of 1x1 units.
+    ///
+    ////////////////////////////////////////////////////////////
+    ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    ParticleSystem(const ParticleSystem& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    ParticleSystem& operator =(const ParticleSystem& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture of the particles
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the system uses it. If \a resetRect is
+    /// true, the texture rect is adjusted to the size of the
+    /// new texture.
+    ///
+    /// \param texture   New texture, or NULL to draw plain colored quads
+    /// \param resetRect Should the texture rect be reset to the size of the new texture?
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the particles
+    ///
+    /// \return Pointer to the texture, or NULL if no texture was set
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the part of the texture that each particle displays
+    ///
+    /// \param rect Rectangle defining the region of the texture to display
+    ///
+    /// \see getTextureRect, setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the part of the texture that each particle displays
+    ///
+    /// \return Rectangle of the texture
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the particles
+    ///
+    /// Particles are drawn as quads of this size, centered on
+    /// their position.
+    ///
+    /// \param size New size of the particles, in local units
+    ///
+    /// \see getParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParticleSize(const Vector2f& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the particles
+    ///
+    /// \return Size of the particles
+    ///
+    /// \see setParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getParticleSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the acceleration applied to all the particles
+    ///
+    /// This is typically used for gravity or wind. The default
+    /// acceleration is (0, 0).
+    ///
+    /// \param acceleration New acceleration, in local units per second squared
+    ///
+    /// \see getAcceleration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAcceleration(const Vector2f& acceleration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the acceleration applied to all the particles
+    ///
+    /// \return Acceleration, in local units per second squared
+    ///
+    /// \see setAcceleration
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getAcceleration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable fading the particles out
+    ///
+    /// When fading is enabled, the alpha of each particle
+    /// decreases linearly from its initial value to 0 over its
+    /// lifetime. Fading is enabled by default.
+    ///
+    /// \param enabled True to fade the particles out, false to keep their color
+    ///
+    /// \see isFadingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFadingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the particles fade out
+    ///
+    /// \return True if fading is enabled, false otherwise
+    ///
+    /// \see setFadingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFadingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for a number of particles
+    ///
+    /// \param particleCount Number of particles to reserve memory for
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t particleCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new particle
+    ///
+    /// \param position Initial position, in local coordinates
+    /// \param velocity Initial velocity, in local units per second
+    /// \param lifetime Time after which the particle disappears
+    /// \param color    Color of the particle
+    ///
+    ////////////////////////////////////////////////////////////
+    void emit(const Vector2f& position, const Vector2f& velocity, Time lifetime, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the simulation
+    ///
+    /// Moves all the particles and removes the ones whose
+    /// lifetime has expired. The order of the remaining
+    /// particles may change.
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of living particles
+    ///
+    /// \return Number of particles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParticleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a particle
+    ///
+    /// \param index Index of the particle, in range [0 .. getParticleCount() - 1]
+    ///
+    /// \return Current position of the particle, in local coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getParticlePosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the amount of vertex data uploaded by the last draw
+    ///
+    /// \return Number of bytes uploaded to the graphics card
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUploadedByteCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the particles to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the quads of the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateGeometry() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a particle, replacing it with the last one
+    ///
+    /// \param index Index of the particle to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeParticle(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*                       m_texture;       //!< Texture of the particles
+    IntRect                              m_textureRect;   //!< Region of the texture displayed by each particle
+    Vector2f                             m_particleSize;  //!< Size of the quad of each particle
+    Vector2f                             m_acceleration;  //!< Acceleration applied to all the particles
+    bool                                 m_fading;        //!< Do the particles fade out over their lifetime?
+    std::vector<float>                   m_positionsX;    //!< X coordinate of each particle
+    std::vector<float>                   m_positionsY;    //!< Y coordinate of each particle
+    std::vector<float>                   m_velocitiesX;   //!< X velocity of each particle
+    std::vector<float>                   m_velocitiesY;   //!< Y velocity of each particle
+    std::vector<float>                   m_lifetimes;     //!< Remaining lifetime of each particle, in seconds
+    std::vector<float>                   m_fadeFactors;   //!< Inverse of the initial lifetime of each particle
+    std::vector<Color>                   m_colors;        //!< Initial color of each particle
+    mutable std::vector<Vertex>          m_vertices;      //!< Triangles built from the particles
+    mutable priv::StreamingVertexBuffer* m_buffer;        //!< Streaming vertex buffers holding m_vertices, created on the first draw
+    mutable bool                         m_needUpdate;    //!< Do the vertices need to be rebuilt and uploaded?
+    mutable std::size_t                  m_uploadedBytes; //!< Number of bytes uploaded by the last draw
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLESYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleSystem
+/// \ingroup graphics
+///
+/// sf::ParticleSystem simulates and draws a large number of
+/// particles: quads that move with their own velocity, under
+/// an acceleration shared by the whole system, until their
+/// lifetime expires.
+///
+/// The state of the particles is stored as a structure of
+/// arrays (one array per coordinate of the position, velocity,
+/// etc.) rather than as an array of particles, so that
+/// update() can process several particles at once with SIMD
+/// instructions when the target supports them.
+///
+/// When drawn, the particles are converted to triangles and
+/// uploaded into streaming sf::VertexBuffer objects, two of them
+/// being used alternately so that uploading a new frame doesn't
+/// have to wait for the graphics card to finish rendering the
+/// previous one. The geometry is only rebuilt after the particles
+/// have changed. If vertex buffers are not available on the
+/// system, the triangles are drawn directly.
+///
+/// All the particles share the same texture rect and size; their
+/// color is set individually when they are emitted.
+///
+/// sf::ParticleSystem inherits all the functions from
+/// sf::Transformable: position, rotation, scale, origin. The
+/// transform applies to the whole system when it is drawn.
+///
+/// Usage example:
+/// \code
+/// sf::ParticleSystem particles;
+/// particles.setTexture(&texture, true);
+/// particles.setParticleSize(sf::Vector2f(4.f, 4.f));
+/// particles.setAcceleration(sf::Vector2f(0.f, 100.f));
+///
+/// sf::Clock clock;
+/// while (window.isOpen())
+/// {
+///     for (int i = 0; i < 1000; ++i)
+///         particles.emit(emitterPosition, randomVelocity(), sf::seconds(2.f), sf::Color::Yellow);
+///
+///     particles.update(clock.restart());
+///
+///     window.clear();
+///     window.draw(particles);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::SpriteBatch, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
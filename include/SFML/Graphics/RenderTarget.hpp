@@ -38,6 +38,7 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
@@ -45,6 +46,12 @@ namespace sf
 class Drawable;
 class VertexBuffer;
 
+namespace priv
+{
+    class GLStatesTracker;
+    class ProgrammableRenderer;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
 ///
@@ -53,6 +60,16 @@ class SFML_GRAPHICS_API RenderTarget : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief OpenGL pipelines that can render the primitives
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Backend
+    {
+        FixedFunction, //!< Client-side vertex arrays and fixed-function matrices (default)
+        Programmable   //!< Vertex array object, streaming vertex buffer and built-in shader
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -268,6 +285,123 @@ public:
     ////////////////////////////////////////////////////////////
     void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive draw calls that share
+    /// the same texture and blend mode are not submitted to the
+    /// graphics driver immediately: their vertices are transformed
+    /// on the CPU and accumulated, and the whole batch is rendered
+    /// with a single draw call as soon as the render states change,
+    /// the view changes, the contents are displayed or flush()
+    /// is called explicitly.
+    ///
+    /// Draw calls that use a shader, a vertex buffer, a texture
+    /// that belongs to a render-texture, or a large amount of
+    /// vertices are never batched; they are submitted immediately,
+    /// after any pending batch.
+    ///
+    /// Because rendering is deferred, textures referenced by pending
+    /// primitives must stay unmodified until the batch is flushed.
+    /// Destroying, recreating or swapping a texture flushes the
+    /// batches that use it, and so does sf::Font when it reuses the
+    /// space of its glyphs. Call flush() before updating such a
+    /// texture yourself, and before issuing your own OpenGL
+    /// commands. sf::RenderWindow flushes in display().
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render all the primitives pending in the current batch
+    ///
+    /// This function is called automatically when needed, you only
+    /// have to call it yourself before mixing SFML drawing with
+    /// your own OpenGL code, or before modifying a texture that
+    /// was used by the latest draw calls.
+    /// It does nothing if batching is disabled or if no primitive
+    /// is pending.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the OpenGL pipeline used to render the primitives
+    ///
+    /// The default FixedFunction backend relies on client-side
+    /// vertex arrays and on the OpenGL matrix stacks, which are
+    /// only available in compatibility contexts.
+    ///
+    /// The Programmable backend uploads the vertices to a
+    /// streaming vertex buffer, sources them through a vertex
+    /// array object and transforms them with a built-in shader
+    /// whose matrix is a uniform. It requires OpenGL 3.0, and
+    /// doesn't need any fixed-function state to draw, which is
+    /// what core profile contexts expect and what modern drivers
+    /// optimize for.
+    ///
+    /// With the Programmable backend, your own shaders receive the
+    /// vertices in the <tt>vec2 sf_position</tt>, <tt>vec4 sf_color</tt>
+    /// and <tt>vec2 sf_texCoords</tt> attributes, instead of the
+    /// built-in gl_Vertex, gl_Color and gl_MultiTexCoord0 ones.
+    /// If they declare them, the following uniforms are set
+    /// as well:
+    /// \li <tt>mat4 sf_transform</tt>: the view and model transforms combined
+    /// \li <tt>vec4 sf_texCoordsTransform</tt>: scale (xy) and offset (zw)
+    ///     that convert the texture coordinates from pixels
+    /// \li <tt>vec4 sf_textureTransforms[]</tt>: the same transform for
+    ///     each texture unit, which replaces gl_TextureMatrix: the
+    ///     textures passed to the shader are bound to the units 1
+    ///     and above, and their transform flips render textures
+    /// \li <tt>float sf_textured</tt>: 1 if a texture is bound, 0 otherwise
+    ///
+    /// Texture arrays can only be sampled by your own shaders,
+    /// the built-in one uses a regular 2D sampler. Quads stored
+    /// in a vertex buffer can't be drawn, since core profiles
+    /// don't support them: use triangles instead.
+    ///
+    /// The backend should be selected right after the target is
+    /// created, before anything is drawn to it. If the system
+    /// doesn't support the Programmable backend, this function
+    /// fails and the current backend is kept.
+    ///
+    /// \param backend Backend to use
+    ///
+    /// \return True if the backend was selected, false otherwise
+    ///
+    /// \see getBackend
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setBackend(Backend backend);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenGL pipeline used to render the primitives
+    ///
+    /// \return Current backend
+    ///
+    /// \see setBackend
+    ///
+    ////////////////////////////////////////////////////////////
+    Backend getBackend() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -327,7 +461,16 @@ public:
     /// saved and restored). Take a look at the resetGLStates
     /// function if you do so.
     ///
-    /// \see popGLStates
+    /// With the Programmable backend, which may run in contexts
+    /// that have no attribute or matrix stack, the OpenGL states
+    /// are not saved: popGLStates only restores the default vertex
+    /// array and program bindings.
+    ///
+    /// When states tracking is enabled, this function saves nothing
+    /// by itself: each state is saved right before SFML modifies
+    /// it for the first time, and popGLStates only restores those.
+    ///
+    /// \see popGLStates, setGLStatesTrackingEnabled
     ///
     ////////////////////////////////////////////////////////////
     void pushGLStates();
@@ -343,6 +486,62 @@ public:
     ////////////////////////////////////////////////////////////
     void popGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the tracking of the OpenGL states modified by SFML
+    ///
+    /// By default, pushGLStates saves all the OpenGL states and
+    /// matrices with the attribute and matrix stacks, and sets
+    /// all the states SFML needs, whether they will be used or
+    /// not. This is expensive, especially when SFML drawing is
+    /// interleaved with another renderer several times per frame.
+    ///
+    /// When tracking is enabled, pushGLStates doesn't save anything:
+    /// SFML queries each state right before modifying it for the
+    /// first time, and popGLStates restores only the states that
+    /// were saved this way. The pushGLStates/popGLStates pairs
+    /// can't be nested in this mode.
+    ///
+    /// States that SFML never modifies, such as the ones of your
+    /// own texture units or framebuffers, are left untouched.
+    ///
+    /// Tracking is disabled by default. It must not be toggled
+    /// between pushGLStates and popGLStates.
+    ///
+    /// \param enabled True to enable tracking, false to disable it
+    ///
+    /// \see isGLStatesTrackingEnabled, getGLStatesCallCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGLStatesTrackingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the OpenGL states modified by SFML are tracked
+    ///
+    /// \return True if tracking is enabled, false otherwise
+    ///
+    /// \see setGLStatesTrackingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isGLStatesTrackingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of OpenGL calls spent on the last states transition
+    ///
+    /// After pushGLStates, this is the number of calls made so far
+    /// to save the states (with tracking enabled, states are saved
+    /// by the draw calls that follow). After popGLStates, this is
+    /// the number of calls made to restore them.
+    ///
+    /// The calls that set SFML's own states, which are the same
+    /// in both modes, are not counted.
+    ///
+    /// \return Number of OpenGL calls
+    ///
+    /// \see setGLStatesTrackingEnabled, pushGLStates, popGLStates
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getGLStatesCallCount() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Reset the internal OpenGL states so that the target is ready for drawing
     ///
@@ -385,6 +584,57 @@ protected:
 
 private:
 
+    friend class Font;
+    friend class Texture;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the pending batches that use a texture
+    ///
+    /// This function must be called before pixels of \a texture
+    /// that pending primitives may reference are overwritten, and
+    /// before \a texture is destroyed. Only the render targets
+    /// whose pending batch uses \a texture are flushed, and the
+    /// context that was active before the call is activated again.
+    ///
+    /// \param texture Texture about to be modified
+    ///
+    ////////////////////////////////////////////////////////////
+    static void flushBatches(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit primitives to the graphics driver immediately
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append primitives to the current batch
+    ///
+    /// The vertices are pre-transformed, and strips, fans and
+    /// quads are converted to independent primitives so that
+    /// they can be merged with the previous ones.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void batchVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Setup environment for drawing with the programmable backend
+    ///
+    /// \param states Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupProgrammableDraw(const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -468,13 +718,33 @@ private:
         Vertex    vertexCache[VertexCacheSize]; //!< Pre-transformed vertices cache
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pending primitives of the automatic batching
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        enum {MaxDrawVertexCount = 4096};
+
+        bool                enable;    //!< Is automatic batching enabled?
+        PrimitiveType       type;      //!< Type of the pending primitives (Points, Lines or Triangles)
+        BlendMode           blendMode; //!< Blending mode of the pending primitives
+        const Texture*      texture;   //!< Texture of the pending primitives
+        Uint64              textureId; //!< Unique identifier of the texture when the batch was started
+        std::vector<Vertex> vertices;  //!< Pre-transformed pending vertices
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; //!< Default view
-    View        m_view;        //!< Current view
-    StatesCache m_cache;       //!< Render states cache
-    Uint64      m_id;          //!< Unique number that identifies the RenderTarget
+    View                        m_defaultView;     //!< Default view
+    View                        m_view;            //!< Current view
+    StatesCache                 m_cache;           //!< Render states cache
+    Batch                       m_batch;           //!< Primitives waiting to be rendered
+    Uint64                      m_id;              //!< Unique number that identifies the RenderTarget
+    priv::ProgrammableRenderer* m_renderer;        //!< Programmable backend, NULL when the fixed-function one is used
+    priv::GLStatesTracker*      m_statesTracker;   //!< Records the states to restore in popGLStates, NULL if tracking is disabled
+    unsigned int                m_statesCallCount; //!< OpenGL calls of the last push/pop when tracking is disabled
 };
 
 } // namespace sf
@@ -505,6 +775,26 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
+/// Scenes made of many small entities (sprites, texts, shapes)
+/// sharing a few textures can enable automatic batching with
+/// setBatchingEnabled: consecutive draw calls that use the same
+/// texture and blending mode are then merged into a single
+/// OpenGL draw call, which greatly reduces the CPU cost of
+/// submitting them.
+/// \code
+/// window.setBatchingEnabled(true);
+///
+/// for (std::size_t i = 0; i < sprites.size(); ++i)
+///     window.draw(sprites[i]); // accumulated, not rendered yet
+///
+/// window.display(); // pending primitives are rendered here
+/// \endcode
+///
+/// By default, primitives are rendered with the OpenGL
+/// fixed-function pipeline. setBackend(sf::RenderTarget::Programmable)
+/// switches to a backend based on a vertex array object and a
+/// built-in shader, which doesn't depend on any fixed-function state.
+///
 /// \see sf::RenderWindow, sf::RenderTexture, sf::View
 ///
 ////////////////////////////////////////////////////////////
@@ -152,6 +152,9 @@ public:
     /// You can also draw things directly to a texture with the
     /// sf::RenderTexture class.
     ///
+    /// The primitives pending in the current batch are rendered
+    /// before the contents are copied.
+    ///
     /// \return Image containing the captured contents
     ///
     ////////////////////////////////////////////////////////////
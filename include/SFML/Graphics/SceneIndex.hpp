@@ -0,0 +1,399 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SCENEINDEX_HPP
+#define SFML_SCENEINDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    template <typename T> class HashTable;
+}
+
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Spatial index of drawables, drawing only the visible ones
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SceneIndex : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The cell size should be in the order of magnitude of the
+    /// size of the objects: too small cells make large objects
+    /// span many cells, too large cells make queries return
+    /// many objects that need to be tested individually.
+    ///
+    /// \param cellSize Width and height of the cells of the index
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SceneIndex(float cellSize = 256.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneIndex(const SceneIndex& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SceneIndex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneIndex& operator =(const SceneIndex& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable to the index
+    ///
+    /// The index only stores a pointer to the drawable, which
+    /// must exist as long as it is in the index.
+    ///
+    /// \param drawable Drawable to add
+    /// \param bounds   Global bounding rectangle of the drawable
+    ///
+    /// \return Identifier of the object in the index
+    ///
+    /// \see remove, setBounds
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Drawable& drawable, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an object that knows its global bounds to the index
+    ///
+    /// This overload works with all the SFML entities that have
+    /// a getGlobalBounds() function, such as sf::Sprite,
+    /// sf::Text and sf::Shape.
+    ///
+    /// \param object Object to add
+    ///
+    /// \return Identifier of the object in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    std::size_t add(const T& object)
+    {
+        return add(object, object.getGlobalBounds());
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an object from the index
+    ///
+    /// The identifier may be reused by objects added later.
+    ///
+    /// \param id Identifier of the object to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the objects from the index
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the bounds of an object
+    ///
+    /// This function must be called whenever an object moves
+    /// or changes its size. Only the cells that the object
+    /// enters or leaves are updated.
+    ///
+    /// \param id     Identifier of the object
+    /// \param bounds New global bounding rectangle of the object
+    ///
+    /// \see getBounds, update
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBounds(std::size_t id, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the bounds of an object from its current state
+    ///
+    /// This is a shortcut for setBounds(id, object.getGlobalBounds()).
+    ///
+    /// \param id     Identifier of the object
+    /// \param object Object whose bounds have changed
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    void update(std::size_t id, const T& object)
+    {
+        setBounds(id, object.getGlobalBounds());
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds of an object
+    ///
+    /// \param id Identifier of the object
+    ///
+    /// \return Global bounding rectangle of the object
+    ///
+    /// \see setBounds
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect& getBounds(std::size_t id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the drawable of an object
+    ///
+    /// \param id Identifier of the object
+    ///
+    /// \return Pointer to the drawable, or NULL if the object was removed
+    ///
+    ////////////////////////////////////////////////////////////
+    const Drawable* getDrawable(std::size_t id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of objects in the index
+    ///
+    /// \return Number of objects
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getObjectCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the objects that intersect an area
+    ///
+    /// The identifiers are returned in the order in which the
+    /// objects were added, which is also the order in which
+    /// they are drawn.
+    ///
+    /// \param area   Area to test, in global coordinates
+    /// \param result Vector that receives the identifiers of the objects (previous contents are discarded)
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const FloatRect& area, std::vector<std::size_t>& result) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the objects that are visible in a view
+    ///
+    /// The visible area is the bounding rectangle of the view,
+    /// so objects close to the corners of a rotated view may be
+    /// returned even though they are not visible.
+    ///
+    /// \param view   View to test
+    /// \param result Vector that receives the identifiers of the objects (previous contents are discarded)
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const View& view, std::vector<std::size_t>& result) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of objects drawn by the last draw
+    ///
+    /// \return Number of objects that were visible and submitted to the render target
+    ///
+    /// \see getCulledCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDrawnCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of objects skipped by the last draw
+    ///
+    /// \return Number of objects that were outside of the view
+    ///
+    /// \see getDrawnCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCulledCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible objects to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of cells covered by a rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CellRange
+    {
+        int left;   //!< Left-most column
+        int top;    //!< Top-most row
+        int right;  //!< Right-most column (inclusive)
+        int bottom; //!< Bottom-most row (inclusive)
+        bool large; //!< Does the rectangle cover too many cells to be stored in them?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Object stored in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Object
+    {
+        const Drawable* drawable; //!< Drawable of the object, NULL if the slot is free
+        FloatRect       bounds;   //!< Global bounding rectangle
+        CellRange       cells;    //!< Cells in which the object is stored
+        Uint64          order;    //!< Insertion order, used to sort the results
+        mutable Uint64  stamp;    //!< Last query that returned the object
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the range of cells covered by a rectangle
+    ///
+    /// \param rectangle Rectangle to convert
+    ///
+    /// \return Range of cells
+    ///
+    ////////////////////////////////////////////////////////////
+    CellRange getCellRange(const FloatRect& rectangle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store an object in the cells that it covers
+    ///
+    /// \param id Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void link(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an object from the cells that it covers
+    ///
+    /// \param id Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlink(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the objects of a list that intersect an area to the results
+    ///
+    /// \param ids    Objects to test
+    /// \param area   Area to test
+    /// \param stamp  Identifier of the current query
+    /// \param result Vector that receives the order and identifier of the matching objects
+    ///
+    ////////////////////////////////////////////////////////////
+    void collect(const std::vector<std::size_t>& ids, const FloatRect& area, Uint64 stamp,
+                 std::vector<std::pair<Uint64, std::size_t> >& result) const;
+
+    typedef priv::HashTable<std::vector<std::size_t> > CellMap;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float                                                m_cellSize;     //!< Size of the cells
+    std::vector<Object>                                  m_objects;      //!< Objects of the index, indexed by identifier
+    std::vector<std::size_t>                             m_freeIds;      //!< Identifiers of removed objects, reused first
+    CellMap*                                             m_cells;        //!< Objects stored in each non-empty cell
+    std::vector<std::size_t>                             m_largeObjects; //!< Objects that cover too many cells, tested on every query
+    Uint64                                               m_nextOrder;    //!< Insertion order of the next object
+    mutable Uint64                                       m_queryStamp;   //!< Identifier of the last query
+    mutable std::vector<std::pair<Uint64, std::size_t> > m_matches;      //!< Storage for the matches of a query
+    mutable std::vector<std::size_t>                     m_visible;      //!< Storage for the visible objects of a draw
+    mutable std::size_t                                  m_drawnCount;   //!< Number of objects drawn by the last draw
+    mutable std::size_t                                  m_culledCount;  //!< Number of objects culled by the last draw
+};
+
+} // namespace sf
+
+
+#endif // SFML_SCENEINDEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SceneIndex
+/// \ingroup graphics
+///
+/// sf::SceneIndex stores drawables together with their global
+/// bounding rectangle in a uniform grid, so that the objects
+/// visible in a view can be found without testing all of them.
+/// Drawing the index only submits the objects that intersect
+/// the view of the render target; the others are culled
+/// before reaching sf::RenderTarget::draw.
+///
+/// Each object is stored in all the grid cells that its bounds
+/// cover. Only the cells that contain objects are allocated, in
+/// a hash table, so the world doesn't need to have a fixed size
+/// and finding a cell takes constant time. Objects that
+/// cover a very large number of cells (a background, for example)
+/// are kept in a separate list that is tested on every query.
+///
+/// The index doesn't know when an object moves: after changing
+/// the position, rotation, scale or geometry of an object,
+/// call setBounds or update to store its new bounds.
+///
+/// Objects are drawn in the order in which they were added,
+/// whatever cells they are stored in.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::Sprite> tiles = ...;
+///
+/// sf::SceneIndex index(64.f);
+/// std::vector<std::size_t> ids;
+/// for (std::size_t i = 0; i < tiles.size(); ++i)
+///     ids.push_back(index.add(tiles[i]));
+///
+/// while (window.isOpen())
+/// {
+///     // Move an object
+///     tiles[42].move(1.f, 0.f);
+///     index.update(ids[42], tiles[42]);
+///
+///     window.clear();
+///     window.draw(index);
+///     window.display();
+///
+///     std::cout << index.getDrawnCount() << " drawn, "
+///               << index.getCulledCount() << " culled" << std::endl;
+/// }
+/// \endcode
+///
+/// \see sf::View, sf::Drawable
+///
+////////////////////////////////////////////////////////////
@@ -32,10 +32,13 @@
 #include <SFML/Graphics/Glsl.hpp>
 #include <SFML/Window/GlResource.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
+#include <iosfwd>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -81,6 +84,50 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pre-resolved reference to a uniform variable
+    ///
+    /// Handles are obtained once with getUniformHandle(), and
+    /// then passed to the setUniform() overloads that take a
+    /// handle instead of a name.
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    class UniformHandle
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor, creates an invalid handle
+        ///
+        ////////////////////////////////////////////////////////////
+        UniformHandle() : m_index(-1) {}
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the handle refers to a uniform
+        ///
+        /// \return True if the handle is valid, false otherwise
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isValid() const {return m_index >= 0;}
+
+    private:
+
+        friend class Shader;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the handle from an index in the uniform table
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit UniformHandle(int index) : m_index(index) {}
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        int m_index; //!< Index of the uniform in the table of its shader, -1 if invalid
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -287,6 +334,130 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& vertexShaderStream, InputStream& geometryShaderStream, InputStream& fragmentShaderStream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the vertex, geometry or fragment shader from a file
+    ///
+    /// This function reads the file and starts compiling the
+    /// shader, but doesn't wait for the compilation to finish:
+    /// use isReady() to know when the shader can be used, or
+    /// wait() to block until it is done. See loadFromFile(const std::string&, Type)
+    /// for the description of the arguments.
+    ///
+    /// Until the compilation finishes, the shader keeps its
+    /// previous program (if any), and drawing with it uses that
+    /// program. If the compilation fails, the previous program is
+    /// kept and wait() returns false. Loading the shader again, or
+    /// destroying it, waits for the compilation to finish and
+    /// discards its result.
+    ///
+    /// \param filename Path of the vertex, geometry or fragment shader file to load
+    /// \param type     Type of shader (vertex, geometry or fragment)
+    ///
+    /// \return True if the compilation was started, false if it failed
+    ///
+    /// \see loadFromMemoryAsync, isReady, wait
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFileAsync(const std::string& filename, Type type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading both the vertex and fragment shaders from files
+    ///
+    /// \param vertexShaderFilename   Path of the vertex shader file to load
+    /// \param fragmentShaderFilename Path of the fragment shader file to load
+    ///
+    /// \return True if the compilation was started, false if it failed
+    ///
+    /// \see loadFromFileAsync(const std::string&, Type)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFileAsync(const std::string& vertexShaderFilename, const std::string& fragmentShaderFilename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the vertex, geometry and fragment shaders from files
+    ///
+    /// \param vertexShaderFilename   Path of the vertex shader file to load
+    /// \param geometryShaderFilename Path of the geometry shader file to load
+    /// \param fragmentShaderFilename Path of the fragment shader file to load
+    ///
+    /// \return True if the compilation was started, false if it failed
+    ///
+    /// \see loadFromFileAsync(const std::string&, Type)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFileAsync(const std::string& vertexShaderFilename, const std::string& geometryShaderFilename, const std::string& fragmentShaderFilename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the vertex, geometry or fragment shader from a source code in memory
+    ///
+    /// \param shader String containing the source code of the shader
+    /// \param type   Type of shader (vertex, geometry or fragment)
+    ///
+    /// \return True if the compilation was started, false if it failed
+    ///
+    /// \see loadFromFileAsync(const std::string&, Type)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemoryAsync(const std::string& shader, Type type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading both the vertex and fragment shaders from source codes in memory
+    ///
+    /// \param vertexShader   String containing the source code of the vertex shader
+    /// \param fragmentShader String containing the source code of the fragment shader
+    ///
+    /// \return True if the compilation was started, false if it failed
+    ///
+    /// \see loadFromFileAsync(const std::string&, Type)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemoryAsync(const std::string& vertexShader, const std::string& fragmentShader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the vertex, geometry and fragment shaders from source codes in memory
+    ///
+    /// \param vertexShader   String containing the source code of the vertex shader
+    /// \param geometryShader String containing the source code of the geometry shader
+    /// \param fragmentShader String containing the source code of the fragment shader
+    ///
+    /// \return True if the compilation was started, false if it failed
+    ///
+    /// \see loadFromFileAsync(const std::string&, Type)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemoryAsync(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether an asynchronous load has finished
+    ///
+    /// This function doesn't block. When it sees that the
+    /// compilation is done, the new program replaces the previous
+    /// one. It returns true as well if no load is in progress.
+    ///
+    /// \return True if the shader is not being loaded anymore
+    ///
+    /// \see loadFromFileAsync, loadFromMemoryAsync, wait
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for an asynchronous load to finish
+    ///
+    /// This function blocks until the compilation in progress,
+    /// if any, is done. It returns immediately once isReady()
+    /// returned true.
+    ///
+    /// If the load failed, the shader keeps its previous program.
+    ///
+    /// \return True if the load succeeded and the shader has a valid program,
+    ///         false if the load failed
+    ///
+    /// \see isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait();
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p float uniform
     ///
@@ -545,6 +716,177 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a handle to a uniform variable
+    ///
+    /// Setting a uniform by name has to look up its location
+    /// and to bind the program every time. A handle looks up the
+    /// location only once, and the setUniform() overloads taking
+    /// a handle just store the value in the shader: all the values
+    /// that changed are sent to the graphics card in one go the
+    /// next time the shader is bound, usually by the next draw call.
+    ///
+    /// Handles stay valid when the shader is loaded again, as
+    /// long as the new program still declares the uniform.
+    ///
+    /// Both APIs can be mixed: setting a uniform by name discards
+    /// the value previously stored through its handle, if any.
+    ///
+    /// \param name Name of the uniform variable in GLSL
+    ///
+    /// \return Handle to the uniform, invalid if the shader is not
+    ///         loaded or doesn't contain the uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniformHandle(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p float uniform through a handle
+    ///
+    /// The value is sent to the graphics card the next time
+    /// the shader is bound.
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param x       Value of the float scalar
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec2 uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param vector  Value of the vec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Vec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec3 uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param vector  Value of the vec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Vec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec4 uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param vector  Value of the vec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Vec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p int uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param x       Value of the int scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, int x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec2 uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param vector  Value of the ivec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Ivec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec3 uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param vector  Value of the ivec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Ivec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec4 uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param vector  Value of the ivec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Ivec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bool uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param x       Value of the bool scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, bool x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec2 uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param vector  Value of the bvec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Bvec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec3 uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param vector  Value of the bvec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Bvec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec4 uniform through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param vector  Value of the bvec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Bvec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat3 matrix through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param matrix  Value of the mat3 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Mat3& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat4 matrix through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param matrix  Value of the mat4 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Glsl::Mat4& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect a uniform block to a uniform buffer binding point
+    ///
+    /// The variables of the block are then read from the
+    /// sf::UniformBuffer bound to the same binding point, which
+    /// can be shared by many shaders. The connection is lost
+    /// when the shader is loaded again.
+    ///
+    /// \param name         Name of the uniform block in GLSL
+    /// \param bindingPoint Index of the binding point
+    ///
+    /// \see sf::UniformBuffer::bind
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformBlock(const std::string& name, unsigned int bindingPoint);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a float parameter of the shader
     ///
@@ -637,6 +979,31 @@ public:
     ////////////////////////////////////////////////////////////
     unsigned int getNativeHandle() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time spent creating the program on the last load
+    ///
+    /// This includes compiling and linking the sources, or
+    /// loading the program from the binary cache, together
+    /// with updating the cache.
+    ///
+    /// \return Time spent in the last successful load
+    ///
+    /// \see isLoadedFromBinaryCache
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getCompileTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the last load used the binary cache
+    ///
+    /// \return True if the program was loaded from the binary
+    ///         cache, false if it was compiled from the sources
+    ///
+    /// \see setBinaryCacheDirectory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLoadedFromBinaryCache() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind a shader for rendering
     ///
@@ -660,6 +1027,31 @@ public:
     ////////////////////////////////////////////////////////////
     static void bind(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable the cache of linked shader programs
+    ///
+    /// Compiling and linking GLSL sources is slow, especially
+    /// with many shaders. When the cache is enabled, the program
+    /// binaries produced by the graphics driver are written to
+    /// \a directory, and the next loads of the same sources
+    /// create the program directly from these files.
+    ///
+    /// The files are identified by the sources and by the
+    /// driver (vendor, renderer and version). If the driver
+    /// rejects a binary, the shader is compiled from the sources
+    /// again and the file is replaced, so the cache can always
+    /// be used safely.
+    ///
+    /// The directory must exist and be writable. The cache is
+    /// disabled by default, pass an empty string to disable it
+    /// again. It has no effect if the system doesn't support
+    /// program binaries.
+    ///
+    /// \param directory Path of the directory that stores the binaries
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBinaryCacheDirectory(const std::string& directory);
+
     ////////////////////////////////////////////////////////////
     /// \brief Tell whether or not the system supports shaders
     ///
@@ -693,6 +1085,8 @@ public:
 
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     /// \brief Compile the shader(s) and create the program
     ///
@@ -708,14 +1102,75 @@ private:
     ////////////////////////////////////////////////////////////
     bool compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compile the shader(s) and create the program, reporting errors to a stream
+    ///
+    /// This overload is used by the worker thread of the
+    /// asynchronous compilation, which must not write to
+    /// sf::err() directly.
+    ///
+    /// \param vertexShaderCode   Source code of the vertex shader
+    /// \param geometryShaderCode Source code of the geometry shader
+    /// \param fragmentShaderCode Source code of the fragment shader
+    /// \param errors             Stream that receives the error messages
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode, std::ostream& errors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start compiling the shader(s) without waiting for the result
+    ///
+    /// \param vertexShaderCode   Source code of the vertex shader
+    /// \param geometryShaderCode Source code of the geometry shader
+    /// \param fragmentShaderCode Source code of the fragment shader
+    ///
+    /// \return True if the compilation was started, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool compileAsync(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for the asynchronous compilation and use its program
+    ///
+    ////////////////////////////////////////////////////////////
+    void finishAsyncCompilation();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the uniform state after the program changed
+    ///
+    /// Cached locations and textures are discarded, and the
+    /// uniforms accessed through handles are looked up again.
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetUniforms();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a shader, choosing how the textures are bound
+    ///
+    /// \param shader           Shader to bind, can be null to use no shader
+    /// \param useTextureMatrix Load the texture matrices of the textures
+    ///                         (see bindTextures)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const Shader* shader, bool useTextureMatrix);
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind all the textures used by the shader
     ///
     /// This function each texture to a different unit, and
     /// updates the corresponding variables in the shader accordingly.
     ///
+    /// Core profiles have no texture matrix: the programmable
+    /// backend of sf::RenderTarget binds the textures without
+    /// it, and passes the flip of render textures to the
+    /// shader in the sf_textureTransforms uniform instead.
+    ///
+    /// \param useTextureMatrix Flip render textures with the texture matrix
+    ///
     ////////////////////////////////////////////////////////////
-    void bindTextures() const;
+    void bindTextures(bool useTextureMatrix) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the location ID of a shader uniform
@@ -727,6 +1182,37 @@ private:
     ////////////////////////////////////////////////////////////
     int getUniformLocation(const std::string& name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the value of a uniform set through a handle
+    ///
+    /// \param uniform Handle to the uniform variable
+    /// \param type    Type of the value (UniformValue::Type)
+    /// \param floats  Float components of the value, or null
+    /// \param ints    Integer components of the value, or null
+    /// \param count   Number of components
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformValue(UniformHandle uniform, int type, const float* floats, const int* ints, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the value stored through a handle for a uniform
+    ///
+    /// Called when the uniform is set by name, so that the stored
+    /// value neither overwrites the new one nor hides a change.
+    ///
+    /// \param location Location of the uniform in the program
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateUniformValue(int location);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the values set through handles to the program
+    ///
+    /// The program must be bound.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyUniformValues() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief RAII object to save and restore the program
     ///        binding while uniforms are being set
@@ -736,19 +1222,62 @@ private:
     ////////////////////////////////////////////////////////////
     struct UniformBinder;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief State of an asynchronous compilation
+    ///
+    /// Implementation is private in the .cpp file.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct AsyncCompilation;
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
     typedef std::map<int, const Texture*> TextureTable;
     typedef std::map<std::string, int> UniformTable;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Uniform variable accessed through a handle
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformValue
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Types of values
+        ///
+        ////////////////////////////////////////////////////////////
+        enum Type
+        {
+            None, //!< No value was set yet
+            Float1, Float2, Float3, Float4,
+            Int1, Int2, Int3, Int4,
+            Matrix3, Matrix4
+        };
+
+        std::string name;       //!< Name of the uniform variable
+        int         location;   //!< Location of the uniform in the program
+        Type        type;       //!< Type of the current value
+        float       floats[16]; //!< Float components of the value
+        int         ints[4];    //!< Integer components of the value
+        bool        modified;   //!< Has the value changed since it was last sent?
+    };
+
+    typedef std::vector<UniformValue> UniformValueTable;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  //!< OpenGL identifier for the program
-    int          m_currentTexture; //!< Location of the current texture in the shader
-    TextureTable m_textures;       //!< Texture variables in the shader, mapped to their location
-    UniformTable m_uniforms;       //!< Parameters location cache
+    unsigned int                     m_shaderProgram;           //!< OpenGL identifier for the program
+    Uint64                           m_programId;               //!< Unique identifier of the program, OpenGL identifiers may be recycled
+    int                              m_currentTexture;          //!< Location of the current texture in the shader
+    TextureTable                     m_textures;                //!< Texture variables in the shader, mapped to their location
+    UniformTable                     m_uniforms;                //!< Parameters location cache
+    mutable UniformValueTable        m_uniformValues;           //!< Uniforms accessed through handles, with their last value
+    mutable std::vector<std::size_t> m_modifiedValues;          //!< Indices of the uniform values waiting to be sent
+    Time                             m_compileTime;             //!< Time spent creating the program on the last load
+    bool                             m_isLoadedFromBinaryCache; //!< Was the program loaded from the binary cache?
+    bool                             m_hasAsyncLoadFailed;      //!< Did the last asynchronous load fail?
+    AsyncCompilation*                m_asyncCompilation;        //!< Compilation in progress, if any
 };
 
 } // namespace sf
@@ -814,6 +1343,32 @@ private:
 /// shader.setUniform("current", sf::Shader::CurrentTexture);
 /// \endcode
 ///
+/// Uniforms that change often, for example once per drawn
+/// object, are better set through handles: the location is looked
+/// up only once, and the values are sent together when the shader
+/// is bound for the next draw call.
+/// \code
+/// sf::Shader::UniformHandle offsetUniform = shader.getUniformHandle("offset");
+/// ...
+/// shader.setUniform(offsetUniform, 2.f);
+/// \endcode
+///
+/// Loading many shaders at startup can take a long time; see
+/// setBinaryCacheDirectory() to store the compiled programs on disk
+/// and load them much faster on the next launches. Shaders can
+/// also be compiled in the background, while the application keeps
+/// rendering, with loadFromFileAsync() or loadFromMemoryAsync():
+/// \code
+/// shader.loadFromFileAsync("effect.vert", "effect.frag");
+/// ...
+/// if (shader.isReady())
+///     window.draw(sprite, &shader);
+/// \endcode
+///
+/// Variables shared by many shaders can be grouped in a uniform
+/// block, whose values are stored in a sf::UniformBuffer (see
+/// setUniformBlock()).
+///
 /// The old setParameter() overloads are deprecated and will be removed in a
 /// future version. You should use their setUniform() equivalents instead.
 ///
@@ -870,6 +1425,6 @@ private:
 /// sf::Shader::bind(NULL);
 /// \endcode
 ///
-/// \see sf::Glsl
+/// \see sf::Glsl, sf::UniformBuffer
 ///
 ////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <vector>
 
 
 namespace sf
@@ -262,6 +263,11 @@ protected:
     /// the shape's points change (i.e. the result of either
     /// getPointCount or getPoint is different).
     ///
+    /// The geometry is not recomputed immediately: it is only
+    /// marked as outdated, and rebuilt the next time the shape
+    /// is drawn or its bounds are requested. Calling this function
+    /// several times in a row is therefore cheap.
+    ///
     ////////////////////////////////////////////////////////////
     void update();
 
@@ -276,44 +282,83 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Parts of the geometry that must be recomputed
+    ///
+    ////////////////////////////////////////////////////////////
+    enum DirtyFlags
+    {
+        PositionsDirty      = 1 << 0, //!< The points must be fetched again from the derived class
+        FillColorsDirty     = 1 << 1, //!< The fill color has changed
+        TexCoordsDirty      = 1 << 2, //!< The texture rectangle has changed
+        OutlineNormalsDirty = 1 << 3, //!< The extrusion directions of the outline must be recomputed
+        OutlineDirty        = 1 << 4, //!< The outline thickness has changed
+        OutlineColorsDirty  = 1 << 5, //!< The outline color has changed
+        AllDirty            = (1 << 6) - 1
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the shape's geometry is updated
+    ///
+    /// Every setter only flags the parts of the geometry that
+    /// depend on it, and they are all rebuilt at once here,
+    /// right before they are needed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the fill vertices' position
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePositions() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' color
     ///
     ////////////////////////////////////////////////////////////
-    void updateFillColors();
+    void updateFillColors() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' texture coordinates
     ///
     ////////////////////////////////////////////////////////////
-    void updateTexCoords();
+    void updateTexCoords() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the extrusion direction of each outline point
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateOutlineNormals() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' position
     ///
     ////////////////////////////////////////////////////////////
-    void updateOutline();
+    void updateOutline() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' color
     ///
     ////////////////////////////////////////////////////////////
-    void updateOutlineColors();
+    void updateOutlineColors() const;
 
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Texture* m_texture;          //!< Texture of the shape
-    IntRect        m_textureRect;      //!< Rectangle defining the area of the source texture to display
-    Color          m_fillColor;        //!< Fill color
-    Color          m_outlineColor;     //!< Outline color
-    float          m_outlineThickness; //!< Thickness of the shape's outline
-    VertexArray    m_vertices;         //!< Vertex array containing the fill geometry
-    VertexArray    m_outlineVertices;  //!< Vertex array containing the outline geometry
-    FloatRect      m_insideBounds;     //!< Bounding rectangle of the inside (fill)
-    FloatRect      m_bounds;           //!< Bounding rectangle of the whole shape (outline + fill)
+    const Texture*                m_texture;          //!< Texture of the shape
+    IntRect                       m_textureRect;      //!< Rectangle defining the area of the source texture to display
+    Color                         m_fillColor;        //!< Fill color
+    Color                         m_outlineColor;     //!< Outline color
+    float                         m_outlineThickness; //!< Thickness of the shape's outline
+    mutable VertexArray           m_vertices;         //!< Vertex array containing the fill geometry
+    mutable VertexArray           m_outlineVertices;  //!< Vertex array containing the outline geometry
+    mutable std::vector<Vector2f> m_outlineNormals;   //!< Extrusion direction of each point, scaled by the outline thickness when building the outline
+    mutable FloatRect             m_insideBounds;     //!< Bounding rectangle of the inside (fill)
+    mutable FloatRect             m_bounds;           //!< Bounding rectangle of the whole shape (outline + fill)
+    mutable unsigned int          m_dirty;            //!< Parts of the geometry that need to be recomputed (see DirtyFlags enum)
 };
 
 } // namespace sf
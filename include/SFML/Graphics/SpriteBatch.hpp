@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class StreamingVertexBuffer;
+}
+
+class Texture;
+class Sprite;
+
+////////////////////////////////////////////////////////////
+/// \brief Drawable made of many textured quads, rendered
+///        with as few draw calls as possible
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty sprite batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch(const SpriteBatch& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch& operator =(const SpriteBatch& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites from the batch
+    ///
+    /// The memory allocated for the sprites is kept, so that
+    /// refilling the batch every frame doesn't reallocate.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Preallocate memory for a given number of sprites
+    ///
+    /// \param spriteCount Number of sprites to reserve memory for
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t spriteCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a textured quad to the batch
+    ///
+    /// The quad has the size of \a rectangle, its top-left
+    /// corner is at the local origin and it is transformed
+    /// by \a transform, exactly like a sf::Sprite would be.
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the batch uses it.
+    ///
+    /// \param texture   Texture of the quad
+    /// \param rectangle Sub-rectangle of the texture to display
+    /// \param transform Transform to apply to the quad
+    /// \param color     Color to modulate the texture with
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Texture& texture, const IntRect& rectangle, const Transform& transform = Transform::Identity, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a copy of a sprite to the batch
+    ///
+    /// The texture, texture rect, color and transform of the
+    /// sprite are captured at the time of the call; modifying
+    /// the sprite afterwards has no effect on the batch.
+    /// Sprites that have no texture are ignored.
+    ///
+    /// \param sprite Sprite to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Sprite& sprite);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of sprites in the batch
+    ///
+    /// \return Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSpriteCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable sorting the sprites by texture
+    ///
+    /// When sorting is enabled, sprites that use the same texture
+    /// are grouped together so that each texture costs a single
+    /// draw call. Textures are drawn in the order in which they
+    /// are first used, and the relative order of sprites that
+    /// share a texture is preserved, but a sprite may be drawn
+    /// before sprites of another texture that were added before
+    /// it, which matters if they overlap.
+    /// When sorting is disabled, sprites are drawn in order and
+    /// a new draw call is issued every time the texture changes.
+    ///
+    /// Sorting is disabled by default.
+    ///
+    /// \param enabled True to sort the sprites by texture, false to keep them in order
+    ///
+    /// \see isTextureSortingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureSortingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the sprites are sorted by texture
+    ///
+    /// \return True if sorting by texture is enabled, false otherwise
+    ///
+    /// \see setTextureSortingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isTextureSortingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of draw calls issued by the last draw
+    ///
+    /// \return Number of draw calls submitted to the render target
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getDrawCallCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the amount of vertex data uploaded by the last draw
+    ///
+    /// Vertices are only uploaded to the graphics card when the
+    /// contents of the batch changed since the previous draw.
+    ///
+    /// \return Number of bytes uploaded to the graphics card
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUploadedByteCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the sprite batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the vertices and draw ranges from the sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateGeometry() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transformed quad waiting to be drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Quad
+    {
+        const Texture* texture;     //!< Texture of the quad
+        Vertex         vertices[4]; //!< Transformed corners of the quad
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of vertices sharing the same texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Range
+    {
+        const Texture* texture;     //!< Texture of the range
+        std::size_t    first;       //!< Index of the first vertex of the range
+        std::size_t    vertexCount; //!< Number of vertices in the range
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Quad>                    m_quads;         //!< Sprites of the batch, in insertion order
+    bool                                 m_sortByTexture; //!< Are the quads grouped by texture?
+    mutable std::vector<Vertex>          m_vertices;      //!< Triangles built from the quads
+    mutable std::vector<Range>           m_ranges;        //!< Draw call ranges in m_vertices
+    mutable priv::StreamingVertexBuffer* m_buffer;        //!< Streaming vertex buffers holding m_vertices, created on the first draw
+    mutable bool                         m_needUpdate;    //!< Do the vertices need to be rebuilt and uploaded?
+    mutable unsigned int                 m_drawCallCount; //!< Number of draw calls issued by the last draw
+    mutable std::size_t                  m_uploadedBytes; //!< Number of bytes uploaded by the last draw
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch is a drawable that renders a large number
+/// of textured quads with a minimal number of draw calls.
+///
+/// Drawing thousands of sf::Sprite instances one by one is
+/// limited by the cost of submitting each of them to the
+/// graphics driver. A sprite batch instead collects the quads
+/// (texture rect, transform and color) of all its sprites,
+/// optionally groups them by texture and uploads them into a streaming
+/// sf::VertexBuffer, so that consecutive sprites sharing a
+/// texture only cost one draw call. The vertex data is only uploaded again when
+/// the contents of the batch change, and two buffers are used
+/// alternately so that uploading a new frame doesn't have to
+/// wait for the graphics card to finish rendering the previous one.
+///
+/// If vertex buffers are not available on the system, the
+/// batch falls back to drawing its vertices directly.
+///
+/// The textures used by a batch must exist as long as the
+/// batch refers to them.
+///
+/// Usage example:
+/// \code
+/// sf::SpriteBatch batch;
+///
+/// while (window.isOpen())
+/// {
+///     // Rebuild the batch
+///     batch.clear();
+///     for (std::size_t i = 0; i < particles.size(); ++i)
+///         batch.add(atlas, particles[i].rect, particles[i].transform, particles[i].color);
+///
+///     window.clear();
+///     window.draw(batch);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Sprite, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
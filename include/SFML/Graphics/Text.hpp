@@ -414,6 +414,22 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure saving the state of the geometry update at the beginning of a line
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        std::size_t              firstCharacter;      //!< Index of the first character of the line
+        float                    y;                   //!< Vertical position of the line's baseline
+        float                    minX;                //!< Left of the bounds of the previous lines
+        float                    minY;                //!< Top of the bounds of the previous lines
+        float                    maxX;                //!< Right of the bounds of the previous lines
+        float                    maxY;                //!< Bottom of the bounds of the previous lines
+        std::vector<std::size_t> vertexCounts;        //!< Number of vertices of the previous lines, in each fill vertex array
+        std::vector<std::size_t> outlineVertexCounts; //!< Number of vertices of the previous lines, in each outline vertex array
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -427,7 +443,9 @@ private:
     /// \brief Make sure the text's geometry is updated
     ///
     /// All the attributes related to rendering are cached, such
-    /// that the geometry is only updated when necessary.
+    /// that the geometry is only updated when necessary. When
+    /// only the string has changed, the lines before the first
+    /// modified character are kept.
     ///
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
@@ -435,20 +453,23 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;              //!< String to display
-    const Font*         m_font;                //!< Font used to display the string
-    unsigned int        m_characterSize;       //!< Base size of characters, in pixels
-    float               m_letterSpacingFactor; //!< Spacing factor between letters
-    float               m_lineSpacingFactor;   //!< Spacing factor between lines
-    Uint32              m_style;               //!< Text style (see Style enum)
-    Color               m_fillColor;           //!< Text fill color
-    Color               m_outlineColor;        //!< Text outline color
-    float               m_outlineThickness;    //!< Thickness of the text's outline
-    mutable VertexArray m_vertices;            //!< Vertex array containing the fill geometry
-    mutable VertexArray m_outlineVertices;     //!< Vertex array containing the outline geometry
-    mutable FloatRect   m_bounds;              //!< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate;  //!< Does the geometry need to be recomputed?
-    mutable Uint64      m_fontTextureId;       //!< The font texture id
+    String                           m_string;                 //!< String to display
+    const Font*                      m_font;                   //!< Font used to display the string
+    unsigned int                     m_characterSize;          //!< Base size of characters, in pixels
+    float                            m_letterSpacingFactor;    //!< Spacing factor between letters
+    float                            m_lineSpacingFactor;      //!< Spacing factor between lines
+    Uint32                           m_style;                  //!< Text style (see Style enum)
+    Color                            m_fillColor;              //!< Text fill color
+    Color                            m_outlineColor;           //!< Text outline color
+    float                            m_outlineThickness;       //!< Thickness of the text's outline
+    mutable std::vector<VertexArray> m_vertices;               //!< Vertex arrays containing the fill geometry, one per font texture
+    mutable std::vector<VertexArray> m_outlineVertices;        //!< Vertex arrays containing the outline geometry, one per font texture
+    mutable FloatRect                m_bounds;                 //!< Bounding rectangle of the text (in local coordinates)
+    mutable bool                     m_geometryNeedUpdate;     //!< Does the whole geometry need to be recomputed?
+    mutable std::size_t              m_firstOutdatedCharacter; //!< Index of the first character whose geometry must be recomputed (String::InvalidPos if none)
+    mutable std::vector<Line>        m_lines;                  //!< State of the geometry update at the beginning of each line
+    mutable std::vector<Vector2f>    m_characterPositions;     //!< Position of each character, followed by the position of the end of the string
+    mutable Uint64                   m_fontGeneration;         //!< Layout generation of the font when the geometry was computed
 };
 
 } // namespace sf
@@ -39,8 +39,15 @@ class InputStream;
 class RenderTarget;
 class RenderTexture;
 class Text;
+class TextureArray;
+class TextureReadback;
 class Window;
 
+namespace priv
+{
+    class CompressedImage;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Image living on the graphics card that can be used for drawing
 ///
@@ -115,6 +122,14 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// DDS and KTX files containing BC1/BC2/BC3 (DXT) or ETC2
+    /// compressed pixels are uploaded without being decoded when
+    /// the graphics driver supports their format, which saves
+    /// video memory and loading time. Otherwise, or when only a
+    /// sub-area is loaded, they are decoded to RGBA pixels first.
+    /// The pixels of a compressed texture can't be modified with
+    /// the update or lockPixels functions.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -146,6 +161,14 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// DDS and KTX files containing BC1/BC2/BC3 (DXT) or ETC2
+    /// compressed pixels are uploaded without being decoded when
+    /// the graphics driver supports their format, which saves
+    /// video memory and loading time. Otherwise, or when only a
+    /// sub-area is loaded, they are decoded to RGBA pixels first.
+    /// The pixels of a compressed texture can't be modified with
+    /// the update or lockPixels functions.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -178,6 +201,14 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// DDS and KTX files containing BC1/BC2/BC3 (DXT) or ETC2
+    /// compressed pixels are uploaded without being decoded when
+    /// the graphics driver supports their format, which saves
+    /// video memory and loading time. Otherwise, or when only a
+    /// sub-area is loaded, they are decoded to RGBA pixels first.
+    /// The pixels of a compressed texture can't be modified with
+    /// the update or lockPixels functions.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -366,6 +397,10 @@ public:
     /// This function does nothing if either the texture or the window
     /// was not previously created.
     ///
+    /// The primitives that a sf::RenderWindow keeps pending in its
+    /// batch are not copied: call its flush() function first if
+    /// batching is enabled (see RenderTarget::setBatchingEnabled).
+    ///
     /// \param window Window to copy to the texture
     ///
     ////////////////////////////////////////////////////////////
@@ -381,6 +416,10 @@ public:
     /// This function does nothing if either the texture or the window
     /// was not previously created.
     ///
+    /// The primitives that a sf::RenderWindow keeps pending in its
+    /// batch are not copied: call its flush() function first if
+    /// batching is enabled (see RenderTarget::setBatchingEnabled).
+    ///
     /// \param window Window to copy to the texture
     /// \param x      X offset in the texture where to copy the source window
     /// \param y      Y offset in the texture where to copy the source window
@@ -388,6 +427,84 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Window& window, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable streaming mode
+    ///
+    /// Streaming mode is meant for textures whose contents are
+    /// replaced very often, such as video frames. In this mode,
+    /// updates from an array of pixels go through a small ring
+    /// of pixel buffers: the transfer to the graphics card
+    /// happens asynchronously, and a buffer is only reused once
+    /// the graphics card is done with it. Unlike regular updates,
+    /// streamed updates don't force an OpenGL flush, so if the
+    /// texture is used by another thread, it is up to you to
+    /// synchronize them.
+    /// If pixel buffers are not supported by the system, updates
+    /// are done synchronously, without the flush.
+    /// Streaming mode is disabled by default.
+    ///
+    /// \param streaming True to enable streaming, false to disable it
+    ///
+    /// \see isStreaming, lockPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStreaming(bool streaming);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the texture is in streaming mode or not
+    ///
+    /// \return True if streaming mode is enabled, false if it is disabled
+    ///
+    /// \see setStreaming
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isStreaming() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to write new pixels of a part of the texture to
+    ///
+    /// This function returns a write-only array of width * height
+    /// RGBA pixels, which is whenever possible memory of a pixel
+    /// buffer mapped by the graphics driver: writing pixels there
+    /// directly avoids an extra copy compared to update. The
+    /// pixels are transferred to the texture when unlockPixels
+    /// is called, and the returned pointer is invalid after that.
+    /// The initial contents of the array are undefined, all the
+    /// pixels must be written.
+    ///
+    /// Only one region of the texture can be locked at a time.
+    /// This function enables streaming mode if it is not
+    /// already enabled.
+    ///
+    /// No additional check is performed on the size of the region,
+    /// passing an invalid combination of size and offset
+    /// will lead to an undefined behavior.
+    ///
+    /// This function returns a null pointer if the texture was
+    /// not previously created, or if its pixels are already locked.
+    ///
+    /// \param width  Width of the region to update
+    /// \param height Height of the region to update
+    /// \param x      X offset in the texture of the region to update
+    /// \param y      Y offset in the texture of the region to update
+    ///
+    /// \return Pointer to the array of pixels to fill
+    ///
+    /// \see unlockPixels, setStreaming
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* lockPixels(unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transfer the pixels written to the locked region to the texture
+    ///
+    /// This function does nothing if no region is locked.
+    ///
+    /// \see lockPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlockPixels();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the smooth filter
     ///
@@ -588,6 +705,11 @@ private:
     friend class Text;
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class Shader;
+    friend class TextureArray;
+    friend class TextureReadback;
+
+    struct PixelStream;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -613,6 +735,21 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from block-compressed pixels
+    ///
+    /// The blocks are uploaded as-is if the graphics driver
+    /// supports their format, otherwise they are decoded
+    /// and loaded like a regular image.
+    ///
+    /// \param image Compressed pixels to load into the texture
+    /// \param area  Area of the image to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedImage(const priv::CompressedImage& image, const IntRect& area);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -626,6 +763,9 @@ private:
     bool         m_fboAttachment; //!< Is this texture owned by a framebuffer object?
     bool         m_hasMipmap;     //!< Has the mipmap been generated?
     Uint64       m_cacheId;       //!< Unique number that identifies the texture to the render target's cache
+    PixelStream* m_pixelStream;   //!< Pixel buffers used in streaming mode, null if streaming is disabled
+    unsigned int m_layerCount;    //!< Number of layers if the texture is owned by a texture array, 0 otherwise
+    bool         m_isCompressed;  //!< Does the texture store block-compressed pixels?
 };
 
 } // namespace sf
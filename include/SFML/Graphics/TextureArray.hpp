@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREARRAY_HPP
+#define SFML_TEXTUREARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Stack of same-sized images living on the graphics
+///        card, that can be drawn with a single texture bind
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureArray : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty texture array.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture array
+    ///
+    /// The pixels of all the layers are left undefined.
+    /// This function fails if the graphics driver doesn't
+    /// support texture arrays (see isAvailable).
+    ///
+    /// If this function fails, the texture array is left unchanged.
+    ///
+    /// \param width      Width of the layers, in pixels
+    /// \param height     Height of the layers, in pixels
+    /// \param layerCount Number of layers
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int layerCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a whole layer from an image
+    ///
+    /// The size of \a image must match the size of the layers.
+    ///
+    /// \param layer Index of the layer to update
+    /// \param image Image to copy to the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(unsigned int layer, const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a layer from an image
+    ///
+    /// \param layer Index of the layer to update
+    /// \param image Image to copy to the layer
+    /// \param x     X offset in the layer where to copy the source image
+    /// \param y     Y offset in the layer where to copy the source image
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(unsigned int layer, const Image& image, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a layer from an array of pixels
+    ///
+    /// The \a pixel array is assumed to be in 32-bits RGBA
+    /// format, and to have a size of \a width x \a height.
+    ///
+    /// \param layer  Index of the layer to update
+    /// \param pixels Array of pixels to copy to the layer
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the layer where to copy the source pixels
+    /// \param y      Y offset in the layer where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(unsigned int layer, const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the layers
+    ///
+    /// \return Size of a layer, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of layers
+    ///
+    /// \return Number of layers, 0 if the texture array is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture rectangle addressing a part of a layer
+    ///
+    /// Layers are addressed as if they were stacked vertically
+    /// in a single texture: the returned rectangle can be given
+    /// to sf::Sprite::setTextureRect, or used to compute the
+    /// texture coordinates of vertices.
+    ///
+    /// \param layer     Index of the layer
+    /// \param rectangle Part of the layer, or an empty rectangle for the whole layer
+    ///
+    /// \return Texture rectangle matching \a rectangle in \a layer
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getTextureRect(unsigned int layer, const IntRect& rectangle = IntRect()) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable conversion from sRGB
+    ///
+    /// This only takes effect the next time create is called.
+    ///
+    /// \param sRgb True to enable sRGB conversion, false to disable it
+    ///
+    /// \see isSrgb, sf::Texture::setSrgb
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSrgb(bool sRgb);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the texture array source is converted from sRGB or not
+    ///
+    /// \return True if the texture array source is converted from sRGB, false if not
+    ///
+    /// \see setSrgb
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSrgb() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to the underlying texture
+    ///
+    /// This is the texture to assign to sf::RenderStates::texture
+    /// or to pass to sf::Sprite::setTexture. Its size is the size
+    /// of a layer, and copyToImage returns all the layers stacked
+    /// vertically. The internal sf::Texture is always the same
+    /// instance.
+    ///
+    /// \return Const reference to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports texture arrays
+    ///
+    /// This function should always be called before using
+    /// texture arrays. If it returns false, then any attempt
+    /// to create a texture array will fail.
+    ///
+    /// \return True if texture arrays are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of layers allowed
+    ///
+    /// \return Maximum number of layers, 0 if texture arrays are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumLayerCount();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Texture m_texture; //!< Texture holding the array and its settings
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureArray
+/// \ingroup graphics
+///
+/// sf::TextureArray holds a stack of images of the same size
+/// (the layers) in a single OpenGL texture. Everything drawn
+/// with any of the layers shares the same texture binding, so
+/// sprites and vertex arrays taken from many sprite sheets
+/// don't break the batching of draw calls.
+///
+/// The layers are addressed as if they were stacked vertically
+/// in one tall texture: the layer of each vertex is given by
+/// its texture coordinates, and getTextureRect converts a
+/// rectangle of a layer to this layout. The texture returned by
+/// getTexture is used like any other texture, in sf::RenderStates
+/// or with sf::Shader::CurrentTexture.
+///
+/// Texture arrays can't be sampled by the fixed pipeline, they
+/// must be drawn with a shader that declares a sampler2DArray
+/// and splits the vertical texture coordinate into a layer index
+/// and a position inside this layer.
+///
+/// Usage example:
+/// \code
+/// sf::TextureArray sheets;
+/// if (!sheets.create(512, 512, 2))
+///     return -1;
+/// sheets.update(0, heroesImage);
+/// sheets.update(1, monstersImage);
+///
+/// // The fragment shader that samples the array
+/// const std::string fragmentShader =
+///     "#extension GL_EXT_texture_array : enable\n"
+///     "uniform sampler2DArray texture;"
+///     "void main()"
+///     "{"
+///     "    float layer = floor(gl_TexCoord[0].y);"
+///     "    vec3 coords = vec3(gl_TexCoord[0].x, gl_TexCoord[0].y - layer, layer);"
+///     "    gl_FragColor = gl_Color * texture2DArray(texture, coords);"
+///     "}";
+///
+/// sf::Shader shader;
+/// shader.loadFromMemory(fragmentShader, sf::Shader::Fragment);
+/// shader.setUniform("texture", sf::Shader::CurrentTexture);
+///
+/// // Sprites from both layers share the same texture
+/// sf::Sprite hero(sheets.getTexture(), sheets.getTextureRect(0, sf::IntRect(0, 0, 32, 32)));
+/// sf::Sprite monster(sheets.getTexture(), sheets.getTextureRect(1, sf::IntRect(64, 0, 32, 32)));
+///
+/// window.draw(hero, &shader);
+/// window.draw(monster, &shader);
+/// \endcode
+///
+/// \see sf::Texture, sf::Shader
+///
+////////////////////////////////////////////////////////////
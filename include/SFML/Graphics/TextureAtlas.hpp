@@ -0,0 +1,325 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packs many images into a few large textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const std::size_t InvalidIndex; //!< Index returned when an image can't be added to the atlas
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The textures of the atlas start small and grow as
+    /// images are added, up to \a maximumTextureSize (or the
+    /// maximum size supported by the graphics driver if it is
+    /// lower). When a texture is full, a new one is created.
+    ///
+    /// \param maximumTextureSize Maximum width and height of the textures
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureAtlas(unsigned int maximumTextureSize = 4096);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image to the atlas
+    ///
+    /// The pixels of \a image are copied to one of the textures
+    /// of the atlas; the image can be destroyed afterwards.
+    /// Use getTextureIndex and getTextureRect with the returned
+    /// index to know where the image was stored.
+    ///
+    /// \param image Image to add
+    ///
+    /// \return Index of the image in the atlas, or InvalidIndex if it could not be added
+    ///
+    /// \see addFromFile, remove
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file and add it to the atlas
+    ///
+    /// See sf::Image::loadFromFile for the supported formats.
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return Index of the image in the atlas, or InvalidIndex if it could not be added
+    ///
+    /// \see add
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an image from the atlas
+    ///
+    /// The index may be returned again by a later call to add.
+    /// The space used by the image is only given back when
+    /// the atlas is repacked.
+    ///
+    /// \param index Index of the image to remove
+    ///
+    /// \see repack
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack all the images again, tallest first
+    ///
+    /// This reclaims the space of removed images and usually
+    /// packs the images more tightly than successive calls to
+    /// add, which may free some of the textures. The indices
+    /// of the images don't change, but their texture and
+    /// texture rectangle do: sprites must be updated.
+    ///
+    /// This function is slow, since all the pixels are copied
+    /// back from the graphics card.
+    ///
+    /// \return True if all the images could be packed again
+    ///
+    ////////////////////////////////////////////////////////////
+    bool repack();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images and textures of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of textures of the atlas
+    ///
+    /// \return Number of textures
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTextureCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get one of the textures of the atlas
+    ///
+    /// The textures keep the same address when images are
+    /// added, even if they have to grow. Only repack and
+    /// clear may destroy textures.
+    ///
+    /// \param textureIndex Index of the texture, in range [0 .. getTextureCount() - 1]
+    ///
+    /// \return Read-only reference to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(std::size_t textureIndex) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the texture that contains an image
+    ///
+    /// \param index Index of the image, as returned by add
+    ///
+    /// \return Index of the texture containing the image
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTextureIndex(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rectangle of an image in its texture
+    ///
+    /// The returned rectangle can be given directly to
+    /// sf::Sprite::setTextureRect.
+    ///
+    /// \param index Index of the image, as returned by add
+    ///
+    /// \return Texture rectangle of the image, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getTextureRect(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of the textures
+    ///
+    /// Images are separated by a transparent pixel so that
+    /// smoothing doesn't bleed neighbour images into each other.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a row of images in a texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Row
+    {
+        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
+
+        unsigned int width;  //!< Current width of the row
+        unsigned int top;    //!< Y position of the row into the texture
+        unsigned int height; //!< Height of the row
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::multimap<unsigned int, std::size_t> RowTable; //!< Table mapping a row height to the index of a row that has free space
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a texture of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        Page();
+
+        Texture          texture;  //!< Texture containing the pixels of the images
+        unsigned int     nextRow;  //!< Y position of the next new row in the texture
+        std::vector<Row> rows;     //!< List containing the position of all the existing rows
+        RowTable         openRows; //!< Rows which still have free space, sorted by height
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining the location of an image
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Entry();
+
+        std::size_t page; //!< Index of the texture containing the image, InvalidIndex if the entry is free
+        IntRect     rect; //!< Rectangle of the image in its texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the pixels of an image in one of the textures
+    ///
+    /// \param image Image to store
+    /// \param entry Entry to fill with the location of the image
+    ///
+    /// \return True if the image could be stored
+    ///
+    ////////////////////////////////////////////////////////////
+    bool insert(const Image& image, Entry& entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make room for a new row in a texture
+    ///
+    /// The texture is enlarged if needed and allowed.
+    ///
+    /// \param page   Texture in which to create the row
+    /// \param width  Width that the row must be able to hold
+    /// \param height Height of the row
+    ///
+    /// \return Pointer to the new row, or NULL if there is no room left
+    ///
+    ////////////////////////////////////////////////////////////
+    Row* createRow(Page& page, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Page>         m_pages;       //!< Textures of the atlas, a deque so that references to them remain valid when new ones are added
+    std::vector<Entry>       m_entries;     //!< Locations of the images
+    std::vector<std::size_t> m_freeEntries; //!< Indices of the removed images, which can be reused
+    unsigned int             m_maximumSize; //!< Maximum width and height of the textures
+    bool                     m_isSmooth;    //!< Status of the smooth filter
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Every sf::Texture is a separate OpenGL object, and drawing
+/// with a different texture breaks the batching of draw calls.
+/// sf::TextureAtlas copies many small images into a few large
+/// textures at runtime, so that the sprites using them share
+/// their texture.
+///
+/// Images are packed in rows of similar heights. The textures
+/// start small and are enlarged as needed; when a texture has
+/// reached its maximum size, a new one is created. Removed
+/// images leave holes that are reclaimed by repack, which also
+/// packs the remaining images more tightly.
+///
+/// Usage example:
+/// \code
+/// sf::TextureAtlas atlas;
+///
+/// std::size_t hero = atlas.addFromFile("hero.png");
+/// std::size_t tree = atlas.addFromFile("tree.png");
+/// if ((hero == sf::TextureAtlas::InvalidIndex) || (tree == sf::TextureAtlas::InvalidIndex))
+///     return -1;
+///
+/// // Both sprites most likely share the same texture
+/// sf::Sprite heroSprite(atlas.getTexture(atlas.getTextureIndex(hero)), atlas.getTextureRect(hero));
+/// sf::Sprite treeSprite(atlas.getTexture(atlas.getTextureIndex(tree)), atlas.getTextureRect(tree));
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREREADBACK_HPP
+#define SFML_TEXTUREREADBACK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class RenderWindow;
+class Window;
+
+////////////////////////////////////////////////////////////
+/// \brief Asynchronous copy of the pixels of a texture to the central memory
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureReadback : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start reading the pixels of a texture
+    ///
+    /// The pixels are captured as they are when this function
+    /// is called, but the transfer happens asynchronously: the
+    /// function returns without waiting for the graphics card.
+    /// Any readback started previously and not collected yet
+    /// is discarded.
+    ///
+    /// If the system doesn't support pixel buffers, the pixels
+    /// are read synchronously.
+    ///
+    /// \param texture Texture to read
+    ///
+    /// \return True if the readback was started, false if the texture is empty
+    ///
+    /// \see isReady, copyToImage, copyToPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start reading the contents of a window
+    ///
+    /// This function copies the contents of the window to an
+    /// internal texture, which is then read asynchronously.
+    /// It is the asynchronous equivalent of a screenshot.
+    ///
+    /// The primitives that a sf::RenderWindow keeps pending in its
+    /// batch are not copied by this overload: use the one that
+    /// takes a sf::RenderWindow, or call its flush() function first
+    /// (see RenderTarget::setBatchingEnabled).
+    ///
+    /// \param window Window to read
+    ///
+    /// \return True if the readback was started
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(const Window& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start reading the contents of a render window
+    ///
+    /// This function renders the primitives pending in the batch
+    /// of the window, then reads its contents like
+    /// start(const Window&) does.
+    ///
+    /// \param window Render window to read
+    ///
+    /// \return True if the readback was started
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(RenderWindow& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a readback was started and not collected yet
+    ///
+    /// \return True if a readback is pending
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the pixels can be collected without waiting
+    ///
+    /// This function doesn't block. Pixels are usually ready
+    /// a frame or two after the readback was started.
+    ///
+    /// \return True if the pending readback is complete
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the pending readback
+    ///
+    /// \return Size of the pixels being read, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect the pixels to an array of pixels
+    ///
+    /// The \a pixels array must have room for getSize().x *
+    /// getSize().y RGBA pixels; they are written directly to it.
+    /// If the readback is not ready yet, this function waits
+    /// for it. Once collected, the readback is not pending
+    /// anymore.
+    ///
+    /// \param pixels Array of pixels to write
+    ///
+    /// \return True if pixels were collected, false if no readback was pending
+    ///
+    /// \see copyToImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool copyToPixels(Uint8* pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect the pixels to an image
+    ///
+    /// If the readback is not ready yet, this function waits
+    /// for it. Once collected, the readback is not pending
+    /// anymore. The image is left unchanged if no readback
+    /// was pending.
+    ///
+    /// \param image Image to fill with the pixels
+    ///
+    /// \return True if pixels were collected, false if no readback was pending
+    ///
+    /// \see copyToPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    bool copyToImage(Image& image);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the pending readback
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u     m_size;       //!< Size of the pixels being read
+    Vector2u     m_actualSize; //!< Size of the texture being read, including its padding
+    bool         m_flipped;    //!< Are the pixels of the texture flipped vertically?
+    unsigned int m_buffer;     //!< Pixel pack buffer receiving the pixels
+    std::size_t  m_capacity;   //!< Size allocated for the pixel pack buffer, in bytes
+    void*        m_fence;      //!< Fence signaled when the pixels are in the buffer
+    Image        m_image;      //!< Pixels read synchronously when pixel buffers are not available
+    Texture      m_texture;    //!< Texture receiving the contents of windows
+    bool         m_isPending;  //!< Was a readback started and not collected yet?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREREADBACK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureReadback
+/// \ingroup graphics
+///
+/// sf::TextureReadback copies the pixels of a texture, or of
+/// a window, to the central memory without stalling the
+/// graphics pipeline like sf::Texture::copyToImage does.
+/// The copy is started on the graphics card, and its result
+/// is collected later, usually a frame or two later, once
+/// the graphics card is done with it.
+///
+/// The pixels are transferred to a pixel buffer, then written
+/// directly to the destination image or array when collected;
+/// a readback object reuses its pixel buffer for all the
+/// readbacks it does. To capture a frame every frame without
+/// waiting, use a few readback objects in turn.
+///
+/// Usage example:
+/// \code
+/// // Capture the window every frame, and save the frame captured two frames ago
+/// sf::TextureReadback readbacks[3];
+/// std::size_t frame = 0;
+/// while (window.isOpen())
+/// {
+///     // ... draw and display ...
+///
+///     sf::TextureReadback& readback = readbacks[frame % 3];
+///     if (readback.isPending())
+///     {
+///         sf::Image image;
+///         readback.copyToImage(image);
+///         encodeFrame(image);
+///     }
+///     readback.start(window);
+///     ++frame;
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::Image
+///
+////////////////////////////////////////////////////////////
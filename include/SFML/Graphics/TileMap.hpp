@@ -0,0 +1,429 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Grid of textured tiles, split into chunks that are
+///        cached on the graphics card
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable
+{
+public:
+
+    static const Uint32 EmptyTile; //!< Tile value that leaves a cell of the map empty
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty map, with no tiles and no tileset.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The vertex buffers are not shared: the copy uploads
+    /// its chunks again when they are drawn.
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap(const TileMap& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap& operator =(const TileMap& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the map
+    ///
+    /// All the tiles of the new map are set to EmptyTile.
+    /// Larger chunks need fewer draw calls, smaller chunks
+    /// draw fewer invisible tiles on the borders of the view
+    /// and re-upload less data when a tile changes.
+    ///
+    /// \param size      Size of the map, in tiles
+    /// \param tileSize  Size of a tile, in pixels
+    /// \param chunkSize Width and height of a chunk, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const Vector2u& size, const Vector2u& tileSize, unsigned int chunkSize = 64);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the tileset of the map
+    ///
+    /// The tileset is a texture containing tiles of the size
+    /// given to create(), arranged in rows. Tiles are numbered
+    /// from left to right, then from top to bottom, starting
+    /// at 0.
+    /// The texture argument refers to a texture that must
+    /// exist as long as the map uses it. Indeed, the map
+    /// doesn't store its own copy of the texture, but rather
+    /// keeps a pointer to the one that you passed to this function.
+    ///
+    /// \param texture New tileset
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the tileset of the map
+    ///
+    /// \return Pointer to the tileset, or NULL if no tileset was set
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a tile of the map
+    ///
+    /// Only the modified tiles are uploaded again, the next
+    /// time their chunk is drawn. Coordinates out of the map
+    /// are ignored.
+    ///
+    /// \param x    Column of the tile
+    /// \param y    Row of the tile
+    /// \param tile Index of the tile in the tileset, or EmptyTile
+    ///
+    /// \see getTile, setTiles
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int x, unsigned int y, Uint32 tile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change all the tiles of the map
+    ///
+    /// \param tiles Array of getSize().x * getSize().y tile indices, row by row
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTiles(const Uint32* tiles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile of the map
+    ///
+    /// \param x Column of the tile
+    /// \param y Row of the tile
+    ///
+    /// \return Index of the tile in the tileset, or EmptyTile if empty or out of the map
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getTile(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the map
+    ///
+    /// \return Size of the map, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a tile
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a chunk
+    ///
+    /// \return Width and height of a chunk, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChunkSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the map
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the map
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum number of chunks kept on the graphics card
+    ///
+    /// Each chunk that has been visible keeps a vertex buffer of
+    /// chunkSize * chunkSize * 6 vertices (about 480 KB for chunks
+    /// of 64x64 tiles). When more chunks than \a chunkCount have
+    /// a buffer, the buffers of the chunks that were drawn least
+    /// recently are released after the next draw; the chunks are
+    /// uploaded again when they become visible. Chunks drawn by
+    /// the last draw are never released, even if there are more
+    /// of them than \a chunkCount.
+    ///
+    /// The default cache size is 256 chunks.
+    ///
+    /// \param chunkCount Maximum number of chunks that keep their vertex buffer
+    ///
+    /// \see getChunkCacheSize, getCachedChunkCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setChunkCacheSize(std::size_t chunkCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of chunks kept on the graphics card
+    ///
+    /// \return Maximum number of chunks that keep their vertex buffer
+    ///
+    /// \see setChunkCacheSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChunkCacheSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of chunks currently stored on the graphics card
+    ///
+    /// \return Number of chunks that have a vertex buffer
+    ///
+    /// \see setChunkCacheSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCachedChunkCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of chunks drawn by the last draw
+    ///
+    /// \return Number of chunks that intersected the view
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getDrawnChunkCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the amount of vertex data uploaded by the last draw
+    ///
+    /// \return Number of bytes uploaded to the graphics card
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUploadedByteCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks of the map to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::pair<unsigned int, unsigned int> TileRange; //!< First and last (inclusive) tiles of a range of a chunk
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Part of the map stored in its own vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Chunk
+    {
+        VertexBuffer*          buffer;     //!< Vertices of the tiles of the chunk, 6 per tile, created on the first draw
+        std::vector<TileRange> dirtyTiles; //!< Ranges of tiles to upload again, sorted and disjoint
+        Uint64                 lastDraw;   //!< Value of the draw counter when the chunk was last drawn
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of the map covered by a chunk
+    ///
+    /// \param index Index of the chunk
+    ///
+    /// \return Position and size of the chunk, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    Rect<unsigned int> getChunkArea(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark tiles of a chunk as needing to be uploaded again
+    ///
+    /// \param index Index of the chunk
+    /// \param first First tile of the chunk to mark
+    /// \param last  Last tile of the chunk to mark (inclusive)
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t index, unsigned int first, unsigned int last) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark all the tiles of the map as needing to be uploaded again
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateAll() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the least recently drawn chunks that exceed the cache size
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseChunks() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the vertex buffers of all the chunks
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseAllChunks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the vertices of a range of tiles of a chunk
+    ///
+    /// The vertices are written to m_vertices.
+    ///
+    /// \param index Index of the chunk
+    /// \param first First tile of the chunk to build
+    /// \param last  Last tile of the chunk to build (inclusive)
+    ///
+    ////////////////////////////////////////////////////////////
+    void buildTiles(std::size_t index, unsigned int first, unsigned int last) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u                         m_size;            //!< Size of the map, in tiles
+    Vector2u                         m_tileSize;        //!< Size of a tile, in pixels
+    unsigned int                     m_chunkSize;       //!< Width and height of a chunk, in tiles
+    Vector2u                         m_chunkCount;      //!< Number of chunks in each direction
+    const Texture*                   m_texture;         //!< Tileset of the map
+    unsigned int                     m_tilesetColumns;  //!< Number of tiles in a row of the tileset
+    std::vector<Uint32>              m_tiles;           //!< Tiles of the map, row by row
+    mutable std::vector<Chunk>       m_chunks;          //!< Chunks of the map, row by row
+    mutable std::vector<std::size_t> m_cachedChunks;    //!< Indices of the chunks that have a vertex buffer
+    std::size_t                      m_chunkCacheSize;  //!< Maximum number of chunks that keep their vertex buffer
+    mutable Uint64                   m_drawCount;       //!< Number of draws so far, to find the least recently drawn chunks
+    mutable std::vector<Vertex>      m_vertices;        //!< Storage for the vertices being built
+    mutable unsigned int             m_drawnChunkCount; //!< Number of chunks drawn by the last draw
+    mutable std::size_t              m_uploadedBytes;   //!< Number of bytes uploaded by the last draw
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap is a drawable grid of tiles taken from a single
+/// tileset texture, designed for very large maps.
+///
+/// Building a large tile layer into an sf::VertexArray means
+/// sending all of its vertices to the graphics card on every
+/// draw. A tile map instead splits the map into square chunks,
+/// and stores the vertices of each chunk in its own
+/// sf::VertexBuffer with the sf::VertexBuffer::Static usage.
+/// Chunks are only built and uploaded the first time they are
+/// visible, and changing a tile only uploads again the modified
+/// tiles of its chunk. The number of chunks kept on the graphics
+/// card is bounded (see setChunkCacheSize): the buffers of the
+/// chunks that were not visible for the longest time are released
+/// when the map is panned over a large area. When drawn, the map only submits the chunks
+/// that intersect the view of the render target, so that the
+/// cost of a frame depends on the size of the view rather than
+/// on the size of the map.
+///
+/// If vertex buffers are not available on the system, the visible
+/// chunks are built and drawn directly every frame.
+///
+/// sf::TileMap inherits all the functions from sf::Transformable:
+/// position, rotation, scale, origin.
+///
+/// Usage example:
+/// \code
+/// sf::Texture tileset;
+/// tileset.loadFromFile("tileset.png");
+///
+/// // A 4096x4096 map of 16x16 tiles
+/// sf::TileMap map;
+/// map.create(sf::Vector2u(4096, 4096), sf::Vector2u(16, 16));
+/// map.setTexture(tileset);
+/// map.setTiles(&level[0]);
+///
+/// // Later, change a single tile
+/// map.setTile(10, 20, 3);
+///
+/// window.draw(map);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_UNIFORMBUFFER_HPP
+#define SFML_UNIFORMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Buffer in graphics memory holding the variables
+///        of shader uniform blocks
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API UniformBuffer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty uniform buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the uniform buffer
+    ///
+    /// Allocates \a size bytes in graphics memory. The contents
+    /// of the buffer are undefined until update() is called.
+    ///
+    /// If the buffer was already created, it is resized.
+    ///
+    /// \param size Size of the buffer, in bytes
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of bytes
+    ///
+    /// The layout of \a data must match the layout of the
+    /// uniform block in the shaders; declaring the block with
+    /// the \p std140 layout makes it predictable.
+    ///
+    /// When the whole buffer is updated, its previous storage is
+    /// discarded, so that the driver doesn't have to wait for
+    /// draw calls still reading the old values.
+    ///
+    /// \param data   Pointer to the bytes to copy
+    /// \param size   Number of bytes to copy
+    /// \param offset Offset in the buffer to copy to, in bytes
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const void* data, std::size_t size, std::size_t offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the buffer
+    ///
+    /// \return Size of the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the uniform buffer.
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the uniform buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a uniform buffer to a binding point
+    ///
+    /// Every shader whose uniform block is connected to
+    /// the same binding point (see Shader::setUniformBlock)
+    /// reads its variables from this buffer.
+    ///
+    /// Binding points are part of the state of an OpenGL context:
+    /// the binding only applies to the context that is active
+    /// when this function is called, until another buffer is
+    /// bound to the same point in that context. When several
+    /// render targets with their own context draw with the
+    /// buffer, activate each of them and bind it again (see
+    /// RenderTarget::setActive).
+    ///
+    /// \param uniformBuffer Pointer to the uniform buffer to bind, can be null to use no buffer
+    /// \param bindingPoint  Index of the binding point
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const UniformBuffer* uniformBuffer, unsigned int bindingPoint);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports uniform buffers
+    ///
+    /// This function should always be called before using
+    /// the uniform buffer features. If it returns false, then
+    /// any attempt to use sf::UniformBuffer will fail.
+    ///
+    /// \return True if uniform buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer; //!< Internal buffer identifier
+    std::size_t  m_size;   //!< Size of the buffer, in bytes
+};
+
+} // namespace sf
+
+
+#endif // SFML_UNIFORMBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UniformBuffer
+/// \ingroup graphics
+///
+/// sf::UniformBuffer stores the variables of a GLSL uniform
+/// block in graphics memory. Data that is the same for many
+/// shaders, like the view matrices or the time of the current
+/// frame, is uploaded once per frame into the buffer instead of
+/// being set on every shader with setUniform().
+///
+/// Example:
+/// \code
+/// // GLSL: layout(std140) uniform Frame { mat4 viewMatrix; float time; };
+/// struct Frame
+/// {
+///     float viewMatrix[16];
+///     float time;
+///     float padding[3];
+/// };
+///
+/// sf::UniformBuffer frameBuffer;
+/// frameBuffer.create(sizeof(Frame));
+/// sf::UniformBuffer::bind(&frameBuffer, 0);
+///
+/// shader1.setUniformBlock("Frame", 0);
+/// shader2.setUniformBlock("Frame", 0);
+///
+/// while (window.isOpen())
+/// {
+///     Frame frame;
+///     ...
+///     frameBuffer.update(&frame, sizeof(frame));
+///     window.draw(sprite1, &shader1);
+///     window.draw(sprite2, &shader2);
+/// }
+/// \endcode
+///
+/// \see sf::Shader
+///
+////////////////////////////////////////////////////////////
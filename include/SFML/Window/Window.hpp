@@ -251,6 +251,29 @@ public:
     ////////////////////////////////////////////////////////////
     void display();
 
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Type of the function called before a window is displayed
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void(*DisplayCallback)(void*);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a function to be called before the window is displayed
+    ///
+    /// This is used for internal purposes, so that derived classes
+    /// that defer their rendering, such as sf::RenderWindow, can
+    /// finish the frame before the buffers are swapped, even when
+    /// display() is called through a reference to sf::Window.
+    /// Registering a new function replaces the previous one.
+    ///
+    /// \param callback Function to be called in display(), or NULL to remove it
+    /// \param arg      Argument to pass when calling the function
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDisplayCallback(DisplayCallback callback, void* arg);
+
 private:
 
     ////////////////////////////////////////////////////////////
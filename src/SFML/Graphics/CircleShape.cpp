@@ -26,7 +26,57 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <cmath>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+    typedef std::map<std::size_t, std::vector<sf::Vector2f> > UnitCircleTable;
+
+    struct UnitCircleCache
+    {
+        sf::Mutex       mutex;
+        UnitCircleTable circles;
+    };
+
+    // Constructed on first use, so that circles defined at global scope
+    // in other translation units never see an uninitialized cache
+    UnitCircleCache& getUnitCircleCache()
+    {
+        static UnitCircleCache cache;
+        return cache;
+    }
+
+    // Get the points of a circle of radius 1 centered on the origin, starting at the top;
+    // the tables are computed once per point count and shared by all the circles
+    const sf::Vector2f* getUnitCircle(std::size_t pointCount)
+    {
+        if (pointCount == 0)
+            return NULL;
+
+        UnitCircleCache& cache = getUnitCircleCache();
+        sf::Lock lock(cache.mutex);
+
+        std::vector<sf::Vector2f>& points = cache.circles[pointCount];
+        if (points.empty())
+        {
+            static const float pi = 3.141592654f;
+
+            points.resize(pointCount);
+            for (std::size_t i = 0; i < pointCount; ++i)
+            {
+                float angle = i * 2 * pi / pointCount - pi / 2;
+                points[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+            }
+        }
+
+        return &points[0];
+    }
+}
 
 
 namespace sf
@@ -34,7 +84,8 @@ namespace sf
 ////////////////////////////////////////////////////////////
 CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
-m_pointCount(pointCount)
+m_pointCount(pointCount),
+m_unitCircle(getUnitCircle(pointCount))
 {
     update();
 }
@@ -58,7 +109,11 @@ float CircleShape::getRadius() const
 ////////////////////////////////////////////////////////////
 void CircleShape::setPointCount(std::size_t count)
 {
-    m_pointCount = count;
+    if (count != m_pointCount)
+    {
+        m_pointCount = count;
+        m_unitCircle = getUnitCircle(count);
+    }
     update();
 }
 
@@ -72,11 +127,9 @@ std::size_t CircleShape::getPointCount() const
 ////////////////////////////////////////////////////////////
 Vector2f CircleShape::getPoint(std::size_t index) const
 {
-    static const float pi = 3.141592654f;
-
-    float angle = index * 2 * pi / m_pointCount - pi / 2;
-    float x = std::cos(angle) * m_radius;
-    float y = std::sin(angle) * m_radius;
+    // Scale the precomputed unit circle instead of evaluating cos and sin again
+    float x = m_unitCircle[index].x * m_radius;
+    float y = m_unitCircle[index].y * m_radius;
 
     return Vector2f(m_radius + x, m_radius + y);
 }
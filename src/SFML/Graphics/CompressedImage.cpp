@@ -0,0 +1,728 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+
+namespace
+{
+    // Container signatures
+    const sf::Uint8 ddsSignature[4]  = {'D', 'D', 'S', ' '};
+    const sf::Uint8 ktxSignature[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    // Pixel format values found in DDS files
+    const sf::Uint32 ddsHeaderSize       = 124;
+    const sf::Uint32 ddsFourCCFlag       = 0x4;
+    const sf::Uint32 ddsTexture2D        = 3;
+    const sf::Uint32 dxgiFormatBc1       = 71;
+    const sf::Uint32 dxgiFormatBc1Srgb   = 72;
+    const sf::Uint32 dxgiFormatBc2       = 74;
+    const sf::Uint32 dxgiFormatBc2Srgb   = 75;
+    const sf::Uint32 dxgiFormatBc3       = 77;
+    const sf::Uint32 dxgiFormatBc3Srgb   = 78;
+
+    // OpenGL internal formats found in KTX files
+    const sf::Uint32 ktxEndianness       = 0x04030201;
+    const sf::Uint32 ktxRgbDxt1          = 0x83F0;
+    const sf::Uint32 ktxRgbaDxt1         = 0x83F1;
+    const sf::Uint32 ktxRgbaDxt3         = 0x83F2;
+    const sf::Uint32 ktxRgbaDxt5         = 0x83F3;
+    const sf::Uint32 ktxSrgbDxt1         = 0x8C4C;
+    const sf::Uint32 ktxSrgbAlphaDxt1    = 0x8C4D;
+    const sf::Uint32 ktxSrgbAlphaDxt3    = 0x8C4E;
+    const sf::Uint32 ktxSrgbAlphaDxt5    = 0x8C4F;
+    const sf::Uint32 ktxEtc1Rgb8         = 0x8D64;
+    const sf::Uint32 ktxRgb8Etc2         = 0x9274;
+    const sf::Uint32 ktxSrgb8Etc2        = 0x9275;
+    const sf::Uint32 ktxRgba8Etc2Eac     = 0x9278;
+    const sf::Uint32 ktxSrgb8Alpha8Eac   = 0x9279;
+
+    // ETC1/ETC2 intensity modifiers, indexed by table codeword
+    const int etcModifiers[8][2] =
+    {
+        {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+    };
+
+    // ETC2 T and H modes distances
+    const int etcDistances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+    // EAC alpha modifiers, indexed by table index
+    const int eacModifiers[16][8] =
+    {
+        {-3, -6,  -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5,  -8, -13, 1, 4, 7, 12},
+        {-2, -4,  -6, -13, 1, 3, 5, 12},
+        {-3, -6,  -8, -12, 2, 5, 7, 11},
+        {-3, -7,  -9, -11, 2, 6, 8, 10},
+        {-4, -7,  -8, -11, 3, 6, 7, 10},
+        {-3, -5,  -8, -11, 2, 4, 7, 10},
+        {-2, -6,  -8, -10, 1, 5, 7,  9},
+        {-2, -5,  -8, -10, 1, 4, 7,  9},
+        {-2, -4,  -8, -10, 1, 3, 7,  9},
+        {-2, -5,  -7, -10, 1, 4, 6,  9},
+        {-3, -4,  -7, -10, 2, 3, 6,  9},
+        {-1, -2,  -3, -10, 0, 1, 2,  9},
+        {-4, -6,  -8,  -9, 3, 5, 7,  8},
+        {-3, -5,  -7,  -9, 2, 4, 6,  8}
+    };
+
+    // Read integers stored in a given byte order
+    sf::Uint32 readLittleEndian(const sf::Uint8* bytes)
+    {
+        return static_cast<sf::Uint32>(bytes[0])         | (static_cast<sf::Uint32>(bytes[1]) << 8) |
+              (static_cast<sf::Uint32>(bytes[2]) << 16) | (static_cast<sf::Uint32>(bytes[3]) << 24);
+    }
+    sf::Uint32 readBigEndian(const sf::Uint8* bytes)
+    {
+        return (static_cast<sf::Uint32>(bytes[0]) << 24) | (static_cast<sf::Uint32>(bytes[1]) << 16) |
+               (static_cast<sf::Uint32>(bytes[2]) << 8)  |  static_cast<sf::Uint32>(bytes[3]);
+    }
+
+    // Compute four-character codes as stored in DDS files
+    sf::Uint32 fourCC(char a, char b, char c, char d)
+    {
+        const sf::Uint8 bytes[4] = {static_cast<sf::Uint8>(a), static_cast<sf::Uint8>(b), static_cast<sf::Uint8>(c), static_cast<sf::Uint8>(d)};
+        return readLittleEndian(bytes);
+    }
+
+    // Clamp a color component to the [0, 255] range
+    sf::Uint8 clampComponent(int value)
+    {
+        return static_cast<sf::Uint8>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+    // Number of bytes of a 4x4 block of the given format
+    std::size_t getBlockSize(sf::priv::CompressedImage::Format format)
+    {
+        switch (format)
+        {
+            case sf::priv::CompressedImage::Bc1Rgb:
+            case sf::priv::CompressedImage::Bc1Rgba:
+            case sf::priv::CompressedImage::Etc2Rgb:
+                return 8;
+
+            default:
+                return 16;
+        }
+    }
+
+    // Parse the headers of a DDS file from its signature, the stream is left at the beginning of the pixels
+    bool readDdsHeader(sf::InputStream& stream, sf::Vector2u& size, sf::priv::CompressedImage::Format& format, std::ostream& errors)
+    {
+        sf::Uint8 header[4 + ddsHeaderSize];
+        if (stream.read(header, sizeof(header)) != static_cast<sf::Int64>(sizeof(header)) || (readLittleEndian(header + 4) != ddsHeaderSize))
+        {
+            errors << "Failed to load DDS file, invalid header" << std::endl;
+            return false;
+        }
+
+        size.y = readLittleEndian(header + 12);
+        size.x = readLittleEndian(header + 16);
+
+        const sf::Uint32 pixelFormatFlags = readLittleEndian(header + 80);
+        const sf::Uint32 pixelFormatCode  = readLittleEndian(header + 84);
+
+        if (!(pixelFormatFlags & ddsFourCCFlag))
+        {
+            errors << "Failed to load DDS file, only block-compressed pixels are supported" << std::endl;
+            return false;
+        }
+
+        if (pixelFormatCode == fourCC('D', 'X', 'T', '1'))
+        {
+            format = sf::priv::CompressedImage::Bc1Rgba;
+            return true;
+        }
+        else if (pixelFormatCode == fourCC('D', 'X', 'T', '3'))
+        {
+            format = sf::priv::CompressedImage::Bc2;
+            return true;
+        }
+        else if (pixelFormatCode == fourCC('D', 'X', 'T', '5'))
+        {
+            format = sf::priv::CompressedImage::Bc3;
+            return true;
+        }
+        else if (pixelFormatCode == fourCC('D', 'X', '1', '0'))
+        {
+            // Direct3D 10 extended header
+            sf::Uint8 extension[20];
+            if (stream.read(extension, sizeof(extension)) != static_cast<sf::Int64>(sizeof(extension)) || (readLittleEndian(extension + 4) != ddsTexture2D))
+            {
+                errors << "Failed to load DDS file, only 2D textures are supported" << std::endl;
+                return false;
+            }
+
+            switch (readLittleEndian(extension))
+            {
+                case dxgiFormatBc1:
+                case dxgiFormatBc1Srgb: format = sf::priv::CompressedImage::Bc1Rgba; return true;
+                case dxgiFormatBc2:
+                case dxgiFormatBc2Srgb: format = sf::priv::CompressedImage::Bc2;     return true;
+                case dxgiFormatBc3:
+                case dxgiFormatBc3Srgb: format = sf::priv::CompressedImage::Bc3;     return true;
+                default: break;
+            }
+        }
+
+        errors << "Failed to load DDS file, unsupported pixel format" << std::endl;
+        return false;
+    }
+
+    // Parse the headers of a KTX file from its signature, the stream is left at the beginning of the pixels
+    bool readKtxHeader(sf::InputStream& stream, sf::Vector2u& size, sf::priv::CompressedImage::Format& format, std::ostream& errors)
+    {
+        sf::Uint8 header[64];
+        if (stream.read(header, sizeof(header)) != static_cast<sf::Int64>(sizeof(header)))
+        {
+            errors << "Failed to load KTX file, invalid header" << std::endl;
+            return false;
+        }
+
+        // The file is written in the byte order of the machine that created it
+        sf::Uint32 (*read)(const sf::Uint8*) = (readLittleEndian(header + 12) == ktxEndianness) ? &readLittleEndian : &readBigEndian;
+
+        const sf::Uint32 type           = read(header + 16);
+        const sf::Uint32 internalFormat = read(header + 28);
+        const sf::Uint32 depth          = read(header + 44);
+        const sf::Uint32 faces          = read(header + 52);
+        const sf::Uint32 keyValueBytes  = read(header + 60);
+
+        size.x = read(header + 36);
+        size.y = read(header + 40);
+
+        if ((type != 0) || (depth > 1) || (faces != 1))
+        {
+            errors << "Failed to load KTX file, only compressed 2D textures are supported" << std::endl;
+            return false;
+        }
+
+        switch (internalFormat)
+        {
+            case ktxRgbDxt1:
+            case ktxSrgbDxt1:       format = sf::priv::CompressedImage::Bc1Rgb;   break;
+            case ktxRgbaDxt1:
+            case ktxSrgbAlphaDxt1:  format = sf::priv::CompressedImage::Bc1Rgba;  break;
+            case ktxRgbaDxt3:
+            case ktxSrgbAlphaDxt3:  format = sf::priv::CompressedImage::Bc2;      break;
+            case ktxRgbaDxt5:
+            case ktxSrgbAlphaDxt5:  format = sf::priv::CompressedImage::Bc3;      break;
+            case ktxEtc1Rgb8:
+            case ktxRgb8Etc2:
+            case ktxSrgb8Etc2:      format = sf::priv::CompressedImage::Etc2Rgb;  break;
+            case ktxRgba8Etc2Eac:
+            case ktxSrgb8Alpha8Eac: format = sf::priv::CompressedImage::Etc2Rgba; break;
+
+            default:
+                errors << "Failed to load KTX file, unsupported internal format 0x" << std::hex << internalFormat << std::dec << std::endl;
+                return false;
+        }
+
+        // Skip the metadata, the size of the first mipmap level follows
+        sf::Uint8 imageSize[4];
+        if ((stream.seek(stream.tell() + keyValueBytes) == -1) || (stream.read(imageSize, sizeof(imageSize)) != static_cast<sf::Int64>(sizeof(imageSize))))
+        {
+            errors << "Failed to load KTX file, unexpected end of file" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Decode the color part of a BC1, BC2 or BC3 block
+    void decodeBcColor(const sf::Uint8* block, sf::Uint8* pixels, bool bc1, bool transparent)
+    {
+        const unsigned int color0 = block[0] | (block[1] << 8);
+        const unsigned int color1 = block[2] | (block[3] << 8);
+
+        int palette[4][4];
+        const unsigned int colors[2] = {color0, color1};
+        for (int i = 0; i < 2; ++i)
+        {
+            const int r = (colors[i] >> 11) & 0x1F;
+            const int g = (colors[i] >> 5) & 0x3F;
+            const int b = colors[i] & 0x1F;
+            palette[i][0] = (r << 3) | (r >> 2);
+            palette[i][1] = (g << 2) | (g >> 4);
+            palette[i][2] = (b << 3) | (b >> 2);
+            palette[i][3] = 255;
+        }
+
+        for (int c = 0; c < 3; ++c)
+        {
+            if (!bc1 || (color0 > color1))
+            {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+            }
+            else
+            {
+                palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+                palette[3][c] = 0;
+            }
+        }
+        palette[2][3] = 255;
+        palette[3][3] = (bc1 && transparent && (color0 <= color1)) ? 0 : 255;
+
+        const sf::Uint32 indices = readLittleEndian(block + 4);
+        for (int i = 0; i < 16; ++i)
+        {
+            const int* color = palette[(indices >> (2 * i)) & 3];
+            for (int c = 0; c < 4; ++c)
+                pixels[i * 4 + c] = static_cast<sf::Uint8>(color[c]);
+        }
+    }
+
+    // Decode the explicit alpha of a BC2 block
+    void decodeBc2Alpha(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        for (int i = 0; i < 16; ++i)
+            pixels[i * 4 + 3] = static_cast<sf::Uint8>(((block[i / 2] >> (4 * (i & 1))) & 0xF) * 17);
+    }
+
+    // Decode the interpolated alpha of a BC3 block
+    void decodeBc3Alpha(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        const int alpha0 = block[0];
+        const int alpha1 = block[1];
+
+        int palette[8] = {alpha0, alpha1};
+        if (alpha0 > alpha1)
+        {
+            for (int i = 1; i < 7; ++i)
+                palette[i + 1] = ((7 - i) * alpha0 + i * alpha1 + 3) / 7;
+        }
+        else
+        {
+            for (int i = 1; i < 5; ++i)
+                palette[i + 1] = ((5 - i) * alpha0 + i * alpha1 + 2) / 5;
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        // The 48 bits of indices are read as two groups of 8 pixels
+        for (int group = 0; group < 2; ++group)
+        {
+            const sf::Uint8* bytes = block + 2 + group * 3;
+            const sf::Uint32 indices = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16);
+            for (int i = 0; i < 8; ++i)
+                pixels[(group * 8 + i) * 4 + 3] = static_cast<sf::Uint8>(palette[(indices >> (3 * i)) & 7]);
+        }
+    }
+
+    // Get the 2-bits index of a pixel of an ETC block, pixels are numbered column by column
+    unsigned int getEtcIndex(sf::Uint32 indices, int x, int y)
+    {
+        const int i = x * 4 + y;
+        return (((indices >> (16 + i)) & 1) << 1) | ((indices >> i) & 1);
+    }
+
+    // Extend a 4-bits component to 8 bits
+    int extend4(sf::Uint32 value)
+    {
+        return static_cast<int>(value & 0xF) * 17;
+    }
+
+    // Write a color of an ETC block, whose 4 paint colors are selected by the pixel indices
+    void writeEtcPaintColors(sf::Uint32 indices, const int (&paint)[4][3], sf::Uint8* pixels)
+    {
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                const int* color = paint[getEtcIndex(indices, x, y)];
+                for (int c = 0; c < 3; ++c)
+                    pixels[(y * 4 + x) * 4 + c] = clampComponent(color[c]);
+            }
+        }
+    }
+
+    // Decode an ETC1 or ETC2 RGB block
+    void decodeEtc2Color(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        const sf::Uint32 high = readBigEndian(block);
+        const sf::Uint32 low  = readBigEndian(block + 4);
+
+        for (int i = 0; i < 16; ++i)
+            pixels[i * 4 + 3] = 255;
+
+        int base[2][3];
+        if (!(high & 0x2))
+        {
+            // Individual mode: two 4-bits colors
+            for (int c = 0; c < 3; ++c)
+            {
+                base[0][c] = extend4(high >> (28 - 8 * c));
+                base[1][c] = extend4(high >> (24 - 8 * c));
+            }
+        }
+        else
+        {
+            // Differential mode: a 5-bits color and a signed 3-bits offset,
+            // ETC2 uses the out-of-range combinations to select additional modes
+            int components[3];
+            bool overflow[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                const int component = static_cast<int>((high >> (27 - 8 * c)) & 0x1F);
+                const int delta     = static_cast<int>((high >> (24 - 8 * c)) & 0x7);
+                components[c] = component + (delta >= 4 ? delta - 8 : delta);
+                base[0][c]    = component;
+                overflow[c]   = (components[c] < 0) || (components[c] > 31);
+            }
+
+            if (overflow[0])
+            {
+                // T mode
+                const int color1[3] = {extend4(((high >> 25) & 0xC) | ((high >> 24) & 0x3)), extend4(high >> 20), extend4(high >> 16)};
+                const int color2[3] = {extend4(high >> 12), extend4(high >> 8), extend4(high >> 4)};
+                const int distance  = etcDistances[((high >> 1) & 0x6) | (high & 0x1)];
+
+                int paint[4][3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    paint[0][c] = color1[c];
+                    paint[1][c] = color2[c] + distance;
+                    paint[2][c] = color2[c];
+                    paint[3][c] = color2[c] - distance;
+                }
+                writeEtcPaintColors(low, paint, pixels);
+                return;
+            }
+            else if (overflow[1])
+            {
+                // H mode
+                const sf::Uint32 packed1 = (((high >> 27) & 0xF) << 8) | ((((high >> 23) & 0xE) | ((high >> 20) & 0x1)) << 4) | (((high >> 16) & 0x8) | ((high >> 15) & 0x7));
+                const sf::Uint32 packed2 = (((high >> 11) & 0xF) << 8) | (((high >> 7) & 0xF) << 4) | ((high >> 3) & 0xF);
+                const int distance = etcDistances[(high & 0x4) | ((high << 1) & 0x2) | (packed1 >= packed2 ? 1 : 0)];
+
+                int paint[4][3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    const int color1 = extend4(packed1 >> (8 - 4 * c));
+                    const int color2 = extend4(packed2 >> (8 - 4 * c));
+                    paint[0][c] = color1 + distance;
+                    paint[1][c] = color1 - distance;
+                    paint[2][c] = color2 + distance;
+                    paint[3][c] = color2 - distance;
+                }
+                writeEtcPaintColors(low, paint, pixels);
+                return;
+            }
+            else if (overflow[2])
+            {
+                // Planar mode: three colors interpolated across the block
+                const int origin[3]     = {static_cast<int>((high >> 25) & 0x3F),
+                                           static_cast<int>(((high >> 18) & 0x40) | ((high >> 17) & 0x3F)),
+                                           static_cast<int>(((high >> 11) & 0x20) | ((high >> 8) & 0x18) | ((high >> 7) & 0x7))};
+                const int horizontal[3] = {static_cast<int>(((high >> 1) & 0x3E) | (high & 0x1)),
+                                           static_cast<int>((low >> 25) & 0x7F),
+                                           static_cast<int>((low >> 19) & 0x3F)};
+                const int vertical[3]   = {static_cast<int>((low >> 13) & 0x3F),
+                                           static_cast<int>((low >> 6) & 0x7F),
+                                           static_cast<int>(low & 0x3F)};
+
+                int o[3], h[3], v[3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    // Green is stored on 7 bits, red and blue on 6 bits
+                    const int bits = (c == 1) ? 7 : 6;
+                    o[c] = (origin[c] << (8 - bits)) | (origin[c] >> (2 * bits - 8));
+                    h[c] = (horizontal[c] << (8 - bits)) | (horizontal[c] >> (2 * bits - 8));
+                    v[c] = (vertical[c] << (8 - bits)) | (vertical[c] >> (2 * bits - 8));
+                }
+
+                for (int y = 0; y < 4; ++y)
+                {
+                    for (int x = 0; x < 4; ++x)
+                    {
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            const int value = x * (h[c] - o[c]) + y * (v[c] - o[c]) + 4 * o[c] + 2;
+                            pixels[(y * 4 + x) * 4 + c] = clampComponent(value < 0 ? 0 : value / 4);
+                        }
+                    }
+                }
+                return;
+            }
+
+            for (int c = 0; c < 3; ++c)
+            {
+                base[1][c] = (components[c] << 3) | (components[c] >> 2);
+                base[0][c] = (base[0][c] << 3) | (base[0][c] >> 2);
+            }
+        }
+
+        // Two sub-blocks, side by side or on top of each other
+        const bool flip = (high & 0x1) != 0;
+        const int tables[2] = {static_cast<int>((high >> 5) & 0x7), static_cast<int>((high >> 2) & 0x7)};
+
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                const int subBlock = flip ? (y / 2) : (x / 2);
+                const int* modifiers = etcModifiers[tables[subBlock]];
+                const unsigned int index = getEtcIndex(low, x, y);
+                const int modifier = (index & 2) ? -modifiers[index & 1] : modifiers[index & 1];
+
+                for (int c = 0; c < 3; ++c)
+                    pixels[(y * 4 + x) * 4 + c] = clampComponent(base[subBlock][c] + modifier);
+            }
+        }
+    }
+
+    // Decode the EAC alpha of an ETC2 RGBA block
+    void decodeEacAlpha(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        const int base       = block[0];
+        const int multiplier = block[1] >> 4;
+        const int* modifiers = eacModifiers[block[1] & 0xF];
+
+        // The 48 bits of indices are read as two groups of 8 pixels, column by column
+        for (int group = 0; group < 2; ++group)
+        {
+            const sf::Uint8* bytes = block + 2 + group * 3;
+            const sf::Uint32 indices = (bytes[0] << 16) | (bytes[1] << 8) | bytes[2];
+            for (int i = 0; i < 8; ++i)
+            {
+                const int pixel = group * 8 + i;
+                const int x = pixel / 4;
+                const int y = pixel % 4;
+                pixels[(y * 4 + x) * 4 + 3] = clampComponent(base + modifiers[(indices >> (21 - 3 * i)) & 7] * multiplier);
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CompressedImage::CompressedImage() :
+m_size  (0, 0),
+m_format(Bc1Rgba),
+m_data  ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedImage::isCompressed(const void* data, std::size_t size)
+{
+    if (!data)
+        return false;
+
+    return ((size >= sizeof(ddsSignature)) && (std::memcmp(data, ddsSignature, sizeof(ddsSignature)) == 0)) ||
+           ((size >= sizeof(ktxSignature)) && (std::memcmp(data, ktxSignature, sizeof(ktxSignature)) == 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedImage::isCompressed(InputStream& stream)
+{
+    const Int64 position = stream.tell();
+
+    Uint8 signature[sizeof(ktxSignature)];
+    const Int64 read = stream.read(signature, sizeof(signature));
+    stream.seek(position);
+
+    return (read > 0) && isCompressed(signature, static_cast<std::size_t>(read));
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedImage::loadFromStream(InputStream& stream, std::ostream& errors)
+{
+    // Make sure that the stream's reading position is at the beginning
+    stream.seek(0);
+
+    Uint8 signature[sizeof(ktxSignature)];
+    const Int64 read = stream.read(signature, sizeof(signature));
+    if (read <= 0)
+    {
+        errors << "Failed to load compressed image, empty stream" << std::endl;
+        return false;
+    }
+
+    // Parse the container headers
+    Vector2u size;
+    Format format = Bc1Rgba;
+    bool headerRead = false;
+
+    if ((read >= static_cast<Int64>(sizeof(ddsSignature))) && (std::memcmp(signature, ddsSignature, sizeof(ddsSignature)) == 0))
+    {
+        headerRead = (stream.seek(0) == 0) && readDdsHeader(stream, size, format, errors);
+    }
+    else if ((read == static_cast<Int64>(sizeof(ktxSignature))) && (std::memcmp(signature, ktxSignature, sizeof(ktxSignature)) == 0))
+    {
+        headerRead = (stream.seek(0) == 0) && readKtxHeader(stream, size, format, errors);
+    }
+    else
+    {
+        errors << "Failed to load compressed image, only DDS and KTX files are supported" << std::endl;
+        return false;
+    }
+
+    if (!headerRead)
+        return false;
+
+    if ((size.x == 0) || (size.y == 0))
+    {
+        errors << "Failed to load compressed image, invalid size (" << size.x << "x" << size.y << ")" << std::endl;
+        return false;
+    }
+
+    // Make sure the stream actually contains the blocks before allocating them
+    const Int64 blockCount = static_cast<Int64>((size.x + 3) / 4) * static_cast<Int64>((size.y + 3) / 4);
+    const Int64 dataSize   = blockCount * static_cast<Int64>(getBlockSize(format));
+    const Int64 position   = stream.tell();
+    if ((position < 0) || (dataSize > stream.getSize() - position))
+    {
+        errors << "Failed to load compressed image, unexpected end of file" << std::endl;
+        return false;
+    }
+
+    std::vector<Uint8> data(static_cast<std::size_t>(dataSize));
+    if (stream.read(&data[0], dataSize) != dataSize)
+    {
+        errors << "Failed to load compressed image, unexpected end of file" << std::endl;
+        return false;
+    }
+
+    m_size   = size;
+    m_format = format;
+    m_data.swap(data);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& CompressedImage::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedImage::Format CompressedImage::getFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* CompressedImage::getData() const
+{
+    return m_data.empty() ? NULL : &m_data[0];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedImage::getDataSize() const
+{
+    return m_data.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedImage::decompress(Image& image) const
+{
+    if (m_data.empty())
+    {
+        image.create(0, 0);
+        return;
+    }
+
+    const std::size_t blockSize = getBlockSize(m_format);
+    const unsigned int blocksX  = (m_size.x + 3) / 4;
+    const unsigned int blocksY  = (m_size.y + 3) / 4;
+
+    std::vector<Uint8> pixels(static_cast<std::size_t>(m_size.x) * m_size.y * 4);
+    Uint8 block[16 * 4];
+
+    const Uint8* source = &m_data[0];
+    for (unsigned int blockY = 0; blockY < blocksY; ++blockY)
+    {
+        for (unsigned int blockX = 0; blockX < blocksX; ++blockX, source += blockSize)
+        {
+            switch (m_format)
+            {
+                case Bc1Rgb:
+                    decodeBcColor(source, block, true, false);
+                    break;
+
+                case Bc1Rgba:
+                    decodeBcColor(source, block, true, true);
+                    break;
+
+                case Bc2:
+                    decodeBcColor(source + 8, block, false, false);
+                    decodeBc2Alpha(source, block);
+                    break;
+
+                case Bc3:
+                    decodeBcColor(source + 8, block, false, false);
+                    decodeBc3Alpha(source, block);
+                    break;
+
+                case Etc2Rgb:
+                    decodeEtc2Color(source, block);
+                    break;
+
+                case Etc2Rgba:
+                    decodeEtc2Color(source + 8, block);
+                    decodeEacAlpha(source, block);
+                    break;
+            }
+
+            // Copy the part of the block that lies inside the image
+            const unsigned int x = blockX * 4;
+            const unsigned int y = blockY * 4;
+            const unsigned int width  = std::min(4u, m_size.x - x);
+            const unsigned int height = std::min(4u, m_size.y - y);
+            for (unsigned int row = 0; row < height; ++row)
+                std::memcpy(&pixels[(static_cast<std::size_t>(y + row) * m_size.x + x) * 4], block + row * 16, width * 4);
+        }
+    }
+
+    image.create(m_size.x, m_size.y, pixels);
+}
+
+} // namespace priv
+
+} // namespace sf
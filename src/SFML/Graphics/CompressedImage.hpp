@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDIMAGE_HPP
+#define SFML_COMPRESSEDIMAGE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Block-compressed pixels read from a DDS or KTX file
+///
+////////////////////////////////////////////////////////////
+class CompressedImage
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block compression formats
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Bc1Rgb,  //!< BC1 (DXT1) without alpha
+        Bc1Rgba, //!< BC1 (DXT1) with 1-bit alpha
+        Bc2,     //!< BC2 (DXT3), explicit 4-bit alpha
+        Bc3,     //!< BC3 (DXT5), interpolated alpha
+        Etc2Rgb, //!< ETC2 RGB, also decodes ETC1
+        Etc2Rgba //!< ETC2 RGB with EAC alpha
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedImage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a file starts with a DDS or KTX signature
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data, in bytes
+    ///
+    /// \return True if the data is a supported container
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCompressed(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a stream starts with a DDS or KTX signature
+    ///
+    /// The reading position of the stream is restored.
+    ///
+    /// \param stream Source stream to check
+    ///
+    /// \return True if the stream is a supported container
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCompressed(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the first mipmap level of a DDS or KTX file
+    ///
+    /// \param stream Source stream to read from
+    /// \param errors Stream that receives the error messages
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream, std::ostream& errors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the image, in pixels
+    ///
+    /// \return Size of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the block compression format of the image
+    ///
+    /// \return Format of the blocks
+    ///
+    ////////////////////////////////////////////////////////////
+    Format getFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the compressed blocks
+    ///
+    /// Blocks cover 4x4 pixels and are stored row by row,
+    /// starting with the top of the image.
+    ///
+    /// \return Pointer to the blocks
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the compressed blocks, in bytes
+    ///
+    /// \return Size of the data returned by getData
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDataSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the blocks to 32-bits RGBA pixels
+    ///
+    /// This is the fallback used when the graphics driver
+    /// can't sample the compressed format directly.
+    ///
+    /// \param image Image to fill with the decoded pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void decompress(Image& image) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u           m_size;   //!< Size of the image, in pixels
+    Format             m_format; //!< Block compression format
+    std::vector<Uint8> m_data;   //!< Compressed blocks of the first mipmap level
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDIMAGE_HPP
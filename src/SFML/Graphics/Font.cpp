@@ -27,17 +27,25 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/HashTable.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/Graphics/ProgrammableRenderer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/ShelfPacker.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
@@ -45,6 +53,18 @@
 
 namespace
 {
+    sf::Mutex generationMutex;
+
+    // Thread-safe generator of the layout generations of the pages
+    sf::Uint64 getUniqueGeneration()
+    {
+        sf::Lock lock(generationMutex);
+
+        static sf::Uint64 generation = 1;
+
+        return generation++;
+    }
+
     // FreeType callbacks that operate on a sf::InputStream
     unsigned long read(FT_Stream rec, unsigned long offset, unsigned char* buffer, unsigned long count)
     {
@@ -72,11 +92,172 @@ namespace
         return output;
     }
 
-    // Combine outline thickness, boldness and font glyph index into a single 64-bit key
-    sf::Uint64 combine(float outlineThickness, bool bold, sf::Uint32 index)
+    // Vertex shader used to draw distance field glyphs
+    const char* distanceFieldVertexShader =
+        "void main()"
+        "{"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;"
+        "    gl_FrontColor = gl_Color;"
+        "}";
+
+    // Fragment shader used to draw distance field glyphs, the distances
+    // are stored in the alpha channel with the outline at 0.5
+    const char* distanceFieldFragmentShader =
+        "uniform sampler2D glyphs;"
+        "uniform vec4 outlineColor;"
+        "uniform float outlineThickness;"
+        "uniform float boldness;"
+        ""
+        "void main()"
+        "{"
+        "    float distance = texture2D(glyphs, gl_TexCoord[0].xy).a;"
+        "    float smoothing = 0.7 * fwidth(distance);"
+        "    float edge = 0.5 - boldness;"
+        "    float fill = smoothstep(edge - smoothing, edge + smoothing, distance);"
+        "    float outline = smoothstep(edge - outlineThickness - smoothing, edge - outlineThickness + smoothing, distance);"
+        "    vec4 color = (outlineThickness > 0.0) ? mix(outlineColor, gl_Color, fill) : gl_Color;"
+        "    gl_FragColor = vec4(color.rgb, color.a * outline);"
+        "}";
+
+    // Same shaders for the Programmable backend of sf::RenderTarget, which
+    // has no fixed-function built-ins; the version directive is prepended
+    const char* programmableDistanceFieldVertexShader =
+        "in vec2 sf_position;"
+        "in vec4 sf_color;"
+        "in vec2 sf_texCoords;"
+        "uniform mat4 sf_transform;"
+        "uniform vec4 sf_texCoordsTransform;"
+        "out vec4 color;"
+        "out vec2 texCoords;"
+        ""
+        "void main()"
+        "{"
+        "    gl_Position = sf_transform * vec4(sf_position, 0.0, 1.0);"
+        "    texCoords = sf_texCoords * sf_texCoordsTransform.xy + sf_texCoordsTransform.zw;"
+        "    color = sf_color;"
+        "}";
+
+    const char* programmableDistanceFieldFragmentShader =
+        "in vec4 color;"
+        "in vec2 texCoords;"
+        "uniform sampler2D glyphs;"
+        "uniform vec4 outlineColor;"
+        "uniform float outlineThickness;"
+        "uniform float boldness;"
+        "out vec4 sf_fragColor;"
+        ""
+        "void main()"
+        "{"
+        "    float distance = texture(glyphs, texCoords).a;"
+        "    float smoothing = 0.7 * fwidth(distance);"
+        "    float edge = 0.5 - boldness;"
+        "    float fill = smoothstep(edge - smoothing, edge + smoothing, distance);"
+        "    float outline = smoothstep(edge - outlineThickness - smoothing, edge - outlineThickness + smoothing, distance);"
+        "    vec4 fillColor = (outlineThickness > 0.0) ? mix(outlineColor, color, fill) : color;"
+        "    sf_fragColor = vec4(fillColor.rgb, fillColor.a * outline);"
+        "}";
+
+    // Combine outline thickness, boldness and glyph index into a single 64-bit key
+    sf::Uint64 combine(float outlineThickness, bool bold, sf::Uint32 glyphIndex)
     {
-        return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | index;
+        return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | glyphIndex;
+    }
+
+    // Size that the textures of a page grow up to, before a new texture gets created
+    const unsigned int atlasSize = 1024;
+
+    // Maximum number of textures of a page, least recently used glyphs get evicted beyond that
+    const std::size_t maxAtlasCount = 8;
+
+    // Row index of glyphs that don't have pixels in a texture
+    const std::size_t noRow = static_cast<std::size_t>(-1);
+
+    // Padding left around the pixels of the glyphs, so that filtering doesn't pollute them with pixels from neighbors
+    const unsigned int padding = 2;
+
+    // Character size at which the glyphs are rasterized in distance field mode
+    const unsigned int distanceFieldSize = 48;
+
+    // Distance to the outline, in pixels, beyond which the distance fields are clamped
+    const unsigned int distanceFieldSpread = 6;
+
+    // Replace the coverage stored in the alpha channel of a glyph's pixels by the signed
+    // distance to the outline of the glyph, mapped from [spread, -spread] to [0, 255]
+    void computeDistanceField(std::vector<sf::Uint8>& pixels, int width, int height, int spread)
+    {
+        std::vector<bool> inside(width * height);
+        for (std::size_t i = 0; i < inside.size(); ++i)
+            inside[i] = pixels[i * 4 + 3] >= 128;
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                bool isInside = inside[x + y * width];
+
+                // Find the nearest pixel on the other side of the outline, within the spread
+                int nearest = (spread + 1) * (spread + 1);
+                for (int dy = -spread; dy <= spread; ++dy)
+                {
+                    for (int dx = -spread; dx <= spread; ++dx)
+                    {
+                        int otherX = x + dx;
+                        int otherY = y + dy;
+                        bool isOtherInside = (otherX >= 0) && (otherX < width) && (otherY >= 0) && (otherY < height) && inside[otherX + otherY * width];
+
+                        if (isOtherInside != isInside)
+                            nearest = std::min(nearest, dx * dx + dy * dy);
+                    }
+                }
+
+                // The outline lies halfway between the centers of the two pixels
+                float distance = std::sqrt(static_cast<float>(nearest)) - 0.5f;
+                if (isInside)
+                    distance = -distance;
+
+                float value = std::min(std::max(0.5f - distance / static_cast<float>(2 * spread), 0.f), 1.f);
+                pixels[(x + y * width) * 4 + 3] = static_cast<sf::Uint8>(value * 255.f + 0.5f);
+            }
+        }
     }
+
+    // Lock the mutex protecting the FreeType objects of a font, if it has any
+    class FaceLock : sf::NonCopyable
+    {
+    public:
+
+        explicit FaceLock(sf::Mutex* mutex) :
+        m_mutex(mutex)
+        {
+            if (m_mutex)
+                m_mutex->lock();
+        }
+
+        ~FaceLock()
+        {
+            if (m_mutex)
+                m_mutex->unlock();
+        }
+
+    private:
+
+        sf::Mutex* m_mutex;
+    };
+
+    // Sort rasterized glyphs by character size, then from the tallest to the smallest,
+    // so that glyphs stored together are likely to end up next to each other in the same row
+    template <typename T>
+    struct TallestFirst
+    {
+        bool operator ()(const T* left, const T* right) const
+        {
+            if (left->characterSize != right->characterSize)
+                return left->characterSize < right->characterSize;
+
+            return left->glyph.textureRect.height > right->glyph.textureRect.height;
+        }
+    };
 }
 
 
@@ -84,13 +265,21 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_stroker  (NULL),
-m_refCount (NULL),
-m_isSmooth (true),
-m_info     ()
+m_library        (NULL),
+m_face           (NULL),
+m_streamRec      (NULL),
+m_stroker        (NULL),
+m_refCount       (NULL),
+m_faceMutex      (NULL),
+m_isSmooth       (true),
+m_isDistanceField(false),
+m_info           (),
+m_pages          (),
+m_glyphIndices   (new GlyphIndexTable),
+m_loadingThread  (&Font::rasterizePrefetchedGlyphs, this),
+m_isLoading      (false),
+m_distanceFieldShader(NULL),
+m_programmableDistanceFieldShader(NULL)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -100,15 +289,22 @@ m_info     ()
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_stroker    (copy.m_stroker),
-m_refCount   (copy.m_refCount),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer),
-m_isSmooth   (copy.m_isSmooth)
+m_library        (copy.m_library),
+m_face           (copy.m_face),
+m_streamRec      (copy.m_streamRec),
+m_stroker        (copy.m_stroker),
+m_refCount       (copy.m_refCount),
+m_faceMutex      (copy.m_faceMutex),
+m_isSmooth       (copy.m_isSmooth),
+m_isDistanceField(copy.m_isDistanceField),
+m_info           (copy.m_info),
+m_pages          (copy.m_pages),
+m_glyphIndices   (new GlyphIndexTable(*copy.m_glyphIndices)),
+m_pixelBuffer    (copy.m_pixelBuffer),
+m_loadingThread  (&Font::rasterizePrefetchedGlyphs, this),
+m_isLoading      (false),
+m_distanceFieldShader(NULL),
+m_programmableDistanceFieldShader(NULL)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -127,6 +323,10 @@ Font::~Font()
 {
     cleanup();
 
+    delete m_glyphIndices;
+    delete m_distanceFieldShader;
+    delete m_programmableDistanceFieldShader;
+
     #ifdef SFML_SYSTEM_ANDROID
 
     if (m_stream)
@@ -144,6 +344,7 @@ bool Font::loadFromFile(const std::string& filename)
     // Cleanup the previous resources
     cleanup();
     m_refCount = new int(1);
+    m_faceMutex = new Mutex;
 
     // Initialize FreeType
     // Note: we initialize FreeType for every font instance in order to avoid having a single
@@ -209,6 +410,7 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
     // Cleanup the previous resources
     cleanup();
     m_refCount = new int(1);
+    m_faceMutex = new Mutex;
 
     // Initialize FreeType
     // Note: we initialize FreeType for every font instance in order to avoid having a single
@@ -264,6 +466,7 @@ bool Font::loadFromStream(InputStream& stream)
     // Cleanup the previous resources
     cleanup();
     m_refCount = new int(1);
+    m_faceMutex = new Mutex;
 
     // Initialize FreeType
     // Note: we initialize FreeType for every font instance in order to avoid having a single
@@ -347,30 +550,51 @@ const Font::Info& Font::getInfo() const
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    Page& page = loadPage(characterSize);
 
-    // Build the key by combining the glyph index (based on code point), bold flag, and outline thickness
-    Uint64 key = combine(outlineThickness, bold, FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint));
+    // Distance field glyphs are the same for all styles, sf::Text applies them in a shader
+    if (m_isDistanceField)
+    {
+        bold = false;
+        outlineThickness = 0;
+    }
+
+    // Build the key by combining the glyph index, bold flag, and outline thickness;
+    // characters that share a glyph (like all the missing ones) share its cache entry
+    Uint32 glyphIndex = getGlyphIndex(codePoint);
+    Uint64 key = combine(outlineThickness, bold, glyphIndex);
 
     // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+    std::size_t* index = page.glyphTable->find(key);
+    if (!index)
     {
-        // Found: just return it
-        return it->second;
+        // The glyph may have been rasterized in the background
+        commitPrefetchedGlyphs();
+        index = page.glyphTable->find(key);
     }
-    else
+
+    // Not found: we have to load it
+    std::size_t newIndex = 0;
+    if (!index)
     {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        newIndex = insertGlyph(page, key, loadGlyph(glyphIndex, characterSize, bold, outlineThickness));
+        index = &newIndex;
     }
+
+    // Mark the row containing the glyph as recently used
+    const CachedGlyph& glyph = page.glyphs[*index];
+    if (glyph.row != noRow)
+        page.atlases[glyph.glyph.textureIndex].rows[glyph.row].lastUse = ++page.useCounter;
+
+    return glyph.glyph;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Font::hasGlyph(Uint32 codePoint) const
 {
+    FaceLock lock(m_faceMutex);
+
     return FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint) != 0;
 }
 
@@ -384,15 +608,33 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize,
 
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && setCurrentSize(characterSize))
+    if (!face)
+        return 0.f;
+
+    // Search the kerning into the cache of the character size, without creating a page for it
+    Uint64 key = (static_cast<Uint64>(first) << 32) | (static_cast<Uint64>(bold) << 31) | second;
+
+    PageTable::const_iterator cachedPage = m_pages.find(characterSize);
+    if (cachedPage != m_pages.end())
     {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        const float* cached = cachedPage->second.kernings->find(key);
+        if (cached)
+            return *cached;
+    }
 
-        // Retrieve position compensation deltas generated by FT_LOAD_FORCE_AUTOHINT flag
+    // Convert the characters to indices
+    FT_UInt index1 = getGlyphIndex(first);
+    FT_UInt index2 = getGlyphIndex(second);
+
+    FaceLock lock(m_faceMutex);
+
+    if (setCurrentSize(characterSize))
+    {
+        // Retrieve position compensation deltas generated by FT_LOAD_FORCE_AUTOHINT flag;
+        // this loads the page of the character size, where the kerning is then cached
         float firstRsbDelta = getGlyph(first, characterSize, bold).rsbDelta;
         float secondLsbDelta = getGlyph(second, characterSize, bold).lsbDelta;
+        KerningTable* kernings = m_pages[characterSize].kernings;
 
         // Get the kerning vector if present
         FT_Vector kerning;
@@ -402,11 +644,11 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize,
 
         // X advance is already in pixels for bitmap fonts
         if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+            return kernings->insert(key, static_cast<float>(kerning.x));
 
         // Combine kerning with compensation deltas and return the X advance
         // Flooring is required as we use FT_KERNING_UNFITTED flag which is not quantized in 64 based grid
-        return std::floor((secondLsbDelta - firstRsbDelta + static_cast<float>(kerning.x) + 32) / static_cast<float>(1 << 6));
+        return kernings->insert(key, std::floor((secondLsbDelta - firstRsbDelta + static_cast<float>(kerning.x) + 32) / static_cast<float>(1 << 6)));
     }
     else
     {
@@ -416,9 +658,173 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize,
 }
 
 
+////////////////////////////////////////////////////////////
+void Font::prefetch(const String& string, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    if (!m_face)
+        return;
+
+    if (m_isDistanceField)
+    {
+        bold = false;
+        outlineThickness = 0;
+    }
+
+    // Don't create the page here, it gets its textures when the glyphs are committed
+    PageTable::const_iterator page = m_pages.find(characterSize);
+    const GlyphTable* glyphs = (page != m_pages.end()) ? page->second.glyphTable : NULL;
+
+    Lock lock(m_loadingMutex);
+
+    // Queue the glyphs which are neither loaded nor already being loaded
+    for (String::ConstIterator it = string.begin(); it != string.end(); ++it)
+    {
+        Uint32 glyphIndex = getGlyphIndex(*it);
+        Uint64 key = combine(outlineThickness, bold, glyphIndex);
+        if (glyphs && glyphs->find(key))
+            continue;
+
+        if (!m_pendingGlyphs.insert(std::make_pair(characterSize, key)).second)
+            continue;
+
+        GlyphRequest request;
+        request.glyphIndex = glyphIndex;
+        request.characterSize = characterSize;
+        request.bold = bold;
+        request.outlineThickness = outlineThickness;
+        m_loadingQueue.push_back(request);
+    }
+
+    // Start the loading thread if it is not already running
+    if (!m_isLoading && !m_loadingQueue.empty())
+    {
+        m_isLoading = true;
+        m_loadingThread.launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::commitPrefetchedGlyphs() const
+{
+    // Take the glyphs rasterized so far
+    std::vector<RasterizedGlyph> loadedGlyphs;
+    {
+        Lock lock(m_loadingMutex);
+
+        if (m_loadedGlyphs.empty())
+            return;
+
+        loadedGlyphs.swap(m_loadedGlyphs);
+        for (std::vector<RasterizedGlyph>::const_iterator it = loadedGlyphs.begin(); it != loadedGlyphs.end(); ++it)
+            m_pendingGlyphs.erase(std::make_pair(it->characterSize, it->key));
+    }
+
+    std::vector<const RasterizedGlyph*> sortedGlyphs;
+    sortedGlyphs.reserve(loadedGlyphs.size());
+    for (std::vector<RasterizedGlyph>::const_iterator it = loadedGlyphs.begin(); it != loadedGlyphs.end(); ++it)
+        sortedGlyphs.push_back(&*it);
+
+    std::stable_sort(sortedGlyphs.begin(), sortedGlyphs.end(), TallestFirst<RasterizedGlyph>());
+
+    // Find a place for each glyph in the textures, and remember
+    // where to write their pixels (in the same order, since a row
+    // may be evicted and reused by a later glyph)
+    std::vector<Texture*> textures;
+    std::vector<IntRect> rects;
+    std::vector<const Uint8*> pixels;
+    for (std::vector<const RasterizedGlyph*>::const_iterator it = sortedGlyphs.begin(); it != sortedGlyphs.end(); ++it)
+    {
+        const RasterizedGlyph& loadedGlyph = **it;
+        Page& page = loadPage(loadedGlyph.characterSize);
+
+        // Skip the glyphs that were loaded by getGlyph in the meantime
+        if (page.glyphTable->find(loadedGlyph.key))
+            continue;
+
+        CachedGlyph glyph;
+        glyph.glyph = loadedGlyph.glyph;
+        glyph.row = noRow;
+
+        if (!loadedGlyph.pixels.empty())
+        {
+            IntRect rect = placeGlyph(page, glyph);
+
+            if (glyph.row != noRow)
+            {
+                textures.push_back(&page.atlases[glyph.glyph.textureIndex].texture);
+                rects.push_back(rect);
+                pixels.push_back(&loadedGlyph.pixels[0]);
+
+                // Mark the row as recently used, so that the next glyphs of the batch don't evict it
+                page.atlases[glyph.glyph.textureIndex].rows[glyph.row].lastUse = ++page.useCounter;
+            }
+        }
+
+        insertGlyph(page, loadedGlyph.key, glyph);
+    }
+
+    // Upload the glyphs which are next to each other in the same row of a texture
+    // all at once, their rectangles don't overlap any other glyph so the unused
+    // space below the shortest glyphs can be overwritten
+    std::size_t begin = 0;
+    while (begin < rects.size())
+    {
+        unsigned int stripHeight = rects[begin].height;
+        std::size_t end = begin + 1;
+        while ((end < rects.size()) &&
+               (textures[end] == textures[begin]) &&
+               (rects[end].top == rects[begin].top) &&
+               (rects[end].left == rects[end - 1].left + rects[end - 1].width))
+        {
+            stripHeight = std::max(stripHeight, static_cast<unsigned int>(rects[end].height));
+            ++end;
+        }
+
+        unsigned int stripWidth = rects[end - 1].left + rects[end - 1].width - rects[begin].left;
+
+        // Fill the strip with transparent white pixels, then copy the glyphs into it
+        m_pixelBuffer.resize(stripWidth * stripHeight * 4);
+
+        Uint8* current = &m_pixelBuffer[0];
+        Uint8* stripEnd = current + stripWidth * stripHeight * 4;
+
+        while (current != stripEnd)
+        {
+            (*current++) = 255;
+            (*current++) = 255;
+            (*current++) = 255;
+            (*current++) = 0;
+        }
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            std::size_t rowSize = static_cast<std::size_t>(rects[i].width) * 4;
+            for (int y = 0; y < rects[i].height; ++y)
+                std::memcpy(&m_pixelBuffer[((rects[i].left - rects[begin].left) + y * stripWidth) * 4], pixels[i] + y * rowSize, rowSize);
+        }
+
+        textures[begin]->update(&m_pixelBuffer[0], stripWidth, stripHeight, rects[begin].left, rects[begin].top);
+
+        begin = end;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isPrefetching() const
+{
+    Lock lock(m_loadingMutex);
+
+    return m_isLoading;
+}
+
+
 ////////////////////////////////////////////////////////////
 float Font::getLineSpacing(unsigned int characterSize) const
 {
+    FaceLock lock(m_faceMutex);
+
     FT_Face face = static_cast<FT_Face>(m_face);
 
     if (face && setCurrentSize(characterSize))
@@ -435,6 +841,8 @@ float Font::getLineSpacing(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 float Font::getUnderlinePosition(unsigned int characterSize) const
 {
+    FaceLock lock(m_faceMutex);
+
     FT_Face face = static_cast<FT_Face>(m_face);
 
     if (face && setCurrentSize(characterSize))
@@ -455,6 +863,8 @@ float Font::getUnderlinePosition(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 float Font::getUnderlineThickness(unsigned int characterSize) const
 {
+    FaceLock lock(m_faceMutex);
+
     FT_Face face = static_cast<FT_Face>(m_face);
 
     if (face && setCurrentSize(characterSize))
@@ -475,9 +885,24 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    return loadPage(characterSize).atlases.front().texture;
 }
 
+
+////////////////////////////////////////////////////////////
+const Texture& Font::getTexture(unsigned int characterSize, unsigned int index) const
+{
+    return loadPage(characterSize).atlases[index].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getTextureCount(unsigned int characterSize) const
+{
+    return static_cast<unsigned int>(loadPage(characterSize).atlases.size());
+}
+
+
 ////////////////////////////////////////////////////////////
 void Font::setSmooth(bool smooth)
 {
@@ -487,7 +912,8 @@ void Font::setSmooth(bool smooth)
 
         for (sf::Font::PageTable::iterator page = m_pages.begin(); page != m_pages.end(); ++page)
         {
-            page->second.texture.setSmooth(m_isSmooth);
+            for (std::deque<Atlas>::iterator atlas = page->second.atlases.begin(); atlas != page->second.atlases.end(); ++atlas)
+                atlas->texture.setSmooth(m_isSmooth || m_isDistanceField);
         }
     }
 }
@@ -499,20 +925,63 @@ bool Font::isSmooth() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Font::setDistanceFieldEnabled(bool enabled)
+{
+    if (enabled != m_isDistanceField)
+    {
+        // The glyphs loaded so far have the wrong kind of pixels
+        cancelPrefetch();
+        m_pages.clear();
+
+        m_isDistanceField = enabled;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isDistanceFieldEnabled() const
+{
+    return m_isDistanceField;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getDistanceFieldSize() const
+{
+    return distanceFieldSize;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getDistanceFieldSpread() const
+{
+    return static_cast<float>(distanceFieldSpread);
+}
+
+
 ////////////////////////////////////////////////////////////
 Font& Font::operator =(const Font& right)
 {
     Font temp(right);
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_stroker,     temp.m_stroker);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
-    std::swap(m_isSmooth,    temp.m_isSmooth);
+    // The loading thread uses the current font face
+    cancelPrefetch();
+
+    std::swap(m_library,         temp.m_library);
+    std::swap(m_face,            temp.m_face);
+    std::swap(m_streamRec,       temp.m_streamRec);
+    std::swap(m_stroker,         temp.m_stroker);
+    std::swap(m_refCount,        temp.m_refCount);
+    std::swap(m_faceMutex,       temp.m_faceMutex);
+    std::swap(m_info,            temp.m_info);
+    std::swap(m_pages,           temp.m_pages);
+    std::swap(m_glyphIndices,    temp.m_glyphIndices);
+    std::swap(m_pixelBuffer,     temp.m_pixelBuffer);
+    std::swap(m_isSmooth,        temp.m_isSmooth);
+    std::swap(m_isDistanceField, temp.m_isDistanceField);
+    std::swap(m_distanceFieldShader, temp.m_distanceFieldShader);
+    std::swap(m_programmableDistanceFieldShader, temp.m_programmableDistanceFieldShader);
 
     #ifdef SFML_SYSTEM_ANDROID
         std::swap(m_stream, temp.m_stream);
@@ -525,6 +994,9 @@ Font& Font::operator =(const Font& right)
 ////////////////////////////////////////////////////////////
 void Font::cleanup()
 {
+    // Stop using the FreeType pointers in the loading thread
+    cancelPrefetch();
+
     // Check if we must destroy the FreeType pointers
     if (m_refCount)
     {
@@ -552,6 +1024,9 @@ void Font::cleanup()
             // Close the library
             if (m_library)
                 FT_Done_FreeType(static_cast<FT_Library>(m_library));
+
+            // Destroy the mutex protecting them
+            delete m_faceMutex;
         }
     }
 
@@ -561,37 +1036,141 @@ void Font::cleanup()
     m_stroker   = NULL;
     m_streamRec = NULL;
     m_refCount  = NULL;
+    m_faceMutex = NULL;
     m_pages.clear();
+    m_glyphIndices->clear();
     std::vector<Uint8>().swap(m_pixelBuffer);
 }
 
 
 ////////////////////////////////////////////////////////////
-Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+void Font::cancelPrefetch() const
+{
+    {
+        Lock lock(m_loadingMutex);
+        m_loadingQueue.clear();
+    }
+
+    // Wait until the glyph being rasterized, if any, is done
+    m_loadingThread.wait();
+
+    m_loadedGlyphs.clear();
+    m_pendingGlyphs.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::rasterizePrefetchedGlyphs()
+{
+    for (;;)
+    {
+        // Take the next glyph to load, or stop if there are no more
+        GlyphRequest request;
+        {
+            Lock lock(m_loadingMutex);
+
+            if (m_loadingQueue.empty())
+            {
+                m_isLoading = false;
+                return;
+            }
+
+            request = m_loadingQueue.front();
+            m_loadingQueue.pop_front();
+        }
+
+        // Rasterize it
+        RasterizedGlyph glyph;
+        glyph.characterSize = request.characterSize;
+        glyph.key = combine(request.outlineThickness, request.bold, request.glyphIndex);
+        {
+            FaceLock lock(m_faceMutex);
+            rasterizeGlyph(request.glyphIndex, request.characterSize, request.bold, request.outlineThickness, glyph.glyph, glyph.pixels);
+        }
+
+        // Hand it over to commitPrefetchedGlyphs
+        Lock lock(m_loadingMutex);
+        m_loadedGlyphs.push_back(RasterizedGlyph());
+        m_loadedGlyphs.back().characterSize = glyph.characterSize;
+        m_loadedGlyphs.back().key = glyph.key;
+        m_loadedGlyphs.back().glyph = glyph.glyph;
+        m_loadedGlyphs.back().pixels.swap(glyph.pixels);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Font::getGlyphIndex(Uint32 codePoint) const
+{
+    const Uint32* cached = m_glyphIndices->find(codePoint);
+    if (cached)
+        return *cached;
+
+    if (!m_face)
+        return 0;
+
+    FaceLock lock(m_faceMutex);
+
+    return m_glyphIndices->insert(codePoint, FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint));
+}
+
+
+////////////////////////////////////////////////////////////
+Font::CachedGlyph Font::loadGlyph(Uint32 glyphIndex, unsigned int characterSize, bool bold, float outlineThickness) const
 {
     // The glyph to return
-    Glyph glyph;
+    CachedGlyph result;
+    result.row = noRow;
+
+    // Compute the metrics and the pixels of the glyph
+    {
+        FaceLock lock(m_faceMutex);
+        rasterizeGlyph(glyphIndex, characterSize, bold, outlineThickness, result.glyph, m_pixelBuffer);
+    }
+
+    if (!m_pixelBuffer.empty())
+    {
+        // Get the glyphs page corresponding to the character size
+        Page& page = loadPage(characterSize);
+
+        // Find a good position for the new glyph into the textures
+        IntRect rect = placeGlyph(page, result);
+
+        // Write the pixels to the texture
+        if (result.row != noRow)
+            page.atlases[result.glyph.textureIndex].texture.update(&m_pixelBuffer[0], rect.width, rect.height, rect.left, rect.top);
+    }
+
+    // Done :)
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::rasterizeGlyph(Uint32 glyphIndex, unsigned int characterSize, bool bold, float outlineThickness, Glyph& glyph, std::vector<Uint8>& pixelBuffer) const
+{
+    pixelBuffer.clear();
 
     // First, transform our ugly void* to a FT_Face
     FT_Face face = static_cast<FT_Face>(m_face);
     if (!face)
-        return glyph;
+        return;
 
     // Set the character size
     if (!setCurrentSize(characterSize))
-        return glyph;
+        return;
 
-    // Load the glyph corresponding to the code point
+    // Load the glyph
     FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
     if (outlineThickness != 0)
         flags |= FT_LOAD_NO_BITMAP;
-    if (FT_Load_Char(face, codePoint, flags) != 0)
-        return glyph;
+    if (FT_Load_Glyph(face, glyphIndex, flags) != 0)
+        return;
 
     // Retrieve the glyph
     FT_Glyph glyphDesc;
     if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
+        return;
 
     // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
     FT_Pos weight = 1 << 6;
@@ -640,25 +1219,15 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
 
     if ((width > 0) && (height > 0))
     {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 2;
-
-        width += 2 * padding;
-        height += 2 * padding;
-
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+        // Leave a small padding around characters, it is filled with transparent pixels
+        // (and with the outer part of the distance field in distance field mode)
+        const unsigned int glyphPadding = padding + (m_isDistanceField ? distanceFieldSpread : 0);
 
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width, height);
+        glyph.textureRect.width = width;
+        glyph.textureRect.height = height;
 
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
+        width += 2 * glyphPadding;
+        height += 2 * glyphPadding;
 
         // Compute the glyph's bounding box
         glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
@@ -667,132 +1236,231 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
         glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
 
         // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(width * height * 4);
+        pixelBuffer.resize(width * height * 4);
 
-        Uint8* current = &m_pixelBuffer[0];
-        Uint8* end = current + width * height * 4;
-
-        while (current != end)
-        {
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 0;
-        }
+        priv::ImageKernels::fill(&pixelBuffer[0], width * height, Color(255, 255, 255, 0));
 
         // Extract the glyph's pixels from the bitmap
         const Uint8* pixels = bitmap.buffer;
         if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
         {
             // Pixels are 1 bit monochrome values
-            for (unsigned int y = padding; y < height - padding; ++y)
+            for (unsigned int y = glyphPadding; y < height - glyphPadding; ++y)
             {
-                for (unsigned int x = padding; x < width - padding; ++x)
+                for (unsigned int x = glyphPadding; x < width - glyphPadding; ++x)
                 {
                     // The color channels remain white, just fill the alpha channel
                     std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
+                    pixelBuffer[index * 4 + 3] = ((pixels[(x - glyphPadding) / 8]) & (1 << (7 - ((x - glyphPadding) % 8)))) ? 255 : 0;
                 }
                 pixels += bitmap.pitch;
             }
         }
         else
         {
-            // Pixels are 8 bits gray levels
-            for (unsigned int y = padding; y < height - padding; ++y)
+            // Pixels are 8 bits gray levels, they become the alpha of white pixels
+            for (unsigned int y = glyphPadding; y < height - glyphPadding; ++y)
             {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
-                }
+                Uint8* row = &pixelBuffer[(glyphPadding + y * width) * 4];
+                priv::ImageKernels::expandAlpha(row, pixels, width - 2 * glyphPadding);
                 pixels += bitmap.pitch;
             }
         }
 
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left - padding;
-        unsigned int y = glyph.textureRect.top - padding;
-        unsigned int w = glyph.textureRect.width + 2 * padding;
-        unsigned int h = glyph.textureRect.height + 2 * padding;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
+        // Convert the coverage of the pixels to distances
+        if (m_isDistanceField)
+            computeDistanceField(pixelBuffer, width, height, distanceFieldSpread);
     }
 
     // Delete the FT glyph
     FT_Done_Glyph(glyphDesc);
+}
 
-    // Done :)
-    return glyph;
+
+////////////////////////////////////////////////////////////
+IntRect Font::placeGlyph(Page& page, CachedGlyph& glyph) const
+{
+    const unsigned int glyphPadding = padding + (m_isDistanceField ? distanceFieldSpread : 0);
+
+    // Find a good position for the padded glyph into the textures
+    IntRect rect = findGlyphRect(page, glyph.glyph.textureRect.width + 2 * glyphPadding, glyph.glyph.textureRect.height + 2 * glyphPadding, glyph);
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    glyph.glyph.textureRect.left   = rect.left + glyphPadding;
+    glyph.glyph.textureRect.top    = rect.top + glyphPadding;
+    glyph.glyph.textureRect.width  = rect.width - 2 * glyphPadding;
+    glyph.glyph.textureRect.height = rect.height - 2 * glyphPadding;
+
+    return rect;
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+std::size_t Font::insertGlyph(Page& page, Uint64 key, const CachedGlyph& glyph) const
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
+    // Reuse the storage of an evicted glyph if possible
+    std::size_t index = page.glyphs.size();
+    if (page.freeGlyphs.empty())
     {
-        float ratio = static_cast<float>(height) / it->height;
+        page.glyphs.push_back(glyph);
+    }
+    else
+    {
+        index = page.freeGlyphs.back();
+        page.freeGlyphs.pop_back();
+        page.glyphs[index] = glyph;
+    }
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
+    page.glyphTable->insert(key, index);
 
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
+    // Register the glyph in its row, so that they get evicted together
+    if (glyph.row != noRow)
+        page.atlases[glyph.glyph.textureIndex].rows[glyph.row].glyphs.push_back(key);
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height, CachedGlyph& glyph) const
+{
+    Atlas* atlas = NULL;
+    std::size_t rowIndex = 0;
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
+    // Find the row that fits well the glyph, in all the textures of the page
+    for (std::size_t i = 0; (i < page.atlases.size()) && !atlas; ++i)
+    {
+        rowIndex = priv::ShelfPacker::findRow(page.atlases[i], width, height);
+        if (rowIndex != priv::ShelfPacker::NoRow)
+        {
+            atlas = &page.atlases[i];
+            glyph.glyph.textureIndex = static_cast<unsigned int>(i);
+        }
     }
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
+    // If we didn't find a matching row, create a new one
+    if (!atlas)
     {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
+        unsigned int rowHeight = priv::ShelfPacker::getRowHeight(height);
+
+        // Glyphs bigger than the regular texture size are allowed to grow their texture further
+        unsigned int maximumSize = std::min(std::max(atlasSize, 2 * std::max(width, rowHeight)), Texture::getMaximumSize());
+
+        // Try the last texture first, growing it by doubling its size, then
+        // a new texture if the page may have one more; once all of them are
+        // full, a row of the least recently used glyphs is evicted below
+        if (createRow(page.atlases.back(), width, rowHeight, maximumSize))
         {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
-            {
-                // Make the texture 2 times bigger
-                Texture newTexture;
-                newTexture.create(textureWidth * 2, textureHeight * 2);
-                newTexture.setSmooth(m_isSmooth);
-                newTexture.update(page.texture);
-                page.texture.swap(newTexture);
-            }
-            else
+            atlas = &page.atlases.back();
+        }
+        else if (page.atlases.size() < maxAtlasCount)
+        {
+            // The previous textures reached the regular size, so this character
+            // size is heavily used: start the next one at that size directly
+            Atlas& newAtlas = createAtlas(page, std::min(atlasSize, Texture::getMaximumSize()));
+
+            if (createRow(newAtlas, width, rowHeight, maximumSize))
+                atlas = &newAtlas;
+        }
+
+        if (atlas)
+        {
+            rowIndex = atlas->rows.size() - 1;
+            glyph.glyph.textureIndex = static_cast<unsigned int>(page.atlases.size() - 1);
+        }
+    }
+
+    // If all the textures are full, evict the least recently used row that can hold the glyph
+    if (!atlas)
+    {
+        for (std::size_t i = 0; i < page.atlases.size(); ++i)
+        {
+            Atlas& current = page.atlases[i];
+            if (width > current.texture.getSize().x)
+                continue;
+
+            for (std::size_t j = 0; j < current.rows.size(); ++j)
             {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
-                return IntRect(0, 0, 2, 2);
+                const Row& row = current.rows[j];
+                if ((row.height >= height) && (!atlas || (row.lastUse < atlas->rows[rowIndex].lastUse)))
+                {
+                    atlas = &current;
+                    rowIndex = j;
+                    glyph.glyph.textureIndex = static_cast<unsigned int>(i);
+                }
             }
         }
 
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
+        if (!atlas)
+        {
+            // Oops, the glyph is bigger than the maximum texture size...
+            err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+            glyph.glyph.textureIndex = 0;
+            return IntRect(0, 0, 2, 2);
+        }
+
+        // Pending batched primitives may still reference the pixels of the row
+        RenderTarget::flushBatches(atlas->texture);
+
+        evictRow(page, *atlas, rowIndex);
+
+        // The texts that displayed the evicted glyphs must lay them out again
+        page.generation = getUniqueGeneration();
     }
 
+    glyph.row = rowIndex;
+
     // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
+    return priv::ShelfPacker::allocate(*atlas, rowIndex, width, height);
+}
 
-    // Update the row informations
-    row->width += width;
 
-    return rect;
+////////////////////////////////////////////////////////////
+Font::Row* Font::createRow(Atlas& atlas, unsigned int width, unsigned int height, unsigned int maximumSize) const
+{
+    while (!priv::ShelfPacker::hasRoomForRow(atlas, width, height))
+    {
+        // Not enough space: resize the texture if possible
+        unsigned int textureWidth  = atlas.texture.getSize().x;
+        unsigned int textureHeight = atlas.texture.getSize().y;
+        if ((textureWidth * 2 > maximumSize) || (textureHeight * 2 > maximumSize))
+            return NULL;
+
+        // Make the texture 2 times bigger
+        Texture newTexture;
+        newTexture.create(textureWidth * 2, textureHeight * 2);
+        newTexture.setSmooth(m_isSmooth || m_isDistanceField);
+        newTexture.update(atlas.texture);
+        atlas.texture.swap(newTexture);
+
+        // The existing rows got wider, so they may have free space again
+        priv::ShelfPacker::reopenRows(atlas);
+    }
+
+    // We can now create the new row
+    return &atlas.rows[priv::ShelfPacker::addRow(atlas, height)];
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::evictRow(Page& page, Atlas& atlas, std::size_t index) const
+{
+    Row& row = atlas.rows[index];
+
+    // Forget the glyphs of the row, they will be loaded again when requested
+    for (std::vector<Uint64>::const_iterator it = row.glyphs.begin(); it != row.glyphs.end(); ++it)
+    {
+        std::size_t* glyphIndex = page.glyphTable->find(*it);
+        if (glyphIndex)
+        {
+            page.freeGlyphs.push_back(*glyphIndex);
+            page.glyphTable->erase(*it);
+        }
+    }
+
+    row.glyphs.clear();
+    priv::ShelfPacker::resetRow(atlas, index);
 }
 
 
@@ -838,12 +1506,64 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 
 
 ////////////////////////////////////////////////////////////
-Font::Page::Page() :
-nextRow(3)
+Uint64 Font::getLayoutGeneration(unsigned int characterSize) const
+{
+    return loadPage(characterSize).generation;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader* Font::getDistanceFieldShader(bool programmable) const
+{
+    if (!Shader::isAvailable())
+        return NULL;
+
+    Shader*& shader = programmable ? m_programmableDistanceFieldShader : m_distanceFieldShader;
+    if (!shader)
+    {
+        shader = new Shader;
+
+        bool loaded;
+        if (programmable)
+        {
+            // The version that the context accepts is known here, since the shader is requested while drawing
+            std::string version = priv::ProgrammableRenderer::getVersionDirective();
+            loaded = shader->loadFromMemory(version + programmableDistanceFieldVertexShader,
+                                            version + programmableDistanceFieldFragmentShader);
+        }
+        else
+        {
+            loaded = shader->loadFromMemory(distanceFieldVertexShader, distanceFieldFragmentShader);
+        }
+
+        if (loaded)
+            shader->setUniform("glyphs", Shader::CurrentTexture);
+    }
+
+    // Don't try again if the compilation failed
+    return shader->getNativeHandle() ? shader : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page& Font::loadPage(unsigned int characterSize) const
+{
+    Page& page = m_pages[characterSize];
+
+    // Make sure that the page has a texture
+    if (page.atlases.empty())
+        createAtlas(page, 128);
+
+    return page;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Atlas& Font::createAtlas(Page& page, unsigned int size) const
 {
     // Make sure that the texture is initialized by default
     sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
+    image.create(size, size, Color(255, 255, 255, 0));
 
     // Reserve a 2x2 white square for texturing underlines
     for (int x = 0; x < 2; ++x)
@@ -851,8 +1571,70 @@ nextRow(3)
             image.setPixel(x, y, Color(255, 255, 255, 255));
 
     // Create the texture
-    texture.loadFromImage(image);
-    texture.setSmooth(true);
+    page.atlases.push_back(Atlas());
+    Atlas& atlas = page.atlases.back();
+    atlas.texture.loadFromImage(image);
+    atlas.texture.setSmooth(m_isSmooth || m_isDistanceField);
+
+    return atlas;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Atlas::Atlas() :
+nextRow(3)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page::Page() :
+glyphTable(new GlyphTable),
+glyphs    (),
+freeGlyphs(),
+kernings  (new KerningTable),
+atlases   (),
+useCounter(0),
+generation(getUniqueGeneration())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page::Page(const Page& copy) :
+glyphTable(new GlyphTable(*copy.glyphTable)),
+glyphs    (copy.glyphs),
+freeGlyphs(copy.freeGlyphs),
+kernings  (new KerningTable(*copy.kernings)),
+atlases   (copy.atlases),
+useCounter(copy.useCounter),
+generation(copy.generation)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page::~Page()
+{
+    delete glyphTable;
+    delete kernings;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page& Font::Page::operator =(const Page& right)
+{
+    Page temp(right);
+
+    std::swap(glyphTable, temp.glyphTable);
+    std::swap(glyphs,     temp.glyphs);
+    std::swap(freeGlyphs, temp.freeGlyphs);
+    std::swap(kernings,   temp.kernings);
+    std::swap(atlases,    temp.atlases);
+    std::swap(useCounter, temp.useCounter);
+    std::swap(generation, temp.generation);
+
+    return *this;
 }
 
 } // namespace sf
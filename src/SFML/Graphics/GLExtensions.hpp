@@ -135,6 +135,14 @@
     #define GLEXT_GL_COPY_WRITE_BUFFER                0
     #define GLEXT_glCopyBufferSubData                 glCopyBufferSubData // Placeholder to satisfy the compiler, entry point is not loaded in GLES
 
+    // Core since 3.0 - uniform buffer objects
+    #define GLEXT_uniform_buffer_object               false
+    #define GLEXT_GL_UNIFORM_BUFFER                   0
+    #define GLEXT_GL_INVALID_INDEX                    0
+    #define GLEXT_glBindBufferBase                    glBindBufferBase // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glGetUniformBlockIndex              glGetUniformBlockIndex // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glUniformBlockBinding               glUniformBlockBinding // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
     // Core since 3.0 - EXT_sRGB
     #define GLEXT_texture_sRGB                        false
     #define GLEXT_GL_SRGB8_ALPHA8                     0
@@ -144,6 +152,80 @@
     #define GLEXT_GL_MIN                              GL_MIN_EXT
     #define GLEXT_GL_MAX                              GL_MAX_EXT
 
+    // Core since 3.0 - NV_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 false
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                0
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              0
+    #define GLEXT_GL_STREAM_READ                      0
+    #define GLEXT_glUnmapBuffer                       glUnmapBuffer // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.0 - EXT_map_buffer_range
+    #define GLEXT_map_buffer_range                    false
+    #define GLEXT_GL_MAP_READ_BIT                     0
+    #define GLEXT_GL_MAP_WRITE_BIT                    0
+    #define GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT        0
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           0
+    #define GLEXT_glMapBufferRange                    glMapBufferRange // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.0 - OES_vertex_array_object
+    #define GLEXT_vertex_array_object                 false
+    #define GLEXT_glBindVertexArray                   glBindVertexArray // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glDeleteVertexArrays                glDeleteVertexArrays // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glGenVertexArrays                   glGenVertexArrays // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.0 - APPLE_sync
+    #define GLEXT_sync                                false
+    #define GLEXT_GLsync                              GLsync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       0
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          0
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  0
+    #define GLEXT_GL_WAIT_FAILED                      0
+    #define GLEXT_glFenceSync                         glFenceSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glClientWaitSync                    glClientWaitSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glDeleteSync                        glDeleteSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.0 - OES_get_program_binary
+    #define GLEXT_get_program_binary                  false
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            0
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  0
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glProgramBinary                     glProgramBinary // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glProgramParameteri                 glProgramParameteri // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glGetProgramiv                      glGetProgramiv // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // KHR_parallel_shader_compile
+    #define GLEXT_parallel_shader_compile             false
+    #define GLEXT_GL_COMPLETION_STATUS                0
+
+    // Core since 1.0
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+
+    // EXT_texture_compression_s3tc
+    #define GLEXT_texture_compression_s3tc            false
+    #define GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1         0
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1        0
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3        0
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5        0
+    #define GLEXT_GL_COMPRESSED_SRGB_S3TC_DXT1        0
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1  0
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3  0
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5  0
+
+    // Core since 3.0
+    #define GLEXT_texture_compression_etc2            false
+    #define GLEXT_GL_COMPRESSED_RGB8_ETC2             0
+    #define GLEXT_GL_COMPRESSED_SRGB8_ETC2            0
+    #define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC        0
+    #define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0
+
+    // Core since 3.0
+    #define GLEXT_texture_array                       false
+    #define GLEXT_GL_TEXTURE_2D_ARRAY                 0
+    #define GLEXT_GL_TEXTURE_BINDING_2D_ARRAY         0
+    #define GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS         0
+    #define GLEXT_glTexImage3D                        glTexImage3D // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glTexSubImage3D                     glTexSubImage3D // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
 #else
 
     // SFML requires at a bare minimum OpenGL 1.1 capability
@@ -226,7 +308,10 @@
     #define GLEXT_glUniform4i                         glUniform4iARB
     #define GLEXT_glUniform1fv                        glUniform1fvARB
     #define GLEXT_glUniform2fv                        glUniform2fvARB
+    #define GLEXT_glUniform1iv                        glUniform1ivARB
     #define GLEXT_glUniform2iv                        glUniform2ivARB
+    #define GLEXT_glUniform3iv                        glUniform3ivARB
+    #define GLEXT_glUniform4iv                        glUniform4ivARB
     #define GLEXT_glUniform3fv                        glUniform3fvARB
     #define GLEXT_glUniform4fv                        glUniform4fvARB
     #define GLEXT_glUniformMatrix3fv                  glUniformMatrix3fvARB
@@ -243,6 +328,7 @@
     #define GLEXT_vertex_shader                       SF_GLAD_GL_ARB_vertex_shader
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
+    #define GLEXT_glBindAttribLocation                glBindAttribLocationARB
 
     // Core since 2.0 - ARB_fragment_shader
     #define GLEXT_fragment_shader                     SF_GLAD_GL_ARB_fragment_shader
@@ -298,16 +384,111 @@
     #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
     #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
 
+    // Core since 3.0 - EXT_texture_array
+    #define GLEXT_texture_array                       SF_GLAD_GL_EXT_texture_array
+    #define GLEXT_GL_TEXTURE_2D_ARRAY                 GL_TEXTURE_2D_ARRAY_EXT
+    #define GLEXT_GL_TEXTURE_BINDING_2D_ARRAY         GL_TEXTURE_BINDING_2D_ARRAY_EXT
+    #define GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS         GL_MAX_ARRAY_TEXTURE_LAYERS_EXT
+    #define GLEXT_glTexImage3D                        glTexImage3D
+    #define GLEXT_glTexSubImage3D                     glTexSubImage3D
+
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 SF_GLAD_GL_VERSION_2_1
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                GL_PIXEL_PACK_BUFFER
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              GL_PIXEL_UNPACK_BUFFER
+    #define GLEXT_GL_STREAM_READ                      GL_STREAM_READ
+
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    SF_GLAD_GL_VERSION_3_0
+    #define GLEXT_GL_MAP_READ_BIT                     GL_MAP_READ_BIT
+    #define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT        GL_MAP_INVALIDATE_BUFFER_BIT
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+    #define GLEXT_glMapBufferRange                    glMapBufferRange
+
+    // Core since 3.0 - ARB_vertex_array_object
+    #define GLEXT_vertex_array_object                 SF_GLAD_GL_VERSION_3_0
+    #define GLEXT_glBindVertexArray                   glBindVertexArray
+    #define GLEXT_glDeleteVertexArrays                glDeleteVertexArrays
+    #define GLEXT_glGenVertexArrays                   glGenVertexArrays
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArray
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointer
+
+    // Core since 2.0 - shader entry points working on unsigned integer names, as exposed by core profiles
+    #define GLEXT_GL_COMPILE_STATUS                   GL_COMPILE_STATUS
+    #define GLEXT_GL_LINK_STATUS                      GL_LINK_STATUS
+    #define GLEXT_glCreateShader                      glCreateShader
+    #define GLEXT_glCreateProgram                     glCreateProgram
+    #define GLEXT_glUseProgram                        glUseProgram
+    #define GLEXT_glGetShaderiv                       glGetShaderiv
+    #define GLEXT_glGetShaderInfoLog                  glGetShaderInfoLog
+    #define GLEXT_glGetProgramInfoLog                 glGetProgramInfoLog
+    #define GLEXT_glDeleteShader                      glDeleteShader
+    #define GLEXT_glDeleteProgram                     glDeleteProgram
+
     // Core since 3.1 - ARB_copy_buffer
     #define GLEXT_copy_buffer                         SF_GLAD_GL_ARB_copy_buffer
     #define GLEXT_GL_COPY_READ_BUFFER                 GL_COPY_READ_BUFFER
     #define GLEXT_GL_COPY_WRITE_BUFFER                GL_COPY_WRITE_BUFFER
     #define GLEXT_glCopyBufferSubData                 glCopyBufferSubData
 
+    // Core since 3.1 - ARB_uniform_buffer_object
+    #define GLEXT_uniform_buffer_object               SF_GLAD_GL_ARB_uniform_buffer_object
+    #define GLEXT_GL_UNIFORM_BUFFER                   GL_UNIFORM_BUFFER
+    #define GLEXT_GL_INVALID_INDEX                    GL_INVALID_INDEX
+    #define GLEXT_glBindBufferBase                    glBindBufferBase
+    #define GLEXT_glGetUniformBlockIndex              glGetUniformBlockIndex
+    #define GLEXT_glUniformBlockBinding               glUniformBlockBinding
+
     // Core since 3.2 - ARB_geometry_shader4
     #define GLEXT_geometry_shader4                    SF_GLAD_GL_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                SF_GLAD_GL_VERSION_3_2
+    #define GLEXT_GLsync                              GLsync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  GL_TIMEOUT_EXPIRED
+    #define GLEXT_GL_WAIT_FAILED                      GL_WAIT_FAILED
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  SF_GLAD_GL_ARB_get_program_binary
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary
+    #define GLEXT_glProgramBinary                     glProgramBinary
+    #define GLEXT_glProgramParameteri                 glProgramParameteri
+    #define GLEXT_glGetProgramiv                      glGetProgramiv
+
+    // KHR_parallel_shader_compile
+    #define GLEXT_parallel_shader_compile             SF_GLAD_GL_KHR_parallel_shader_compile
+    #define GLEXT_GL_COMPLETION_STATUS                GL_COMPLETION_STATUS_KHR
+
+    // Core since 1.3 - ARB_texture_compression
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+
+    // EXT_texture_compression_s3tc
+    #define GLEXT_texture_compression_s3tc            SF_GLAD_GL_EXT_texture_compression_s3tc
+    #define GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1         GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1        GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3        GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5        GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    #define GLEXT_GL_COMPRESSED_SRGB_S3TC_DXT1        GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1  GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3  GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5  GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+
+    // Core since 4.3 - ARB_ES3_compatibility
+    #define GLEXT_texture_compression_etc2            SF_GLAD_GL_ARB_ES3_compatibility
+    #define GLEXT_GL_COMPRESSED_RGB8_ETC2             GL_COMPRESSED_RGB8_ETC2
+    #define GLEXT_GL_COMPRESSED_SRGB8_ETC2            GL_COMPRESSED_SRGB8_ETC2
+    #define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC        GL_COMPRESSED_RGBA8_ETC2_EAC
+    #define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+
     // OpenGL Versions
     #define GLEXT_GL_VERSION_1_0                      SF_GLAD_GL_VERSION_1_0
     #define GLEXT_GL_VERSION_1_1                      SF_GLAD_GL_VERSION_1_1
@@ -0,0 +1,506 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLStatesTracker.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GLStatesTracker::GLStatesTracker() :
+m_recording    (false),
+m_fixedFunction(true),
+m_saved        (0),
+m_callCount    (0),
+m_capabilities (),
+m_textureUnits (),
+m_activeTexture(0),
+m_matrixMode   (0),
+m_program      (0),
+m_arrayBuffer  (0),
+m_vertexArray  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStatesTracker::begin(bool fixedFunction)
+{
+    m_recording = true;
+    m_fixedFunction = fixedFunction;
+    m_saved = 0;
+    m_callCount = 0;
+    m_capabilities.clear();
+    m_textureUnits.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStatesTracker::restore()
+{
+    if (!m_recording)
+        return;
+
+    m_recording = false;
+    m_callCount = 0;
+
+    // Texture units first, since restoring them changes the active unit and the matrix mode
+    for (std::vector<TextureUnit>::reverse_iterator it = m_textureUnits.rbegin(); it != m_textureUnits.rend(); ++it)
+    {
+        if (GLEXT_multitexture)
+        {
+            glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + it->unit));
+            ++m_callCount;
+        }
+
+        glCheck(glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(it->texture)));
+        ++m_callCount;
+
+        if (GLEXT_texture_array)
+        {
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, static_cast<GLuint>(it->textureArray)));
+            ++m_callCount;
+        }
+
+        if (m_fixedFunction)
+        {
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glLoadMatrixf(it->matrix));
+            m_callCount += 2;
+        }
+    }
+
+    if (m_saved & ActiveTexture)
+    {
+        glCheck(GLEXT_glActiveTexture(static_cast<GLenum>(m_activeTexture)));
+        ++m_callCount;
+    }
+
+    if (m_saved & ModelViewMatrix)
+    {
+        glCheck(glMatrixMode(GL_MODELVIEW));
+        glCheck(glLoadMatrixf(m_modelView));
+        m_callCount += 2;
+    }
+
+    if (m_saved & ProjectionMatrix)
+    {
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glLoadMatrixf(m_projection));
+        m_callCount += 2;
+    }
+
+    if (m_saved & MatrixMode)
+    {
+        glCheck(glMatrixMode(static_cast<GLenum>(m_matrixMode)));
+        ++m_callCount;
+    }
+
+    if (m_saved & VertexArray)
+    {
+        glCheck(GLEXT_glBindVertexArray(static_cast<GLuint>(m_vertexArray)));
+        ++m_callCount;
+    }
+
+    if (m_saved & ClientArrays)
+    {
+        #ifndef SFML_OPENGL_ES
+
+            // The pointers were saved along with the client states
+            glCheck(glPopClientAttrib());
+            ++m_callCount;
+
+        #else
+
+            static const GLenum arrays[3] = {GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY};
+            for (int i = 0; i < 3; ++i)
+            {
+                if (m_clientArrays[i])
+                    glCheck(glEnableClientState(arrays[i]));
+                else
+                    glCheck(glDisableClientState(arrays[i]));
+            }
+            m_callCount += 3;
+
+        #endif
+    }
+
+    if (m_saved & ArrayBuffer)
+    {
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, static_cast<GLuint>(m_arrayBuffer)));
+        ++m_callCount;
+    }
+
+    #ifndef SFML_OPENGL_ES
+
+        if (m_saved & Program)
+        {
+            glCheck(GLEXT_glUseProgram(static_cast<GLuint>(m_program)));
+            ++m_callCount;
+        }
+
+    #endif
+
+    if (m_saved & Viewport)
+    {
+        glCheck(glViewport(m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]));
+        ++m_callCount;
+    }
+
+    if (m_saved & BlendMode)
+    {
+        if (GLEXT_blend_func_separate)
+        {
+            glCheck(GLEXT_glBlendFuncSeparate(static_cast<GLenum>(m_blendFactors[0]), static_cast<GLenum>(m_blendFactors[1]),
+                                              static_cast<GLenum>(m_blendFactors[2]), static_cast<GLenum>(m_blendFactors[3])));
+        }
+        else
+        {
+            glCheck(glBlendFunc(static_cast<GLenum>(m_blendFactors[0]), static_cast<GLenum>(m_blendFactors[1])));
+        }
+        ++m_callCount;
+
+        if (GLEXT_blend_equation_separate)
+        {
+            glCheck(GLEXT_glBlendEquationSeparate(static_cast<GLenum>(m_blendEquations[0]), static_cast<GLenum>(m_blendEquations[1])));
+            ++m_callCount;
+        }
+        else if (GLEXT_blend_minmax || GLEXT_blend_subtract)
+        {
+            glCheck(GLEXT_glBlendEquation(static_cast<GLenum>(m_blendEquations[0])));
+            ++m_callCount;
+        }
+    }
+
+    for (std::vector<Capability>::const_iterator it = m_capabilities.begin(); it != m_capabilities.end(); ++it)
+    {
+        if (it->enabled)
+            glCheck(glEnable(it->name));
+        else
+            glCheck(glDisable(it->name));
+        ++m_callCount;
+    }
+
+    if (m_saved & ClearColor)
+    {
+        glCheck(glClearColor(m_clearColor[0], m_clearColor[1], m_clearColor[2], m_clearColor[3]));
+        ++m_callCount;
+    }
+
+    m_saved = 0;
+    m_capabilities.clear();
+    m_textureUnits.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GLStatesTracker::getCallCount() const
+{
+    return m_callCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStatesTracker::saveDefaultStates()
+{
+    if (!m_recording)
+        return;
+
+    saveCapability(GL_CULL_FACE);
+    saveCapability(GL_DEPTH_TEST);
+    saveCapability(GL_BLEND);
+
+    if (m_fixedFunction)
+    {
+        saveCapability(GL_LIGHTING);
+        saveCapability(GL_ALPHA_TEST);
+        saveCapability(GL_TEXTURE_2D);
+    }
+
+    if (GLEXT_multitexture)
+        saveActiveTexture();
+
+    if (m_fixedFunction && !(m_saved & ClientArrays))
+    {
+        #ifndef SFML_OPENGL_ES
+
+            // The client active texture and the array pointers belong to the same group
+            glCheck(glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT));
+            ++m_callCount;
+
+        #else
+
+            static const GLenum arrays[3] = {GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY};
+            for (int i = 0; i < 3; ++i)
+            {
+                GLboolean enabled;
+                glCheck(enabled = glIsEnabled(arrays[i]));
+                m_clientArrays[i] = (enabled == GL_TRUE);
+            }
+            m_callCount += 3;
+
+        #endif
+
+        m_saved |= ClientArrays;
+    }
+
+    if (m_fixedFunction && !(m_saved & ModelViewMatrix))
+    {
+        saveMatrixMode();
+
+        glCheck(glGetFloatv(GL_MODELVIEW_MATRIX, m_modelView));
+        ++m_callCount;
+
+        m_saved |= ModelViewMatrix;
+    }
+
+    if (!(m_saved & BlendMode))
+    {
+        if (GLEXT_blend_func_separate)
+        {
+            glCheck(glGetIntegerv(GL_BLEND_SRC_RGB, &m_blendFactors[0]));
+            glCheck(glGetIntegerv(GL_BLEND_DST_RGB, &m_blendFactors[1]));
+            glCheck(glGetIntegerv(GL_BLEND_SRC_ALPHA, &m_blendFactors[2]));
+            glCheck(glGetIntegerv(GL_BLEND_DST_ALPHA, &m_blendFactors[3]));
+            m_callCount += 4;
+        }
+        else
+        {
+            glCheck(glGetIntegerv(GL_BLEND_SRC, &m_blendFactors[0]));
+            glCheck(glGetIntegerv(GL_BLEND_DST, &m_blendFactors[1]));
+            m_callCount += 2;
+        }
+
+        if (GLEXT_blend_equation_separate)
+        {
+            glCheck(glGetIntegerv(GL_BLEND_EQUATION_RGB, &m_blendEquations[0]));
+            glCheck(glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &m_blendEquations[1]));
+            m_callCount += 2;
+        }
+        else if (GLEXT_blend_minmax || GLEXT_blend_subtract)
+        {
+            glCheck(glGetIntegerv(GL_BLEND_EQUATION_RGB, &m_blendEquations[0]));
+            ++m_callCount;
+        }
+
+        m_saved |= BlendMode;
+    }
+
+    saveTextureUnit(0);
+
+    #ifndef SFML_OPENGL_ES
+
+        if (GLEXT_GL_VERSION_2_0 && !(m_saved & Program))
+        {
+            glCheck(glGetIntegerv(GL_CURRENT_PROGRAM, &m_program));
+            ++m_callCount;
+
+            m_saved |= Program;
+        }
+
+    #endif
+
+    if ((GLEXT_vertex_buffer_object || GLEXT_vertex_array_object) && !(m_saved & ArrayBuffer))
+    {
+        glCheck(glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &m_arrayBuffer));
+        ++m_callCount;
+
+        m_saved |= ArrayBuffer;
+    }
+
+    if (!m_fixedFunction && GLEXT_vertex_array_object && !(m_saved & VertexArray))
+    {
+        glCheck(glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &m_vertexArray));
+        ++m_callCount;
+
+        m_saved |= VertexArray;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStatesTracker::saveView()
+{
+    if (!m_recording)
+        return;
+
+    if (!(m_saved & Viewport))
+    {
+        glCheck(glGetIntegerv(GL_VIEWPORT, m_viewport));
+        ++m_callCount;
+
+        m_saved |= Viewport;
+    }
+
+    if (m_fixedFunction && !(m_saved & ProjectionMatrix))
+    {
+        saveMatrixMode();
+
+        glCheck(glGetFloatv(GL_PROJECTION_MATRIX, m_projection));
+        ++m_callCount;
+
+        m_saved |= ProjectionMatrix;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStatesTracker::saveTextureUnit(unsigned int unit)
+{
+    if (!m_recording)
+        return;
+
+    for (std::vector<TextureUnit>::const_iterator it = m_textureUnits.begin(); it != m_textureUnits.end(); ++it)
+    {
+        if (it->unit == unit)
+            return;
+    }
+
+    // Binding a texture may change the texture matrix, and the matrix mode with it
+    if (m_fixedFunction)
+        saveMatrixMode();
+
+    // Queries apply to the active unit, which may be any unit the user left
+    // selected: select the requested one for the time being, even unit 0
+    GLint activeTexture = 0;
+    bool switchUnit = false;
+    if (GLEXT_multitexture)
+    {
+        if (m_saved & ActiveTexture)
+        {
+            glCheck(glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture));
+            ++m_callCount;
+        }
+        else
+        {
+            saveActiveTexture();
+            activeTexture = m_activeTexture;
+        }
+
+        switchUnit = (static_cast<GLenum>(activeTexture) != GLEXT_GL_TEXTURE0 + unit);
+        if (switchUnit)
+        {
+            glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + unit));
+            ++m_callCount;
+        }
+    }
+
+    TextureUnit textureUnit;
+    textureUnit.unit = unit;
+    textureUnit.textureArray = 0;
+
+    glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &textureUnit.texture));
+    ++m_callCount;
+
+    if (GLEXT_texture_array)
+    {
+        glCheck(glGetIntegerv(GLEXT_GL_TEXTURE_BINDING_2D_ARRAY, &textureUnit.textureArray));
+        ++m_callCount;
+    }
+
+    if (m_fixedFunction)
+    {
+        glCheck(glGetFloatv(GL_TEXTURE_MATRIX, textureUnit.matrix));
+        ++m_callCount;
+    }
+
+    // Select the unit that was active before again
+    if (switchUnit)
+    {
+        glCheck(GLEXT_glActiveTexture(static_cast<GLenum>(activeTexture)));
+        ++m_callCount;
+    }
+
+    m_textureUnits.push_back(textureUnit);
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStatesTracker::saveClearColor()
+{
+    if (!m_recording || (m_saved & ClearColor))
+        return;
+
+    glCheck(glGetFloatv(GL_COLOR_CLEAR_VALUE, m_clearColor));
+    ++m_callCount;
+
+    m_saved |= ClearColor;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStatesTracker::saveCapability(unsigned int capability)
+{
+    for (std::vector<Capability>::const_iterator it = m_capabilities.begin(); it != m_capabilities.end(); ++it)
+    {
+        if (it->name == capability)
+            return;
+    }
+
+    GLboolean enabled;
+    glCheck(enabled = glIsEnabled(capability));
+    ++m_callCount;
+
+    Capability saved;
+    saved.name = capability;
+    saved.enabled = (enabled == GL_TRUE);
+    m_capabilities.push_back(saved);
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStatesTracker::saveActiveTexture()
+{
+    if (m_saved & ActiveTexture)
+        return;
+
+    glCheck(glGetIntegerv(GL_ACTIVE_TEXTURE, &m_activeTexture));
+    ++m_callCount;
+
+    m_saved |= ActiveTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStatesTracker::saveMatrixMode()
+{
+    if (m_saved & MatrixMode)
+        return;
+
+    glCheck(glGetIntegerv(GL_MATRIX_MODE, &m_matrixMode));
+    ++m_callCount;
+
+    m_saved |= MatrixMode;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GLSTATESTRACKER_HPP
+#define SFML_GLSTATESTRACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Record the OpenGL states that a render target
+///        modifies, so that only those are restored
+///
+/// This is the lightweight alternative to the attribute
+/// and matrix stacks used by sf::RenderTarget::pushGLStates:
+/// each state is queried right before SFML changes it for the
+/// first time, and restore() sets back the recorded values.
+///
+////////////////////////////////////////////////////////////
+class GLStatesTracker : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GLStatesTracker();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start recording the states
+    ///
+    /// \param fixedFunction Whether the render target uses the
+    ///                      fixed-function states (matrices,
+    ///                      client-side arrays)
+    ///
+    ////////////////////////////////////////////////////////////
+    void begin(bool fixedFunction);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the recorded states and stop recording
+    ///
+    ////////////////////////////////////////////////////////////
+    void restore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of OpenGL calls of the last transition
+    ///
+    /// \return Number of calls made to save the states since
+    ///         begin(), or to restore them in the last restore()
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCallCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the states set by sf::RenderTarget::resetGLStates
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveDefaultStates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the viewport and the projection matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveView();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the texture bound to a texture unit
+    ///
+    /// \param unit Index of the texture unit
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveTextureUnit(unsigned int unit);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the clear color
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveClearColor();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save whether a capability is enabled
+    ///
+    /// \param capability OpenGL capability (GL_BLEND, ...)
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveCapability(unsigned int capability);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the active texture unit
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveActiveTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the current matrix mode
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveMatrixMode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Flags of the states that have been saved
+    ///
+    ////////////////////////////////////////////////////////////
+    enum State
+    {
+        ClientArrays     = 1 << 0, //!< Client-side vertex arrays
+        ActiveTexture    = 1 << 1, //!< Active texture unit
+        MatrixMode       = 1 << 2, //!< Current matrix mode
+        ModelViewMatrix  = 1 << 3, //!< Model-view matrix
+        ProjectionMatrix = 1 << 4, //!< Projection matrix
+        Viewport         = 1 << 5, //!< Viewport rectangle
+        BlendMode        = 1 << 6, //!< Blending factors and equations
+        Program          = 1 << 7, //!< Program in use
+        ArrayBuffer      = 1 << 8, //!< Buffer bound to GL_ARRAY_BUFFER
+        VertexArray      = 1 << 9, //!< Vertex array object
+        ClearColor       = 1 << 10 //!< Clear color
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Saved state of a capability
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Capability
+    {
+        unsigned int name;    //!< OpenGL capability
+        bool         enabled; //!< Was it enabled?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Saved state of a texture unit
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TextureUnit
+    {
+        unsigned int unit;         //!< Index of the texture unit
+        int          texture;      //!< Bound 2D texture
+        int          textureArray; //!< Bound 2D array texture
+        float        matrix[16];   //!< Texture matrix
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    bool                     m_recording;         //!< Are the states being recorded?
+    bool                     m_fixedFunction;     //!< Does the render target use the fixed-function states?
+    Uint32                   m_saved;             //!< Combination of State flags
+    unsigned int             m_callCount;         //!< OpenGL calls of the current or last transition
+    std::vector<Capability>  m_capabilities;      //!< Saved capabilities
+    std::vector<TextureUnit> m_textureUnits;      //!< Saved texture units
+    int                      m_activeTexture;     //!< Saved active texture unit
+    int                      m_matrixMode;        //!< Saved matrix mode
+    float                    m_modelView[16];     //!< Saved model-view matrix
+    float                    m_projection[16];    //!< Saved projection matrix
+    int                      m_viewport[4];       //!< Saved viewport
+    int                      m_blendFactors[4];   //!< Saved source and destination factors, color then alpha
+    int                      m_blendEquations[2]; //!< Saved color and alpha blending equations
+    int                      m_program;           //!< Saved program
+    int                      m_arrayBuffer;       //!< Saved vertex buffer binding
+    int                      m_vertexArray;       //!< Saved vertex array object binding
+    bool                     m_clientArrays[3];   //!< Saved vertex, color and texture coordinates array states
+    float                    m_clearColor[4];     //!< Saved clear color
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLSTATESTRACKER_HPP
@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_HASHTABLE_HPP
+#define SFML_HASHTABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Open addressing hash table with 64-bit keys
+///
+/// Values are stored inline and move when the table grows,
+/// so pointers to them are only valid until the next insertion
+/// or removal. Values are moved with std::swap, which is cheap
+/// for containers.
+/// Collisions are resolved by linear probing, and erased
+/// entries don't leave tombstones behind.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class HashTable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty table, without allocating any slot.
+    ///
+    ////////////////////////////////////////////////////////////
+    HashTable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the value of a key
+    ///
+    /// \param key Key to search
+    ///
+    /// \return Pointer to the value, or NULL if the key is not in the table
+    ///
+    ////////////////////////////////////////////////////////////
+    T* find(Uint64 key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the value of a key
+    ///
+    /// \param key Key to search
+    ///
+    /// \return Pointer to the value, or NULL if the key is not in the table
+    ///
+    ////////////////////////////////////////////////////////////
+    const T* find(Uint64 key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a key, or replace its value if it is already in the table
+    ///
+    /// \param key   Key to insert
+    /// \param value Value of the key
+    ///
+    /// \return Reference to the inserted value
+    ///
+    ////////////////////////////////////////////////////////////
+    T& insert(Uint64 key, const T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a key from the table, if present
+    ///
+    /// \param key Key to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void erase(Uint64 key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the keys and free the slots
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of keys in the table
+    ///
+    /// \return Number of keys
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of slots of the table
+    ///
+    /// Together with getEntry, this allows iterating over
+    /// the entries of the table, in no particular order.
+    ///
+    /// \return Number of slots
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSlotCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the entry stored in a slot
+    ///
+    /// \param index Index of the slot, in [0, getSlotCount()[
+    /// \param key   Receives the key of the entry, if any
+    ///
+    /// \return Pointer to the value, or NULL if the slot is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    const T* getEntry(std::size_t index, Uint64& key) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining an entry of the table
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        Slot() : key(0), used(false), value() {}
+
+        Uint64 key;   //!< Key of the entry
+        bool   used;  //!< Does the slot contain an entry?
+        T      value; //!< Value of the entry
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scramble the bits of a key
+    ///
+    /// Close keys are spread across the slots of the table.
+    ///
+    /// \param key Key to hash
+    ///
+    /// \return Hash of the key
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t hash(Uint64 key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the slot containing a key, or the empty slot where it would be inserted
+    ///
+    /// \param key Key to search
+    ///
+    /// \return Index of the slot
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findSlot(Uint64 key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move an entry to an empty slot
+    ///
+    /// \param source      Slot containing the entry
+    /// \param destination Empty slot receiving the entry
+    ///
+    ////////////////////////////////////////////////////////////
+    static void move(Slot& source, Slot& destination);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Double the number of slots and insert the entries again
+    ///
+    ////////////////////////////////////////////////////////////
+    void grow();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Slot> m_slots; //!< Slots of the table, their count is always a power of two
+    std::size_t       m_size;  //!< Number of used slots
+};
+
+#include <SFML/Graphics/HashTable.inl>
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_HASHTABLE_HPP
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+HashTable<T>::HashTable() :
+m_slots(),
+m_size (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T* HashTable<T>::find(Uint64 key)
+{
+    if (m_slots.empty())
+        return NULL;
+
+    Slot& slot = m_slots[findSlot(key)];
+    return slot.used ? &slot.value : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const T* HashTable<T>::find(Uint64 key) const
+{
+    if (m_slots.empty())
+        return NULL;
+
+    const Slot& slot = m_slots[findSlot(key)];
+    return slot.used ? &slot.value : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T& HashTable<T>::insert(Uint64 key, const T& value)
+{
+    // Keep the table at most half full, so that the probe sequences remain short
+    if ((m_size + 1) * 2 > m_slots.size())
+        grow();
+
+    Slot& slot = m_slots[findSlot(key)];
+    if (!slot.used)
+    {
+        slot.key = key;
+        slot.used = true;
+        ++m_size;
+    }
+
+    slot.value = value;
+    return slot.value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void HashTable<T>::erase(Uint64 key)
+{
+    if (m_slots.empty())
+        return;
+
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t hole = findSlot(key);
+    if (!m_slots[hole].used)
+        return;
+
+    // Move back the next entries of the probe sequence into the hole,
+    // so that they remain reachable without leaving a tombstone
+    for (std::size_t next = (hole + 1) & mask; m_slots[next].used; next = (next + 1) & mask)
+    {
+        // An entry can only move if its ideal slot is not between the hole and its current slot
+        std::size_t ideal = hash(m_slots[next].key) & mask;
+        if (((next - ideal) & mask) >= ((next - hole) & mask))
+        {
+            move(m_slots[next], m_slots[hole]);
+            hole = next;
+        }
+    }
+
+    m_slots[hole] = Slot();
+    --m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void HashTable<T>::clear()
+{
+    std::vector<Slot>().swap(m_slots);
+    m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t HashTable<T>::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t HashTable<T>::getSlotCount() const
+{
+    return m_slots.size();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const T* HashTable<T>::getEntry(std::size_t index, Uint64& key) const
+{
+    const Slot& slot = m_slots[index];
+    if (!slot.used)
+        return NULL;
+
+    key = slot.key;
+    return &slot.value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t HashTable<T>::hash(Uint64 key)
+{
+    Uint32 h = static_cast<Uint32>(key ^ (key >> 32));
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t HashTable<T>::findSlot(Uint64 key) const
+{
+    // Linear probing: the table is never full, so an empty slot is always found
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t index = hash(key) & mask;
+    while (m_slots[index].used && (m_slots[index].key != key))
+        index = (index + 1) & mask;
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void HashTable<T>::move(Slot& source, Slot& destination)
+{
+    destination.key = source.key;
+    destination.used = true;
+    std::swap(destination.value, source.value);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void HashTable<T>::grow()
+{
+    std::vector<Slot> slots(m_slots.size() * 2 > 16 ? m_slots.size() * 2 : 16);
+    m_slots.swap(slots);
+
+    for (typename std::vector<Slot>::iterator it = slots.begin(); it != slots.end(); ++it)
+    {
+        if (it->used)
+            move(*it, m_slots[findSlot(it->key)]);
+    }
+}
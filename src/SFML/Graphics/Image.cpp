@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
@@ -35,20 +36,70 @@
 #include <cstring>
 
 
+namespace
+{
+    // Release pixels allocated with new[]
+    void deleteArray(sf::Uint8* pixels, void*)
+    {
+        delete[] pixels;
+    }
+
+    // Release pixels moved from a std::vector
+    void deleteVector(sf::Uint8*, void* userData)
+    {
+        delete static_cast<std::vector<sf::Uint8>*>(userData);
+    }
+
+    // Clip a rectangle to the bounds of an image; an empty rectangle covers the whole image
+    bool clipRectangle(sf::IntRect& rectangle, const sf::Vector2u& size)
+    {
+        sf::IntRect bounds(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
+        if ((rectangle.width == 0) || (rectangle.height == 0))
+            rectangle = bounds;
+
+        return rectangle.intersects(bounds, rectangle);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Image::Image() :
-m_size(0, 0)
+m_size    (0, 0),
+m_pixels  (NULL),
+m_deleter (NULL),
+m_userData(NULL)
 {
 
 }
 
 
+////////////////////////////////////////////////////////////
+Image::Image(const Image& copy) :
+m_size    (0, 0),
+m_pixels  (NULL),
+m_deleter (NULL),
+m_userData(NULL)
+{
+    create(copy.m_size.x, copy.m_size.y, copy.m_pixels);
+}
+
+
 ////////////////////////////////////////////////////////////
 Image::~Image()
 {
+    adopt(0, 0, NULL, NULL, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+Image& Image::operator =(const Image& right)
+{
+    if (this != &right)
+        create(right.m_size.x, right.m_size.y, right.m_pixels);
 
+    return *this;
 }
 
 
@@ -58,34 +109,18 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
     if (width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(width * height * 4);
-    
+        Uint8* newPixels = new Uint8[width * height * 4];
+
         // Fill it with the specified color
-        Uint8* ptr = &newPixels[0];
-        Uint8* end = ptr + newPixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
-    
+        priv::ImageKernels::fill(newPixels, width * height, color);
+
         // Commit the new pixel buffer
-        m_pixels.swap(newPixels);
-        
-        // Assign the new size
-        m_size.x = width;
-        m_size.y = height;
+        adopt(width, height, newPixels, &deleteArray, NULL);
     }
     else
     {
         // Dump the pixel buffer
-        std::vector<Uint8>().swap(m_pixels);
-        
-        // Assign the new size
-        m_size.x = 0;
-        m_size.y = 0;
+        adopt(0, 0, NULL, NULL, NULL);
     }
 }
 
@@ -96,23 +131,53 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
     if (pixels && width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(pixels, pixels + width * height * 4);
-        
+        Uint8* newPixels = new Uint8[width * height * 4];
+        std::memcpy(newPixels, pixels, width * height * 4);
+
         // Commit the new pixel buffer
-        m_pixels.swap(newPixels);
-        
-        // Assign the new size
-        m_size.x = width;
-        m_size.y = height;
+        adopt(width, height, newPixels, &deleteArray, NULL);
+    }
+    else
+    {
+        // Dump the pixel buffer
+        adopt(0, 0, NULL, NULL, NULL);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::create(unsigned int width, unsigned int height, std::vector<Uint8>& pixels)
+{
+    if (width && height && (pixels.size() >= width * height * 4))
+    {
+        // Move the storage of the buffer to the heap, so that it lives as long as the image
+        std::vector<Uint8>* storage = new std::vector<Uint8>;
+        storage->swap(pixels);
+
+        adopt(width, height, &(*storage)[0], &deleteVector, storage);
     }
     else
     {
         // Dump the pixel buffer
-        std::vector<Uint8>().swap(m_pixels);
-        
-        // Assign the new size
-        m_size.x = 0;
-        m_size.y = 0;
+        adopt(0, 0, NULL, NULL, NULL);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::create(unsigned int width, unsigned int height, Uint8* pixels, PixelDeleter deleter, void* userData)
+{
+    if (pixels && width && height)
+    {
+        adopt(width, height, pixels, deleter, userData);
+    }
+    else
+    {
+        // The pixels belong to us anyway, release them right away
+        if (pixels && deleter)
+            deleter(pixels, userData);
+
+        adopt(0, 0, NULL, NULL, NULL);
     }
 }
 
@@ -122,7 +187,7 @@ bool Image::loadFromFile(const std::string& filename)
 {
     #ifndef SFML_SYSTEM_ANDROID
 
-        return priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size);
+        return priv::ImageLoader::getInstance().loadImageFromFile(filename, *this, err());
 
     #else
 
@@ -136,14 +201,14 @@ bool Image::loadFromFile(const std::string& filename)
 ////////////////////////////////////////////////////////////
 bool Image::loadFromMemory(const void* data, std::size_t size)
 {
-    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, *this, err());
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::loadFromStream(InputStream& stream)
 {
-    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    return priv::ImageLoader::getInstance().loadImageFromStream(stream, *this, err());
 }
 
 
@@ -171,17 +236,10 @@ Vector2u Image::getSize() const
 void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 {
     // Make sure that the image is not empty
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        priv::ImageKernels::maskColor(m_pixels, m_size.x * m_size.y, color, alpha);
     }
 }
 
@@ -225,29 +283,16 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     int          rows      = height;
     int          srcStride = source.m_size.x * 4;
     int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
-    Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
+    const Uint8* srcPixels = source.m_pixels + (srcRect.left + srcRect.top * source.m_size.x) * 4;
+    Uint8*       dstPixels = m_pixels + (destX + destY * m_size.x) * 4;
 
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
+            priv::ImageKernels::blend(dstPixels, srcPixels, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
@@ -265,10 +310,50 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::fill(const Color& color, const IntRect& rectangle)
+{
+    IntRect area = rectangle;
+    if (!clipRectangle(area, m_size))
+        return;
+
+    for (int y = area.top; y < area.top + area.height; ++y)
+        priv::ImageKernels::fill(m_pixels + (area.left + y * m_size.x) * 4, area.width, color);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::blend(const Color& color, const IntRect& rectangle)
+{
+    IntRect area = rectangle;
+    if (!clipRectangle(area, m_size))
+        return;
+
+    for (int y = area.top; y < area.top + area.height; ++y)
+        priv::ImageKernels::blend(m_pixels + (area.left + y * m_size.x) * 4, area.width, color);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    if (m_pixels)
+        priv::ImageKernels::premultiplyAlpha(m_pixels, m_size.x * m_size.y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::swizzle(unsigned int red, unsigned int green, unsigned int blue, unsigned int alpha)
+{
+    if (m_pixels)
+        priv::ImageKernels::swizzle(m_pixels, m_size.x * m_size.y, red, green, blue, alpha);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 {
-    Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
+    Uint8* pixel = m_pixels + (x + y * m_size.x) * 4;
     *pixel++ = color.r;
     *pixel++ = color.g;
     *pixel++ = color.b;
@@ -279,7 +364,7 @@ void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 ////////////////////////////////////////////////////////////
 Color Image::getPixel(unsigned int x, unsigned int y) const
 {
-    const Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
+    const Uint8* pixel = m_pixels + (x + y * m_size.x) * 4;
     return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
 }
 
@@ -287,9 +372,9 @@ Color Image::getPixel(unsigned int x, unsigned int y) const
 ////////////////////////////////////////////////////////////
 const Uint8* Image::getPixelsPtr() const
 {
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
-        return &m_pixels[0];
+        return m_pixels;
     }
     else
     {
@@ -302,23 +387,12 @@ const Uint8* Image::getPixelsPtr() const
 ////////////////////////////////////////////////////////////
 void Image::flipHorizontally()
 {
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
         std::size_t rowSize = m_size.x * 4;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
-        }
+            priv::ImageKernels::reverse(m_pixels + y * rowSize, m_size.x);
     }
 }
 
@@ -326,12 +400,12 @@ void Image::flipHorizontally()
 ////////////////////////////////////////////////////////////
 void Image::flipVertically()
 {
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
         std::size_t rowSize = m_size.x * 4;
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        Uint8* top = m_pixels;
+        Uint8* bottom = m_pixels + (m_size.y - 1) * rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
@@ -343,4 +417,19 @@ void Image::flipVertically()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Image::adopt(unsigned int width, unsigned int height, Uint8* pixels, PixelDeleter deleter, void* userData)
+{
+    // Release the current pixels
+    if (m_pixels && m_deleter)
+        m_deleter(m_pixels, m_userData);
+
+    m_size.x   = pixels ? width : 0;
+    m_size.y   = pixels ? height : 0;
+    m_pixels   = pixels;
+    m_deleter  = deleter;
+    m_userData = userData;
+}
+
 } // namespace sf
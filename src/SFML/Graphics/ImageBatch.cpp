@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageBatch.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <sstream>
+#ifdef SFML_SYSTEM_ANDROID
+    #include <SFML/System/Android/ResourceStream.hpp>
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageBatch::ImageBatch() :
+m_items         (),
+m_threads       (),
+m_nextItem      (0),
+m_completedItems(0),
+m_runningThreads(0),
+m_errors        (),
+m_emptyImage    (),
+m_mutex         ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+ImageBatch::~ImageBatch()
+{
+    wait();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatch::addFromFile(const std::string& filename)
+{
+    Item item;
+    item.source = Item::File;
+    item.filename = filename;
+
+    return addItem(item);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatch::addFromMemory(const void* data, std::size_t size)
+{
+    Item item;
+    item.source = Item::Memory;
+    item.data = data;
+    item.size = size;
+
+    return addItem(item);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatch::addFromStream(InputStream& stream)
+{
+    Item item;
+    item.source = Item::Stream;
+    item.stream = &stream;
+
+    return addItem(item);
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatch::launch(unsigned int threadCount)
+{
+    // Let the previous workers finish first
+    wait();
+
+    // Don't start more workers than there are images to load
+    unsigned int workerCount;
+    {
+        Lock lock(m_mutex);
+        std::size_t pendingItems = m_items.size() - m_nextItem;
+        workerCount = static_cast<unsigned int>(std::min<std::size_t>(std::max(threadCount, 1u), pendingItems));
+        m_runningThreads = workerCount;
+    }
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        Thread* thread = new Thread(&ImageBatch::loadImages, this);
+        m_threads.push_back(thread);
+        thread->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatch::wait()
+{
+    for (std::vector<Thread*>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    m_threads.clear();
+
+    reportErrors();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageBatch::isLoading() const
+{
+    Lock lock(m_mutex);
+
+    reportErrors();
+
+    return m_runningThreads > 0;
+}
+
+
+////////////////////////////////////////////////////////////
+float ImageBatch::getProgress() const
+{
+    Lock lock(m_mutex);
+
+    reportErrors();
+
+    if (m_items.empty())
+        return 1.f;
+
+    return static_cast<float>(m_completedItems) / static_cast<float>(m_items.size());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatch::getImageCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_items.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageBatch::isLoaded(std::size_t index) const
+{
+    Lock lock(m_mutex);
+
+    return (index < m_items.size()) && (m_items[index].status == Item::Loaded);
+}
+
+
+////////////////////////////////////////////////////////////
+Image& ImageBatch::getImage(std::size_t index)
+{
+    Lock lock(m_mutex);
+
+    // A worker may still be decoding into an image that is not loaded yet
+    if ((index >= m_items.size()) || (m_items[index].status != Item::Loaded))
+    {
+        m_emptyImage = Image();
+        return m_emptyImage;
+    }
+
+    return m_items[index].image;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatch::clear()
+{
+    wait();
+
+    Lock lock(m_mutex);
+
+    m_items.clear();
+    m_nextItem = 0;
+    m_completedItems = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatch::loadImages()
+{
+    for (;;)
+    {
+        // Take the next pending item; references to the elements of a
+        // deque stay valid while other items are added at its end
+        Item* item;
+        {
+            Lock lock(m_mutex);
+
+            if (m_nextItem == m_items.size())
+            {
+                --m_runningThreads;
+                return;
+            }
+
+            item = &m_items[m_nextItem++];
+        }
+
+        // Decode the image without holding the lock; sf::err() is not
+        // thread-safe, so the error messages are collected for the calling thread
+        priv::ImageLoader& loader = priv::ImageLoader::getInstance();
+        std::ostringstream errors;
+        bool loaded = false;
+        switch (item->source)
+        {
+            case Item::File:
+            {
+                #ifndef SFML_SYSTEM_ANDROID
+
+                    loaded = loader.loadImageFromFile(item->filename, item->image, errors);
+
+                #else
+
+                    priv::ResourceStream stream(item->filename);
+                    loaded = loader.loadImageFromStream(stream, item->image, errors);
+
+                #endif
+                break;
+            }
+
+            case Item::Memory: loaded = loader.loadImageFromMemory(item->data, item->size, item->image, errors); break;
+            case Item::Stream: loaded = loader.loadImageFromStream(*item->stream, item->image, errors);          break;
+        }
+
+        {
+            Lock lock(m_mutex);
+
+            item->status = loaded ? Item::Loaded : Item::Failed;
+            m_errors += errors.str();
+            ++m_completedItems;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatch::reportErrors() const
+{
+    Lock lock(m_mutex);
+
+    if (!m_errors.empty())
+    {
+        err() << m_errors << std::flush;
+        m_errors.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatch::addItem(const Item& item)
+{
+    Lock lock(m_mutex);
+
+    m_items.push_back(item);
+
+    return m_items.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+ImageBatch::Item::Item() :
+source  (File),
+status  (Pending),
+filename(),
+data    (NULL),
+size    (0),
+stream  (NULL),
+image   ()
+{
+
+}
+
+} // namespace sf
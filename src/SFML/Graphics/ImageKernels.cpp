@@ -0,0 +1,454 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/Graphics/Simd.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Pack a color into a 32-bits value with the same memory layout as an RGBA pixel
+    sf::Uint32 packColor(sf::Uint8 r, sf::Uint8 g, sf::Uint8 b, sf::Uint8 a)
+    {
+        sf::Uint8 bytes[4] = {r, g, b, a};
+        sf::Uint32 value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    // Scalar blending of a single pixel, the reference for the vector paths
+    void blendPixel(sf::Uint8* dst, const sf::Uint8* src)
+    {
+        unsigned int alpha = src[3];
+        dst[0] = static_cast<sf::Uint8>((src[0] * alpha + dst[0] * (255 - alpha)) / 255);
+        dst[1] = static_cast<sf::Uint8>((src[1] * alpha + dst[1] * (255 - alpha)) / 255);
+        dst[2] = static_cast<sf::Uint8>((src[2] * alpha + dst[2] * (255 - alpha)) / 255);
+        dst[3] = static_cast<sf::Uint8>(alpha + dst[3] * (255 - alpha) / 255);
+    }
+
+    // Scalar premultiplication of a single channel, rounded to nearest
+    sf::Uint8 premultiply(unsigned int value, unsigned int alpha)
+    {
+        return static_cast<sf::Uint8>((value * alpha + 127) / 255);
+    }
+
+#if defined(SFML_GRAPHICS_SSE2)
+
+    // Divide eight 16-bits values by 255, rounded down (exact for all inputs up to 65535)
+    __m128i divide255(__m128i x)
+    {
+        x = _mm_add_epi16(x, _mm_set1_epi16(1));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Divide eight 16-bits values by 255, rounded to nearest (exact for all inputs up to 65025)
+    __m128i divide255Rounded(__m128i x)
+    {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Broadcast the alpha channel of two 16-bits-per-channel pixels to all their channels
+    __m128i broadcastAlpha(__m128i x)
+    {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    // Replace the alpha multiplier of two pixels by 255, so that the alpha channel keeps its value
+    __m128i colorMultiplier(__m128i alpha)
+    {
+        const __m128i colorMask  = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+        const __m128i alphaScale = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+        return _mm_or_si128(_mm_and_si128(alpha, colorMask), alphaScale);
+    }
+
+    // Blend two 16-bits-per-channel source pixels over two destination pixels
+    __m128i blendHalf(__m128i dst, __m128i src)
+    {
+        __m128i alpha   = broadcastAlpha(src);
+        __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        __m128i sum     = _mm_add_epi16(_mm_mullo_epi16(src, colorMultiplier(alpha)), _mm_mullo_epi16(dst, inverse));
+        return divide255(sum);
+    }
+
+#elif defined(SFML_GRAPHICS_NEON)
+
+    // Divide eight 16-bits values by 255, rounded down, and narrow them to 8 bits
+    uint8x8_t divide255(uint16x8_t x)
+    {
+        x = vaddq_u16(x, vdupq_n_u16(1));
+        return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+    }
+
+    // Divide eight 16-bits values by 255, rounded to nearest, and narrow them to 8 bits
+    uint8x8_t divide255Rounded(uint16x8_t x)
+    {
+        x = vaddq_u16(x, vdupq_n_u16(128));
+        return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+    }
+
+    // Compute (src * alpha + dst * inverse) / 255 for sixteen channels
+    uint8x16_t blendChannel(uint8x16_t dst, uint8x16_t src, uint8x16_t alpha, uint8x16_t inverse)
+    {
+        uint16x8_t low  = vmlal_u8(vmull_u8(vget_low_u8(src), vget_low_u8(alpha)), vget_low_u8(dst), vget_low_u8(inverse));
+        uint16x8_t high = vmlal_u8(vmull_u8(vget_high_u8(src), vget_high_u8(alpha)), vget_high_u8(dst), vget_high_u8(inverse));
+        return vcombine_u8(divide255(low), divide255(high));
+    }
+
+    // Compute value * alpha / 255, rounded to nearest, for sixteen channels
+    uint8x16_t premultiplyChannel(uint8x16_t value, uint8x16_t alpha)
+    {
+        uint16x8_t low  = vmull_u8(vget_low_u8(value), vget_low_u8(alpha));
+        uint16x8_t high = vmull_u8(vget_high_u8(value), vget_high_u8(alpha));
+        return vcombine_u8(divide255Rounded(low), divide255Rounded(high));
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+namespace ImageKernels
+{
+////////////////////////////////////////////////////////////
+void fill(Uint8* pixels, std::size_t count, const Color& color)
+{
+    Uint32 value = packColor(color.r, color.g, color.b, color.a);
+    std::size_t i = 0;
+
+#if defined(SFML_GRAPHICS_SSE2)
+
+    __m128i vector = _mm_set1_epi32(static_cast<int>(value));
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), vector);
+
+#elif defined(SFML_GRAPHICS_NEON)
+
+    uint8x16_t vector = vreinterpretq_u8_u32(vdupq_n_u32(value));
+    for (; i + 4 <= count; i += 4)
+        vst1q_u8(pixels + i * 4, vector);
+
+#endif
+
+    for (; i < count; ++i)
+        std::memcpy(pixels + i * 4, &value, sizeof(value));
+}
+
+
+////////////////////////////////////////////////////////////
+void maskColor(Uint8* pixels, std::size_t count, const Color& color, Uint8 alpha)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_GRAPHICS_SSE2)
+
+    const __m128i key       = _mm_set1_epi32(static_cast<int>(packColor(color.r, color.g, color.b, color.a)));
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(packColor(0, 0, 0, 255)));
+    const __m128i newAlpha  = _mm_set1_epi32(static_cast<int>(packColor(0, 0, 0, alpha)));
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* ptr   = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  value = _mm_loadu_si128(ptr);
+        __m128i  mask  = _mm_and_si128(_mm_cmpeq_epi32(value, key), alphaMask);
+        _mm_storeu_si128(ptr, _mm_or_si128(_mm_andnot_si128(mask, value), _mm_and_si128(mask, newAlpha)));
+    }
+
+#elif defined(SFML_GRAPHICS_NEON)
+
+    const uint8x16_t newAlpha = vdupq_n_u8(alpha);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t value = vld4q_u8(pixels + i * 4);
+        uint8x16_t   red   = vceqq_u8(value.val[0], vdupq_n_u8(color.r));
+        uint8x16_t   green = vceqq_u8(value.val[1], vdupq_n_u8(color.g));
+        uint8x16_t   blue  = vceqq_u8(value.val[2], vdupq_n_u8(color.b));
+        uint8x16_t   match = vceqq_u8(value.val[3], vdupq_n_u8(color.a));
+        match = vandq_u8(vandq_u8(red, green), vandq_u8(blue, match));
+        value.val[3] = vbslq_u8(match, newAlpha, value.val[3]);
+        vst4q_u8(pixels + i * 4, value);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
+            ptr[3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void blend(Uint8* destination, const Uint8* source, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_GRAPHICS_SSE2)
+
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* dstPtr = reinterpret_cast<__m128i*>(destination + i * 4);
+        __m128i  src    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+        __m128i  dst    = _mm_loadu_si128(dstPtr);
+        __m128i  low    = blendHalf(_mm_unpacklo_epi8(dst, zero), _mm_unpacklo_epi8(src, zero));
+        __m128i  high   = blendHalf(_mm_unpackhi_epi8(dst, zero), _mm_unpackhi_epi8(src, zero));
+        _mm_storeu_si128(dstPtr, _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_GRAPHICS_NEON)
+
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t src     = vld4q_u8(source + i * 4);
+        uint8x16x4_t dst     = vld4q_u8(destination + i * 4);
+        uint8x16_t   alpha   = src.val[3];
+        uint8x16_t   inverse = vmvnq_u8(alpha);
+        dst.val[0] = blendChannel(dst.val[0], src.val[0], alpha, inverse);
+        dst.val[1] = blendChannel(dst.val[1], src.val[1], alpha, inverse);
+        dst.val[2] = blendChannel(dst.val[2], src.val[2], alpha, inverse);
+        dst.val[3] = vaddq_u8(alpha, blendChannel(dst.val[3], vdupq_n_u8(0), alpha, inverse));
+        vst4q_u8(destination + i * 4, dst);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+        blendPixel(destination + i * 4, source + i * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void blend(Uint8* destination, std::size_t count, const Color& color)
+{
+    // Blend by chunks against a small buffer filled with the color
+    const std::size_t chunkSize = 64;
+    Uint8 source[chunkSize * 4];
+    fill(source, std::min(count, chunkSize), color);
+
+    for (std::size_t i = 0; i < count; i += chunkSize)
+        blend(destination + i * 4, source, std::min(count - i, chunkSize));
+}
+
+
+////////////////////////////////////////////////////////////
+void premultiplyAlpha(Uint8* pixels, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_GRAPHICS_SSE2)
+
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* ptr   = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  value = _mm_loadu_si128(ptr);
+        __m128i  low   = _mm_unpacklo_epi8(value, zero);
+        __m128i  high  = _mm_unpackhi_epi8(value, zero);
+        low  = divide255Rounded(_mm_mullo_epi16(low, colorMultiplier(broadcastAlpha(low))));
+        high = divide255Rounded(_mm_mullo_epi16(high, colorMultiplier(broadcastAlpha(high))));
+        _mm_storeu_si128(ptr, _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_GRAPHICS_NEON)
+
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t value = vld4q_u8(pixels + i * 4);
+        value.val[0] = premultiplyChannel(value.val[0], value.val[3]);
+        value.val[1] = premultiplyChannel(value.val[1], value.val[3]);
+        value.val[2] = premultiplyChannel(value.val[2], value.val[3]);
+        vst4q_u8(pixels + i * 4, value);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        ptr[0] = premultiply(ptr[0], ptr[3]);
+        ptr[1] = premultiply(ptr[1], ptr[3]);
+        ptr[2] = premultiply(ptr[2], ptr[3]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void swizzle(Uint8* pixels, std::size_t count, unsigned int red, unsigned int green, unsigned int blue, unsigned int alpha)
+{
+    const unsigned int channels[4] = {red & 3, green & 3, blue & 3, alpha & 3};
+    std::size_t i = 0;
+
+#if defined(SFML_GRAPHICS_SSE2)
+
+    // Move each byte of the 32-bits pixels with shifts by run-time amounts
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    __m128i       sourceShifts[4];
+    __m128i       targetShifts[4];
+    for (int c = 0; c < 4; ++c)
+    {
+        sourceShifts[c] = _mm_cvtsi32_si128(static_cast<int>(channels[c] * 8));
+        targetShifts[c] = _mm_cvtsi32_si128(c * 8);
+    }
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* ptr    = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  value  = _mm_loadu_si128(ptr);
+        __m128i  result = _mm_setzero_si128();
+        for (int c = 0; c < 4; ++c)
+        {
+            __m128i channel = _mm_and_si128(_mm_srl_epi32(value, sourceShifts[c]), byteMask);
+            result = _mm_or_si128(result, _mm_sll_epi32(channel, targetShifts[c]));
+        }
+        _mm_storeu_si128(ptr, result);
+    }
+
+#elif defined(SFML_GRAPHICS_NEON)
+
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t value = vld4q_u8(pixels + i * 4);
+        uint8x16x4_t result;
+        for (int c = 0; c < 4; ++c)
+            result.val[c] = value.val[channels[c]];
+        vst4q_u8(pixels + i * 4, result);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        Uint8 value[4] = {ptr[0], ptr[1], ptr[2], ptr[3]};
+        for (int c = 0; c < 4; ++c)
+            ptr[c] = value[channels[c]];
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reverse(Uint8* pixels, std::size_t count)
+{
+    Uint8* left  = pixels;
+    Uint8* right = pixels + count * 4;
+
+#if defined(SFML_GRAPHICS_SSE2)
+
+    // Swap blocks of four pixels from both ends while they don't overlap
+    while (right - left >= 32)
+    {
+        right -= 16;
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+        __m128i last  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left), _mm_shuffle_epi32(last, _MM_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(first, _MM_SHUFFLE(0, 1, 2, 3)));
+        left += 16;
+    }
+
+#elif defined(SFML_GRAPHICS_NEON)
+
+    // Swap blocks of four pixels from both ends while they don't overlap
+    while (right - left >= 32)
+    {
+        right -= 16;
+        uint32x4_t first = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(left)));
+        uint32x4_t last  = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(right)));
+        vst1q_u8(left, vreinterpretq_u8_u32(vextq_u32(last, last, 2)));
+        vst1q_u8(right, vreinterpretq_u8_u32(vextq_u32(first, first, 2)));
+        left += 16;
+    }
+
+#endif
+
+    while (right - left >= 8)
+    {
+        right -= 4;
+        std::swap_ranges(left, left + 4, right);
+        left += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void expandAlpha(Uint8* destination, const Uint8* alpha, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_GRAPHICS_SSE2)
+
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i white = _mm_set1_epi32(static_cast<int>(packColor(255, 255, 255, 0)));
+    for (; i + 16 <= count; i += 16)
+    {
+        // Interleave the alpha values with zeros so that they land in the last byte of each pixel
+        __m128i  value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha + i));
+        __m128i  low   = _mm_unpacklo_epi8(zero, value);
+        __m128i  high  = _mm_unpackhi_epi8(zero, value);
+        __m128i* ptr   = reinterpret_cast<__m128i*>(destination + i * 4);
+        _mm_storeu_si128(ptr + 0, _mm_or_si128(_mm_unpacklo_epi16(zero, low), white));
+        _mm_storeu_si128(ptr + 1, _mm_or_si128(_mm_unpackhi_epi16(zero, low), white));
+        _mm_storeu_si128(ptr + 2, _mm_or_si128(_mm_unpacklo_epi16(zero, high), white));
+        _mm_storeu_si128(ptr + 3, _mm_or_si128(_mm_unpackhi_epi16(zero, high), white));
+    }
+
+#elif defined(SFML_GRAPHICS_NEON)
+
+    uint8x16x4_t value;
+    value.val[0] = vdupq_n_u8(255);
+    value.val[1] = value.val[0];
+    value.val[2] = value.val[0];
+    for (; i + 16 <= count; i += 16)
+    {
+        value.val[3] = vld1q_u8(alpha + i);
+        vst4q_u8(destination + i * 4, value);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = destination + i * 4;
+        ptr[0] = 255;
+        ptr[1] = 255;
+        ptr[2] = 255;
+        ptr[3] = alpha[i];
+    }
+}
+
+} // namespace ImageKernels
+
+} // namespace priv
+
+} // namespace sf
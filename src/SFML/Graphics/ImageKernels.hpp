@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEKERNELS_HPP
+#define SFML_IMAGEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pixel processing routines for arrays of RGBA pixels
+///
+/// These kernels work on tightly packed 32-bits RGBA pixels,
+/// as stored by sf::Image. They use SSE2 or NEON instructions
+/// when the target supports them, and fall back to plain
+/// scalar code otherwise; all paths produce identical results.
+///
+////////////////////////////////////////////////////////////
+namespace ImageKernels
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill pixels with a single color
+    ///
+    /// \param pixels Pixels to fill
+    /// \param count  Number of pixels
+    /// \param color  Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    void fill(Uint8* pixels, std::size_t count, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the alpha of the pixels matching a color
+    ///
+    /// \param pixels Pixels to modify
+    /// \param count  Number of pixels
+    /// \param color  Color to look for
+    /// \param alpha  Alpha value to assign to matching pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void maskColor(Uint8* pixels, std::size_t count, const Color& color, Uint8 alpha);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blend source pixels over destination pixels
+    ///
+    /// The result is the same as the one of sf::Image::copy
+    /// with \a applyAlpha set to true.
+    ///
+    /// \param destination Pixels to blend onto
+    /// \param source      Pixels to blend
+    /// \param count       Number of pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void blend(Uint8* destination, const Uint8* source, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blend a single color over destination pixels
+    ///
+    /// \param destination Pixels to blend onto
+    /// \param count       Number of pixels
+    /// \param color       Color to blend
+    ///
+    ////////////////////////////////////////////////////////////
+    void blend(Uint8* destination, std::size_t count, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color channels of pixels by their alpha
+    ///
+    /// \param pixels Pixels to modify
+    /// \param count  Number of pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha(Uint8* pixels, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reorder the channels of pixels
+    ///
+    /// Each index is the channel of the original pixel (0 to 3)
+    /// that is written to the corresponding output channel.
+    ///
+    /// \param pixels Pixels to modify
+    /// \param count  Number of pixels
+    /// \param red    Source channel of the red component
+    /// \param green  Source channel of the green component
+    /// \param blue   Source channel of the blue component
+    /// \param alpha  Source channel of the alpha component
+    ///
+    ////////////////////////////////////////////////////////////
+    void swizzle(Uint8* pixels, std::size_t count, unsigned int red, unsigned int green, unsigned int blue, unsigned int alpha);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reverse the order of pixels
+    ///
+    /// \param pixels Pixels to reverse
+    /// \param count  Number of pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void reverse(Uint8* pixels, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Expand 8-bits alpha values to white RGBA pixels
+    ///
+    /// \param destination Pixels to write
+    /// \param alpha       Alpha values to read
+    /// \param count       Number of pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void expandAlpha(Uint8* destination, const Uint8* alpha, std::size_t count);
+
+} // namespace ImageKernels
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEKERNELS_HPP
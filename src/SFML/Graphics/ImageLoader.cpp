@@ -26,6 +26,10 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
 #define STB_IMAGE_IMPLEMENTATION
@@ -63,6 +67,12 @@ namespace
         return stream->tell() >= stream->getSize();
     }
 
+    // Release pixels decoded by stb_image
+    void freePixels(sf::Uint8* pixels, void*)
+    {
+        stbi_image_free(pixels);
+    }
+
     // stb_image callback for constructing a buffer
     void bufferFromCallback(void* context, void* data, int size)
     {
@@ -70,6 +80,17 @@ namespace
         std::vector<sf::Uint8>* dest = static_cast<std::vector<sf::Uint8>*>(context);
         std::copy(source, source + size, std::back_inserter(*dest));
     }
+
+    // Decode the blocks of a DDS or KTX file
+    bool loadCompressedImage(sf::InputStream& stream, sf::Image& image, std::ostream& errors)
+    {
+        sf::priv::CompressedImage compressed;
+        if (!compressed.loadFromStream(stream, errors))
+            return false;
+
+        compressed.decompress(image);
+        return true;
+    }
 }
 
 
@@ -101,10 +122,12 @@ ImageLoader::~ImageLoader()
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromFile(const std::string& filename, Image& image, std::ostream& errors)
 {
-    // Clear the array (just in case)
-    pixels.clear();
+    // Block-compressed files are decoded by hand, stb_image doesn't support them
+    FileInputStream stream;
+    if (stream.open(filename) && CompressedImage::isCompressed(stream))
+        return loadCompressedImage(stream, image, errors);
 
     // Load the image and get a pointer to the pixels in memory
     int width = 0;
@@ -114,26 +137,15 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
 
     if (ptr)
     {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        // Hand the loaded pixels over to the image, which will free them
+        image.create(width, height, ptr, &freePixels);
 
         return true;
     }
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
+        errors << "Failed to load image \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
 
         return false;
     }
@@ -141,13 +153,18 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, Image& image, std::ostream& errors)
 {
     // Check input parameters
     if (data && dataSize)
     {
-        // Clear the array (just in case)
-        pixels.clear();
+        // Block-compressed files are decoded by hand, stb_image doesn't support them
+        if (CompressedImage::isCompressed(data, dataSize))
+        {
+            MemoryInputStream stream;
+            stream.open(data, dataSize);
+            return loadCompressedImage(stream, image, errors);
+        }
 
         // Load the image and get a pointer to the pixels in memory
         int width = 0;
@@ -158,47 +175,37 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
 
         if (ptr)
         {
-            // Assign the image properties
-            size.x = width;
-            size.y = height;
-
-            if (width && height)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(width * height * 4);
-                memcpy(&pixels[0], ptr, pixels.size());
-            }
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
+            // Hand the loaded pixels over to the image, which will free them
+            image.create(width, height, ptr, &freePixels);
 
             return true;
         }
         else
         {
             // Error, failed to load the image
-            err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
+            errors << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
 
             return false;
         }
     }
     else
     {
-        err() << "Failed to load image from memory, no data provided" << std::endl;
+        errors << "Failed to load image from memory, no data provided" << std::endl;
         return false;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromStream(InputStream& stream, Image& image, std::ostream& errors)
 {
-    // Clear the array (just in case)
-    pixels.clear();
-
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
 
+    // Block-compressed files are decoded by hand, stb_image doesn't support them
+    if (CompressedImage::isCompressed(stream))
+        return loadCompressedImage(stream, image, errors);
+
     // Setup the stb_image callbacks
     stbi_io_callbacks callbacks;
     callbacks.read = &read;
@@ -213,26 +220,15 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
     if (ptr)
     {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        // Hand the loaded pixels over to the image, which will free them
+        image.create(width, height, ptr, &freePixels);
 
         return true;
     }
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
+        errors << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
 
         return false;
     }
@@ -240,10 +236,10 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToFile(const std::string& filename, const Uint8* pixels, const Vector2u& size)
 {
     // Make sure the image is not empty
-    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
+    if (pixels && (size.x > 0) && (size.y > 0))
     {
         // Deduce the image type from its extension
 
@@ -254,25 +250,25 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
         if (extension == "bmp")
         {
             // BMP format
-            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, pixels))
                 return true;
         }
         else if (extension == "tga")
         {
             // TGA format
-            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, pixels))
                 return true;
         }
         else if (extension == "png")
         {
             // PNG format
-            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
+            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, pixels, 0))
                 return true;
         }
         else if (extension == "jpg" || extension == "jpeg")
         {
             // JPG format
-            if (stbi_write_jpg(filename.c_str(), size.x, size.y, 4, &pixels[0], 90))
+            if (stbi_write_jpg(filename.c_str(), size.x, size.y, 4, pixels, 90))
                 return true;
         }
     }
@@ -282,10 +278,10 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
 }
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<sf::Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<sf::Uint8>& output, const Uint8* pixels, const Vector2u& size)
 {
     // Make sure the image is not empty
-    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
+    if (pixels && (size.x > 0) && (size.y > 0))
     {
         // Choose function based on format
 
@@ -294,25 +290,25 @@ bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<sf::U
         if (specified == "bmp")
         {
             // BMP format
-            if (stbi_write_bmp_to_func(&bufferFromCallback, &output, size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_bmp_to_func(&bufferFromCallback, &output, size.x, size.y, 4, pixels))
                 return true;
         }
         else if (specified == "tga")
         {
             // TGA format
-            if (stbi_write_tga_to_func(&bufferFromCallback, &output, size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_tga_to_func(&bufferFromCallback, &output, size.x, size.y, 4, pixels))
                 return true;
         }
         else if (specified == "png")
         {
             // PNG format
-            if (stbi_write_png_to_func(&bufferFromCallback, &output, size.x, size.y, 4, &pixels[0], 0))
+            if (stbi_write_png_to_func(&bufferFromCallback, &output, size.x, size.y, 4, pixels, 0))
                 return true;
         }
         else if (specified == "jpg" || specified == "jpeg")
         {
             // JPG format
-            if (stbi_write_jpg_to_func(&bufferFromCallback, &output, size.x, size.y, 4, &pixels[0], 90))
+            if (stbi_write_jpg_to_func(&bufferFromCallback, &output, size.x, size.y, 4, pixels, 90))
                 return true;
         }
     }
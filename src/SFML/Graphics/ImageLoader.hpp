@@ -30,12 +30,14 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <iosfwd>
 #include <string>
 #include <vector>
 
 
 namespace sf
 {
+class Image;
 class InputStream;
 
 namespace priv
@@ -59,39 +61,48 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file on disk
     ///
+    /// The decoded pixels are adopted by \a image without
+    /// being copied. If loading fails, \a image is left unchanged.
+    ///
     /// \param filename Path of image file to load
-    /// \param pixels   Array of pixels to fill with loaded image
-    /// \param size     Size of loaded image, in pixels
+    /// \param image    Image to fill with the loaded pixels
+    /// \param errors   Stream that receives the error messages
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromFile(const std::string& filename, Image& image, std::ostream& errors);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file in memory
     ///
+    /// The decoded pixels are adopted by \a image without
+    /// being copied. If loading fails, \a image is left unchanged.
+    ///
     /// \param data     Pointer to the file data in memory
     /// \param dataSize Size of the data to load, in bytes
-    /// \param pixels   Array of pixels to fill with loaded image
-    /// \param size     Size of loaded image, in pixels
+    /// \param image    Image to fill with the loaded pixels
+    /// \param errors   Stream that receives the error messages
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, Image& image, std::ostream& errors);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a custom stream
     ///
+    /// The decoded pixels are adopted by \a image without
+    /// being copied. If loading fails, \a image is left unchanged.
+    ///
     /// \param stream Source stream to read from
-    /// \param pixels Array of pixels to fill with loaded image
-    /// \param size   Size of loaded image, in pixels
+    /// \param image  Image to fill with the loaded pixels
+    /// \param errors Stream that receives the error messages
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromStream(InputStream& stream, Image& image, std::ostream& errors);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
@@ -103,7 +114,7 @@ public:
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToFile(const std::string& filename, const Uint8* pixels, const Vector2u& size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an encoded image buffer
@@ -116,7 +127,7 @@ public:
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToMemory(const std::string& format, std::vector<sf::Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToMemory(const std::string& format, std::vector<sf::Uint8>& output, const Uint8* pixels, const Vector2u& size);
 
 private:
 
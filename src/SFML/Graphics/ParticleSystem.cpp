@@ -0,0 +1,445 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Simd.hpp>
+#include <SFML/Graphics/StreamingVertexBuffer.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Move the particles and decrease their lifetime; the vector paths
+    // use the same operations in the same order as the scalar one, but
+    // the compiler may fuse the scalar multiply-add (as GCC does on ARM),
+    // so the results of both paths can differ in their last bits
+    void integrate(float* x, float* y, float* vx, float* vy, float* lifetimes, std::size_t count,
+                   float ax, float ay, float dt)
+    {
+        const float dvx = ax * dt;
+        const float dvy = ay * dt;
+
+        std::size_t i = 0;
+
+    #if defined(SFML_GRAPHICS_SSE2)
+
+        const __m128 dt4  = _mm_set1_ps(dt);
+        const __m128 dvx4 = _mm_set1_ps(dvx);
+        const __m128 dvy4 = _mm_set1_ps(dvy);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 velocityX = _mm_add_ps(_mm_loadu_ps(vx + i), dvx4);
+            __m128 velocityY = _mm_add_ps(_mm_loadu_ps(vy + i), dvy4);
+            _mm_storeu_ps(vx + i, velocityX);
+            _mm_storeu_ps(vy + i, velocityY);
+            _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(velocityX, dt4)));
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(velocityY, dt4)));
+            _mm_storeu_ps(lifetimes + i, _mm_sub_ps(_mm_loadu_ps(lifetimes + i), dt4));
+        }
+
+    #elif defined(SFML_GRAPHICS_NEON)
+
+        const float32x4_t dt4  = vdupq_n_f32(dt);
+        const float32x4_t dvx4 = vdupq_n_f32(dvx);
+        const float32x4_t dvy4 = vdupq_n_f32(dvy);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t velocityX = vaddq_f32(vld1q_f32(vx + i), dvx4);
+            float32x4_t velocityY = vaddq_f32(vld1q_f32(vy + i), dvy4);
+            vst1q_f32(vx + i, velocityX);
+            vst1q_f32(vy + i, velocityY);
+            vst1q_f32(x + i, vaddq_f32(vld1q_f32(x + i), vmulq_f32(velocityX, dt4)));
+            vst1q_f32(y + i, vaddq_f32(vld1q_f32(y + i), vmulq_f32(velocityY, dt4)));
+            vst1q_f32(lifetimes + i, vsubq_f32(vld1q_f32(lifetimes + i), dt4));
+        }
+
+    #endif
+
+        // Remaining particles (or all of them without SIMD support)
+        for (; i < count; ++i)
+        {
+            vx[i] = vx[i] + dvx;
+            vy[i] = vy[i] + dvy;
+            x[i] = x[i] + vx[i] * dt;
+            y[i] = y[i] + vy[i] * dt;
+            lifetimes[i] = lifetimes[i] - dt;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem() :
+m_texture      (NULL),
+m_textureRect  (),
+m_particleSize (1.f, 1.f),
+m_acceleration (0.f, 0.f),
+m_fading       (true),
+m_positionsX   (),
+m_positionsY   (),
+m_velocitiesX  (),
+m_velocitiesY  (),
+m_lifetimes    (),
+m_fadeFactors  (),
+m_colors       (),
+m_vertices     (),
+m_buffer       (NULL),
+m_needUpdate   (false),
+m_uploadedBytes(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem(const ParticleSystem& copy) :
+Drawable       (copy),
+Transformable  (copy),
+m_texture      (copy.m_texture),
+m_textureRect  (copy.m_textureRect),
+m_particleSize (copy.m_particleSize),
+m_acceleration (copy.m_acceleration),
+m_fading       (copy.m_fading),
+m_positionsX   (copy.m_positionsX),
+m_positionsY   (copy.m_positionsY),
+m_velocitiesX  (copy.m_velocitiesX),
+m_velocitiesY  (copy.m_velocitiesY),
+m_lifetimes    (copy.m_lifetimes),
+m_fadeFactors  (copy.m_fadeFactors),
+m_colors       (copy.m_colors),
+m_vertices     (),
+m_buffer       (NULL),
+m_needUpdate   (true),
+m_uploadedBytes(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::~ParticleSystem()
+{
+    delete m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem& ParticleSystem::operator =(const ParticleSystem& right)
+{
+    // The vertex buffers, if any, are kept, the copied particles are uploaded on the next draw
+    Transformable::operator =(right);
+    m_texture      = right.m_texture;
+    m_textureRect  = right.m_textureRect;
+    m_particleSize = right.m_particleSize;
+    m_acceleration = right.m_acceleration;
+    m_fading       = right.m_fading;
+    m_positionsX   = right.m_positionsX;
+    m_positionsY   = right.m_positionsY;
+    m_velocitiesX  = right.m_velocitiesX;
+    m_velocitiesY  = right.m_velocitiesY;
+    m_lifetimes    = right.m_lifetimes;
+    m_fadeFactors  = right.m_fadeFactors;
+    m_colors       = right.m_colors;
+    m_needUpdate   = true;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTexture(const Texture* texture, bool resetRect)
+{
+    // Recompute the texture area if requested, or if there was no valid texture & rect before
+    if (texture && (resetRect || (!m_texture && (m_textureRect == IntRect()))))
+        setTextureRect(IntRect(0, 0, texture->getSize().x, texture->getSize().y));
+
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* ParticleSystem::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTextureRect(const IntRect& rect)
+{
+    if (rect != m_textureRect)
+    {
+        m_textureRect = rect;
+        m_needUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& ParticleSystem::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setParticleSize(const Vector2f& size)
+{
+    if (size != m_particleSize)
+    {
+        m_particleSize = size;
+        m_needUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getParticleSize() const
+{
+    return m_particleSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setAcceleration(const Vector2f& acceleration)
+{
+    m_acceleration = acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getAcceleration() const
+{
+    return m_acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setFadingEnabled(bool enabled)
+{
+    if (enabled != m_fading)
+    {
+        m_fading = enabled;
+        m_needUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ParticleSystem::isFadingEnabled() const
+{
+    return m_fading;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::reserve(std::size_t particleCount)
+{
+    m_positionsX.reserve(particleCount);
+    m_positionsY.reserve(particleCount);
+    m_velocitiesX.reserve(particleCount);
+    m_velocitiesY.reserve(particleCount);
+    m_lifetimes.reserve(particleCount);
+    m_fadeFactors.reserve(particleCount);
+    m_colors.reserve(particleCount);
+    m_vertices.reserve(particleCount * 6);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::emit(const Vector2f& position, const Vector2f& velocity, Time lifetime, const Color& color)
+{
+    float seconds = lifetime.asSeconds();
+    if (seconds <= 0.f)
+        return;
+
+    m_positionsX.push_back(position.x);
+    m_positionsY.push_back(position.y);
+    m_velocitiesX.push_back(velocity.x);
+    m_velocitiesY.push_back(velocity.y);
+    m_lifetimes.push_back(seconds);
+    m_fadeFactors.push_back(1.f / seconds);
+    m_colors.push_back(color);
+
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::clear()
+{
+    m_positionsX.clear();
+    m_positionsY.clear();
+    m_velocitiesX.clear();
+    m_velocitiesY.clear();
+    m_lifetimes.clear();
+    m_fadeFactors.clear();
+    m_colors.clear();
+
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::update(Time elapsed)
+{
+    std::size_t count = m_lifetimes.size();
+    if (count == 0)
+        return;
+
+    integrate(&m_positionsX[0], &m_positionsY[0], &m_velocitiesX[0], &m_velocitiesY[0], &m_lifetimes[0], count,
+              m_acceleration.x, m_acceleration.y, elapsed.asSeconds());
+
+    // Remove the expired particles
+    for (std::size_t i = 0; i < m_lifetimes.size();)
+    {
+        if (m_lifetimes[i] <= 0.f)
+            removeParticle(i);
+        else
+            ++i;
+    }
+
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getParticleCount() const
+{
+    return m_lifetimes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f ParticleSystem::getParticlePosition(std::size_t index) const
+{
+    return Vector2f(m_positionsX[index], m_positionsY[index]);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getUploadedByteCount() const
+{
+    return m_uploadedBytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::draw(RenderTarget& target, RenderStates states) const
+{
+    m_uploadedBytes = 0;
+
+    if (m_lifetimes.empty())
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    // The vertex buffers are created on the first draw, when a context is known to be available
+    if (!m_buffer)
+        m_buffer = new priv::StreamingVertexBuffer(Triangles);
+
+    if (m_needUpdate)
+    {
+        updateGeometry();
+
+        // If the upload fails, the vertices are drawn from system memory until the next change
+        if (m_buffer->upload(&m_vertices[0], m_vertices.size()))
+            m_uploadedBytes = m_vertices.size() * sizeof(Vertex);
+
+        m_needUpdate = false;
+    }
+
+    m_buffer->draw(target, &m_vertices[0], 0, m_vertices.size(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::updateGeometry() const
+{
+    std::size_t count = m_lifetimes.size();
+    m_vertices.resize(count * 6);
+
+    const float halfWidth  = m_particleSize.x / 2.f;
+    const float halfHeight = m_particleSize.y / 2.f;
+
+    const float u1 = static_cast<float>(m_textureRect.left);
+    const float v1 = static_cast<float>(m_textureRect.top);
+    const float u2 = u1 + m_textureRect.width;
+    const float v2 = v1 + m_textureRect.height;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float left   = m_positionsX[i] - halfWidth;
+        const float top    = m_positionsY[i] - halfHeight;
+        const float right  = m_positionsX[i] + halfWidth;
+        const float bottom = m_positionsY[i] + halfHeight;
+
+        Color color = m_colors[i];
+        if (m_fading)
+        {
+            float remaining = std::min(m_lifetimes[i] * m_fadeFactors[i], 1.f);
+            color.a = static_cast<Uint8>(color.a * remaining);
+        }
+
+        Vertex* quad = &m_vertices[i * 6];
+        quad[0] = Vertex(Vector2f(left, top),     color, Vector2f(u1, v1));
+        quad[1] = Vertex(Vector2f(left, bottom),  color, Vector2f(u1, v2));
+        quad[2] = Vertex(Vector2f(right, top),    color, Vector2f(u2, v1));
+        quad[3] = quad[2];
+        quad[4] = quad[1];
+        quad[5] = Vertex(Vector2f(right, bottom), color, Vector2f(u2, v2));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeParticle(std::size_t index)
+{
+    std::size_t last = m_lifetimes.size() - 1;
+
+    m_positionsX[index]  = m_positionsX[last];
+    m_positionsY[index]  = m_positionsY[last];
+    m_velocitiesX[index] = m_velocitiesX[last];
+    m_velocitiesY[index] = m_velocitiesY[last];
+    m_lifetimes[index]   = m_lifetimes[last];
+    m_fadeFactors[index] = m_fadeFactors[last];
+    m_colors[index]      = m_colors[last];
+
+    m_positionsX.pop_back();
+    m_positionsY.pop_back();
+    m_velocitiesX.pop_back();
+    m_velocitiesY.pop_back();
+    m_lifetimes.pop_back();
+    m_fadeFactors.pop_back();
+    m_colors.pop_back();
+}
+
+} // namespace sf
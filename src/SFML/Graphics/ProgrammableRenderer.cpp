@@ -0,0 +1,647 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ProgrammableRenderer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <set>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+
+#endif
+
+namespace
+{
+    // Initial size of the streaming vertex buffer, in vertices
+    const std::size_t initialBufferVertexCount = 16384;
+
+    // Number of user programs whose uniform locations are cached, before the cache is emptied
+    const std::size_t maxCachedPrograms = 64;
+
+    // Set to track all the active renderers
+    // This is used to free the vertex array objects of a context
+    // when it is destroyed while their renderer is still alive
+    std::set<sf::priv::ProgrammableRenderer*> renderers;
+
+    // Set to track all stale vertex array objects
+    // A vertex array object cannot be destroyed until its context
+    // becomes active, so the ones of the other contexts are kept
+    // here when their renderer is destroyed
+    std::set<std::pair<sf::Uint64, unsigned int> > staleVertexArrays;
+
+    // Mutex to protect both the renderer and the stale vertex array sets
+    sf::Mutex mutex;
+
+    // This function is called either when a renderer is destroyed
+    // or when a context is destroyed, to delete the stale vertex
+    // array objects of the current context
+    void destroyStaleVertexArrays()
+    {
+        sf::Uint64 contextId = sf::Context::getActiveContextId();
+
+        for (std::set<std::pair<sf::Uint64, unsigned int> >::iterator iter = staleVertexArrays.begin(); iter != staleVertexArrays.end();)
+        {
+            if (iter->first == contextId)
+            {
+                GLuint vertexArray = static_cast<GLuint>(iter->second);
+                glCheck(GLEXT_glDeleteVertexArrays(1, &vertexArray));
+
+                staleVertexArrays.erase(iter++);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+    // The declarations are shared by GLSL 1.30 and 1.50, only the version directive differs
+    const char* vertexShaderSource =
+        "in vec2 sf_position;\n"
+        "in vec4 sf_color;\n"
+        "in vec2 sf_texCoords;\n"
+        "uniform mat4 sf_transform;\n"
+        "uniform vec4 sf_texCoordsTransform;\n"
+        "out vec4 color;\n"
+        "out vec2 texCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_transform * vec4(sf_position, 0.0, 1.0);\n"
+        "    color = sf_color;\n"
+        "    texCoords = sf_texCoords * sf_texCoordsTransform.xy + sf_texCoordsTransform.zw;\n"
+        "}\n";
+
+    const char* fragmentShaderSource =
+        "in vec4 color;\n"
+        "in vec2 texCoords;\n"
+        "uniform sampler2D sf_texture;\n"
+        "uniform float sf_textured;\n"
+        "out vec4 sf_fragColor;\n"
+        "void main()\n"
+        "{\n"
+        "    sf_fragColor = color * mix(vec4(1.0), texture(sf_texture, texCoords), sf_textured);\n"
+        "}\n";
+
+    // Compile a shader stage of the built-in program, return 0 on failure
+    unsigned int compileShader(GLenum type, const char* source)
+    {
+        const char* sources[2] = {sf::priv::ProgrammableRenderer::getVersionDirective(), source};
+
+        unsigned int shader;
+        glCheck(shader = GLEXT_glCreateShader(type));
+        glCheck(GLEXT_glShaderSource(castToGlHandle(shader), 2, sources, NULL));
+        glCheck(GLEXT_glCompileShader(castToGlHandle(shader)));
+
+        GLint success;
+        glCheck(GLEXT_glGetShaderiv(shader, GLEXT_GL_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetShaderInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile the built-in render target shader:" << std::endl
+                      << log << std::endl;
+            glCheck(GLEXT_glDeleteShader(shader));
+            return 0;
+        }
+
+        return shader;
+    }
+
+    // Get the location of a uniform, -1 if the program doesn't use it
+    int getUniformLocation(unsigned int program, const char* name)
+    {
+        int location;
+        glCheck(location = GLEXT_glGetUniformLocation(castToGlHandle(program), name));
+        return location;
+    }
+
+    // Convert a primitive type to the corresponding OpenGL constant
+    GLenum primitiveTypeToGlConstant(sf::PrimitiveType type)
+    {
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+        return modes[type];
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ProgrammableRenderer::ProgrammableRenderer() :
+m_program            (0),
+m_locations          (),
+m_programLocations   (),
+m_texCoordsTransforms(4),
+m_buffer             (0),
+m_bufferSize         (0),
+m_bufferOffset       (0),
+m_vertexArrays       (),
+m_vertexArray        (NULL),
+m_quadVertices       ()
+{
+    Lock lock(mutex);
+
+    // Register the context destruction callback
+    registerContextDestroyCallback(contextDestroyCallback, 0);
+
+    // Insert the new renderer into the set of all active renderers
+    renderers.insert(this);
+}
+
+
+////////////////////////////////////////////////////////////
+ProgrammableRenderer::~ProgrammableRenderer()
+{
+    TransientContextLock contextLock;
+
+    {
+        Lock lock(mutex);
+
+        // Remove the renderer from the set of all active renderers
+        renderers.erase(this);
+
+        // Vertex array objects are not shared between contexts: move all of them
+        // to the stale set, the ones of the current context are destroyed right away
+        for (VertexArrayTable::iterator iter = m_vertexArrays.begin(); iter != m_vertexArrays.end(); ++iter)
+            staleVertexArrays.insert(std::make_pair(iter->first, iter->second.object));
+
+        destroyStaleVertexArrays();
+    }
+
+    if (m_buffer)
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+
+    if (m_program)
+        glCheck(GLEXT_glDeleteProgram(m_program));
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammableRenderer::isAvailable()
+{
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    return GLEXT_vertex_array_object != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::bindAttributeLocations(unsigned int program)
+{
+    glCheck(GLEXT_glBindAttribLocation(castToGlHandle(program), PositionAttribute, "sf_position"));
+    glCheck(GLEXT_glBindAttribLocation(castToGlHandle(program), ColorAttribute, "sf_color"));
+    glCheck(GLEXT_glBindAttribLocation(castToGlHandle(program), TexCoordsAttribute, "sf_texCoords"));
+}
+
+
+////////////////////////////////////////////////////////////
+const char* ProgrammableRenderer::getVersionDirective()
+{
+    // Core profiles (3.2 and later) may not accept GLSL versions older than 1.50
+    return GLEXT_GL_VERSION_3_2 ? "#version 150\n" : "#version 130\n";
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammableRenderer::create()
+{
+    TransientContextLock lock;
+
+    // Compile the built-in program
+    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
+    if (!vertexShader)
+        return false;
+
+    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
+    if (!fragmentShader)
+    {
+        glCheck(GLEXT_glDeleteShader(vertexShader));
+        return false;
+    }
+
+    unsigned int program;
+    glCheck(program = GLEXT_glCreateProgram());
+    glCheck(GLEXT_glAttachObject(castToGlHandle(program), castToGlHandle(vertexShader)));
+    glCheck(GLEXT_glAttachObject(castToGlHandle(program), castToGlHandle(fragmentShader)));
+    bindAttributeLocations(program);
+    glCheck(GLEXT_glLinkProgram(castToGlHandle(program)));
+
+    // The shaders are not needed anymore once the program is linked
+    glCheck(GLEXT_glDeleteShader(vertexShader));
+    glCheck(GLEXT_glDeleteShader(fragmentShader));
+
+    GLint success;
+    glCheck(GLEXT_glGetProgramiv(program, GLEXT_GL_LINK_STATUS, &success));
+    if (success == GL_FALSE)
+    {
+        char log[1024];
+        glCheck(GLEXT_glGetProgramInfoLog(program, sizeof(log), 0, log));
+        err() << "Failed to link the built-in render target shader:" << std::endl
+              << log << std::endl;
+        glCheck(GLEXT_glDeleteProgram(program));
+        return false;
+    }
+
+    m_program = program;
+    m_locations = getLocations(m_program);
+
+    // The sampler always reads from the first texture unit
+    glCheck(GLEXT_glUseProgram(m_program));
+    glCheck(GLEXT_glUniform1i(getUniformLocation(m_program, "sf_texture"), 0));
+    glCheck(GLEXT_glUseProgram(0));
+
+    // Create the streaming vertex buffer
+    glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+    if (!m_buffer)
+    {
+        err() << "Could not create the vertex buffer of the programmable backend, generation failed" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::resetStates()
+{
+    m_vertexArray = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::unbind()
+{
+    glCheck(GLEXT_glBindVertexArray(0));
+    glCheck(GLEXT_glUseProgram(0));
+
+    m_vertexArray = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::setTexCoordsTransform(std::size_t unit, const float* texCoordsTransform)
+{
+    if (m_texCoordsTransforms.size() < (unit + 1) * 4)
+        m_texCoordsTransforms.resize((unit + 1) * 4);
+
+    std::copy(texCoordsTransform, texCoordsTransform + 4, m_texCoordsTransforms.begin() + unit * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::setProgram(unsigned int program, Uint64 programId, const float* transform, std::size_t unitCount, bool textured)
+{
+    const Locations* locations = &m_locations;
+
+    if (program)
+    {
+        // User programs are already in use; their OpenGL identifiers may be recycled
+        // by new programs, so their locations are cached by their unique identifier
+        locations = m_programLocations.find(programId);
+        if (!locations)
+        {
+            // Forget about the programs that may not exist anymore once in a while
+            if (m_programLocations.getSize() >= maxCachedPrograms)
+                m_programLocations.clear();
+
+            locations = &m_programLocations.insert(programId, getLocations(program));
+        }
+    }
+    else
+    {
+        glCheck(GLEXT_glUseProgram(m_program));
+    }
+
+    if (locations->transform != -1)
+        glCheck(GLEXT_glUniformMatrix4fv(locations->transform, 1, GL_FALSE, transform));
+
+    if (locations->texCoordsTransform != -1)
+        glCheck(GLEXT_glUniform4fv(locations->texCoordsTransform, 1, &m_texCoordsTransforms[0]));
+
+    if (locations->textureTransforms != -1)
+        glCheck(GLEXT_glUniform4fv(locations->textureTransforms, static_cast<GLsizei>(unitCount), &m_texCoordsTransforms[0]));
+
+    if (locations->textured != -1)
+        glCheck(GLEXT_glUniform1f(locations->textured, textured ? 1.f : 0.f));
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type)
+{
+    // Quads are not supported by core profiles, split them into triangles
+    if (type == Quads)
+    {
+        m_quadVertices.clear();
+        for (std::size_t i = 0; i + 3 < vertexCount; i += 4)
+        {
+            m_quadVertices.push_back(vertices[i]);
+            m_quadVertices.push_back(vertices[i + 1]);
+            m_quadVertices.push_back(vertices[i + 2]);
+            m_quadVertices.push_back(vertices[i]);
+            m_quadVertices.push_back(vertices[i + 2]);
+            m_quadVertices.push_back(vertices[i + 3]);
+        }
+
+        if (m_quadVertices.empty())
+            return;
+
+        vertices = &m_quadVertices[0];
+        vertexCount = m_quadVertices.size();
+        type = Triangles;
+    }
+
+    std::size_t size = vertexCount * sizeof(Vertex);
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    // When the buffer is full, orphan it: the driver provides fresh storage
+    // while the draw calls still in flight keep reading the previous one,
+    // so that uploads never wait for the GPU
+    if (m_bufferOffset + size > m_bufferSize)
+    {
+        m_bufferSize = std::max(m_bufferSize, std::max(size, initialBufferVertexCount * sizeof(Vertex)));
+        m_bufferOffset = 0;
+
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, m_bufferSize, 0, GLEXT_GL_STREAM_DRAW));
+    }
+
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, m_bufferOffset, size, vertices));
+
+    bindVertexArray(m_buffer);
+
+    GLint first = static_cast<GLint>(m_bufferOffset / sizeof(Vertex));
+    glCheck(glDrawArrays(primitiveTypeToGlConstant(type), first, static_cast<GLsizei>(vertexCount)));
+
+    m_bufferOffset += size;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::draw(unsigned int buffer, std::size_t firstVertex, std::size_t vertexCount, PrimitiveType type)
+{
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, buffer));
+
+    bindVertexArray(buffer);
+
+    // Quads are rejected by RenderTarget, core profiles don't support them
+    assert(type != Quads);
+    glCheck(glDrawArrays(primitiveTypeToGlConstant(type), static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::contextDestroyCallback(void* /* arg */)
+{
+    Lock lock(mutex);
+
+    Uint64 contextId = Context::getActiveContextId();
+
+    // Destroy the vertex array objects of the active renderers
+    for (std::set<ProgrammableRenderer*>::iterator renderersIter = renderers.begin(); renderersIter != renderers.end(); ++renderersIter)
+    {
+        ProgrammableRenderer& renderer = **renderersIter;
+
+        VertexArrayTable::iterator iter = renderer.m_vertexArrays.find(contextId);
+        if (iter != renderer.m_vertexArrays.end())
+        {
+            glCheck(GLEXT_glDeleteVertexArrays(1, &iter->second.object));
+
+            if (renderer.m_vertexArray == &iter->second)
+                renderer.m_vertexArray = NULL;
+
+            // Erase the entry from the renderer's table
+            renderer.m_vertexArrays.erase(iter);
+        }
+    }
+
+    // Destroy stale vertex array objects
+    destroyStaleVertexArrays();
+}
+
+
+////////////////////////////////////////////////////////////
+ProgrammableRenderer::Locations ProgrammableRenderer::getLocations(unsigned int program)
+{
+    Locations locations;
+    locations.transform          = getUniformLocation(program, "sf_transform");
+    locations.texCoordsTransform = getUniformLocation(program, "sf_texCoordsTransform");
+    locations.textureTransforms  = getUniformLocation(program, "sf_textureTransforms");
+    locations.textured           = getUniformLocation(program, "sf_textured");
+
+    return locations;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::bindVertexArray(unsigned int buffer)
+{
+    if (!m_vertexArray)
+    {
+        Uint64 contextId = Context::getActiveContextId();
+        VertexArrayTable::iterator iter = m_vertexArrays.find(contextId);
+
+        if (iter == m_vertexArrays.end())
+        {
+            // First draw in this context: create its vertex array object
+            VertexArray vertexArray;
+            vertexArray.object = 0;
+            vertexArray.source = 0;
+            glCheck(GLEXT_glGenVertexArrays(1, &vertexArray.object));
+            glCheck(GLEXT_glBindVertexArray(vertexArray.object));
+            glCheck(GLEXT_glEnableVertexAttribArray(PositionAttribute));
+            glCheck(GLEXT_glEnableVertexAttribArray(ColorAttribute));
+            glCheck(GLEXT_glEnableVertexAttribArray(TexCoordsAttribute));
+
+            Lock lock(mutex);
+            iter = m_vertexArrays.insert(std::make_pair(contextId, vertexArray)).first;
+        }
+        else
+        {
+            glCheck(GLEXT_glBindVertexArray(iter->second.object));
+        }
+
+        m_vertexArray = &iter->second;
+    }
+
+    // The attribute pointers capture the buffer bound to GL_ARRAY_BUFFER when
+    // they are defined. Only the streaming buffer, which lives as long as the
+    // renderer, can skip this: the name of a deleted user vertex buffer may be
+    // given to a new buffer, so the pointers to those are always defined again
+    if ((buffer != m_buffer) || (m_vertexArray->source != buffer))
+    {
+        glCheck(GLEXT_glVertexAttribPointer(PositionAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+        glCheck(GLEXT_glVertexAttribPointer(ColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+        glCheck(GLEXT_glVertexAttribPointer(TexCoordsAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+
+        m_vertexArray->source = buffer;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+// OpenGL ES 1 doesn't support the programmable pipeline, so we provide a dummy implementation
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ProgrammableRenderer::ProgrammableRenderer() :
+m_program            (0),
+m_locations          (),
+m_programLocations   (),
+m_texCoordsTransforms(),
+m_buffer             (0),
+m_bufferSize         (0),
+m_bufferOffset       (0),
+m_vertexArrays       (),
+m_vertexArray        (NULL),
+m_quadVertices       ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ProgrammableRenderer::~ProgrammableRenderer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammableRenderer::isAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::bindAttributeLocations(unsigned int /* program */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const char* ProgrammableRenderer::getVersionDirective()
+{
+    return "";
+}
+
+
+////////////////////////////////////////////////////////////
+bool ProgrammableRenderer::create()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::resetStates()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::unbind()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::setTexCoordsTransform(std::size_t /* unit */, const float* /* texCoordsTransform */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::setProgram(unsigned int /* program */, Uint64 /* programId */, const float* /* transform */, std::size_t /* unitCount */, bool /* textured */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::draw(const Vertex* /* vertices */, std::size_t /* vertexCount */, PrimitiveType /* type */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::draw(unsigned int /* buffer */, std::size_t /* firstVertex */, std::size_t /* vertexCount */, PrimitiveType /* type */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::contextDestroyCallback(void* /* arg */)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ProgrammableRenderer::Locations ProgrammableRenderer::getLocations(unsigned int /* program */)
+{
+    return Locations();
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgrammableRenderer::bindVertexArray(unsigned int /* buffer */)
+{
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PROGRAMMABLERENDERER_HPP
+#define SFML_PROGRAMMABLERENDERER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/HashTable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Vertex submission through a vertex array object,
+///        a streaming vertex buffer and a built-in shader
+///
+/// This is the backend of render targets that use
+/// sf::RenderTarget::Programmable: it doesn't rely on client
+/// side arrays nor on the fixed-function matrices, which
+/// are unavailable in core profile contexts.
+///
+////////////////////////////////////////////////////////////
+class ProgrammableRenderer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Locations of the vertex attributes
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Attribute
+    {
+        PositionAttribute,  //!< vec2 sf_position
+        ColorAttribute,     //!< vec4 sf_color
+        TexCoordsAttribute  //!< vec2 sf_texCoords
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ProgrammableRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ProgrammableRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports the programmable backend
+    ///
+    /// \return True if OpenGL 3.0 is available
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the vertex attribute names to their locations
+    ///
+    /// This must be called before linking \a program. Names
+    /// that the program doesn't declare are ignored.
+    ///
+    /// \param program OpenGL identifier of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bindAttributeLocations(unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the GLSL version directive of the shaders written for this backend
+    ///
+    /// Their sources are valid GLSL 1.30 and 1.50, the directive
+    /// selects the version that the current context accepts.
+    /// A context must be active.
+    ///
+    /// \return Version directive, including the end of line
+    ///
+    ////////////////////////////////////////////////////////////
+    static const char* getVersionDirective();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compile the built-in program and create the vertex buffer
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget about the bindings made by previous draws
+    ///
+    /// This must be called whenever the OpenGL states may have
+    /// been modified outside the renderer, or when another
+    /// context is activated.
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the default vertex array and program bindings
+    ///
+    ////////////////////////////////////////////////////////////
+    void unbind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the transform applied to the coordinates of a texture unit
+    ///
+    /// This replaces the texture matrix of the unit, which
+    /// doesn't exist in core profiles. The transform of the
+    /// first unit is passed to the sf_texCoordsTransform
+    /// uniform, and the ones of all the units to the
+    /// sf_textureTransforms array.
+    ///
+    /// \param unit               Index of the texture unit
+    /// \param texCoordsTransform Scale (x, y) and offset (z, w) applied
+    ///                           to the texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexCoordsTransform(std::size_t unit, const float* texCoordsTransform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the program and set its uniforms for the next draws
+    ///
+    /// \param program   OpenGL identifier of the user program
+    ///                  already in use, or 0 for the built-in one
+    /// \param programId Unique identifier of the user program (see sf::Shader)
+    /// \param transform Combined view and model 4x4 matrix
+    /// \param unitCount Number of texture units whose transform was set
+    /// \param textured  Whether a texture is bound
+    ///
+    ////////////////////////////////////////////////////////////
+    void setProgram(unsigned int program, Uint64 programId, const float* transform, std::size_t unitCount, bool textured);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload vertices to the streaming buffer and draw them
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw vertices stored in a vertex buffer
+    ///
+    /// The primitive type must not be Quads, which core profiles
+    /// don't support and which can't be converted in place.
+    ///
+    /// \param buffer      OpenGL identifier of the vertex buffer
+    /// \param firstVertex Index of the first vertex to render
+    /// \param vertexCount Number of vertices to render
+    /// \param type        Type of primitives to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(unsigned int buffer, std::size_t firstVertex, std::size_t vertexCount, PrimitiveType type);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the vertex array objects of a context that is being destroyed
+    ///
+    /// \param arg Unused
+    ///
+    ////////////////////////////////////////////////////////////
+    static void contextDestroyCallback(void* arg);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the vertex array of the current context, sourcing a buffer
+    ///
+    /// \param buffer OpenGL identifier of the buffer to read the vertices from
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindVertexArray(unsigned int buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Vertex array object of a context
+    ///
+    ////////////////////////////////////////////////////////////
+    struct VertexArray
+    {
+        unsigned int object; //!< OpenGL identifier of the vertex array object
+        unsigned int source; //!< Buffer the attribute pointers were last defined for
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Uniform locations of a program
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Locations
+    {
+        int transform;          //!< mat4 sf_transform
+        int texCoordsTransform; //!< vec4 sf_texCoordsTransform
+        int textureTransforms;  //!< vec4 sf_textureTransforms[]
+        int textured;           //!< float sf_textured
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look up the uniform locations of a program
+    ///
+    /// \param program OpenGL identifier of the program
+    ///
+    /// \return Locations of the uniforms, -1 for the unused ones
+    ///
+    ////////////////////////////////////////////////////////////
+    static Locations getLocations(unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Uint64, VertexArray> VertexArrayTable;
+    typedef HashTable<Locations> LocationTable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int        m_program;             //!< OpenGL identifier of the built-in program
+    Locations           m_locations;           //!< Uniform locations of the built-in program
+    LocationTable       m_programLocations;    //!< Uniform locations of the user programs, by unique identifier
+    std::vector<float>  m_texCoordsTransforms; //!< Transforms of the texture coordinates, 4 components per unit
+    unsigned int        m_buffer;              //!< OpenGL identifier of the streaming vertex buffer
+    std::size_t         m_bufferSize;          //!< Size of the streaming buffer storage, in bytes
+    std::size_t         m_bufferOffset;        //!< Offset of the free part of the streaming buffer, in bytes
+    VertexArrayTable    m_vertexArrays;        //!< Vertex array objects per context
+    VertexArray*        m_vertexArray;         //!< Vertex array currently bound, if known
+    std::vector<Vertex> m_quadVertices;        //!< Quads converted to triangles
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PROGRAMMABLERENDERER_HPP
@@ -32,6 +32,8 @@
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStatesTracker.hpp>
+#include <SFML/Graphics/ProgrammableRenderer.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
@@ -40,6 +42,7 @@
 #include <iostream>
 #include <algorithm>
 #include <map>
+#include <set>
 
 
 // GL_QUADS is unavailable on OpenGL ES, thus we need to define GL_QUADS ourselves
@@ -66,6 +69,16 @@ namespace
         return id++;
     }
 
+    // Render targets that have batching enabled, so that their pending
+    // primitives can be rendered before a texture that they use is modified
+    sf::Mutex batchingMutex;
+    std::set<sf::RenderTarget*> batchingTargets;
+
+    // Map to find a RenderTarget from its unique identifier, so that
+    // the one that was active can be activated again after a flush
+    typedef std::map<sf::Uint64, sf::RenderTarget*> RenderTargetMap;
+    RenderTargetMap renderTargetMap;
+
     // Map to help us detect whether a different RenderTarget
     // has been activated within a single context
     typedef std::map<sf::Uint64, sf::Uint64> ContextRenderTargetMap;
@@ -149,26 +162,54 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
-m_defaultView(),
-m_view       (),
-m_cache      (),
-m_id         (0)
+m_defaultView    (),
+m_view           (),
+m_cache          (),
+m_batch          (),
+m_id             (0),
+m_renderer       (NULL),
+m_statesTracker  (NULL),
+m_statesCallCount(0)
 {
     m_cache.glStatesSet = false;
+    m_batch.enable = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    if (m_batch.enable)
+    {
+        Lock lock(batchingMutex);
+        batchingTargets.erase(this);
+    }
+
+    if (m_id)
+    {
+        Lock lock(mutex);
+        renderTargetMap.erase(m_id);
+    }
+
+    delete m_statesTracker;
+    delete m_renderer;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Pending primitives would be overwritten anyway
+    m_batch.vertices.clear();
+
     if (isActive(m_id) || setActive(true))
     {
+        if (m_statesTracker)
+        {
+            m_statesTracker->saveTextureUnit(0);
+            m_statesTracker->saveClearColor();
+        }
+
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
@@ -181,6 +222,9 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Pending primitives must be rendered with the previous view
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -282,65 +326,16 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         }
     #endif
 
-    if (isActive(m_id) || setActive(true))
+    // Queue the primitives if they can be merged with other draw calls
+    if (m_batch.enable && !states.shader && (vertexCount <= Batch::MaxDrawVertexCount) &&
+        !(states.texture && states.texture->m_fboAttachment))
     {
-        // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
-
-        if (useVertexCache)
-        {
-            // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
-        }
-
-        setupDraw(useVertexCache, states);
-
-        // Check if texture coordinates array is needed, and update client state accordingly
-        bool enableTexCoordsArray = (states.texture || states.shader);
-        if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
-        {
-            if (enableTexCoordsArray)
-                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
-            else
-                glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
-        }
-
-        // If we switch between non-cache and cache mode or enable texture
-        // coordinates we need to set up the pointers to the vertices' components
-        if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
-        {
-            const char* data = reinterpret_cast<const char*>(vertices);
-
-            // If we pre-transform the vertices, we must use our internal vertex cache
-            if (useVertexCache)
-                data = reinterpret_cast<const char*>(m_cache.vertexCache);
-
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            if (enableTexCoordsArray)
-                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
-        }
-        else if (enableTexCoordsArray && !m_cache.texCoordsArrayEnabled)
-        {
-            // If we enter this block, we are already using our internal vertex cache
-            const char* data = reinterpret_cast<const char*>(m_cache.vertexCache);
-
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
-        }
-
-        drawPrimitives(type, 0, vertexCount);
-        cleanupDraw(states);
-
-        // Update the cache
-        m_cache.useVertexCache = useVertexCache;
-        m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
+        batchVertices(vertices, vertexCount, type, states);
+        return;
     }
+
+    flush();
+    drawVertices(vertices, vertexCount, type, states);
 }
 
 
@@ -382,8 +377,26 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
         }
     #endif
 
+    // Core profiles have no GL_QUADS, and quads stored in a vertex buffer can't be converted
+    if (m_renderer && (vertexBuffer.getPrimitiveType() == Quads))
+    {
+        err() << "sf::Quads primitive type is not supported by the programmable backend for vertex buffers, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Vertex buffers are never batched, render pending primitives first
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
+        if (m_renderer)
+        {
+            setupProgrammableDraw(states);
+            m_renderer->draw(vertexBuffer.getNativeHandle(), firstVertex, vertexCount, vertexBuffer.getPrimitiveType());
+            cleanupDraw(states);
+            return;
+        }
+
         setupDraw(false, states);
 
         // Bind vertex buffer
@@ -411,6 +424,142 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flush();
+
+    m_batch.enable = enabled;
+
+    Lock lock(batchingMutex);
+    if (enabled)
+        batchingTargets.insert(this);
+    else
+        batchingTargets.erase(this);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enable;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    if (m_batch.vertices.empty())
+        return;
+
+    RenderStates states(m_batch.blendMode, Transform::Identity, m_batch.texture, NULL);
+    drawVertices(&m_batch.vertices[0], m_batch.vertices.size(), m_batch.type, states);
+
+    m_batch.vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flushBatches(const Texture& texture)
+{
+    Lock lock(batchingMutex);
+
+    std::vector<RenderTarget*> targets;
+    for (std::set<RenderTarget*>::iterator it = batchingTargets.begin(); it != batchingTargets.end(); ++it)
+    {
+        if (!(*it)->m_batch.vertices.empty() && ((*it)->m_batch.texture == &texture))
+            targets.push_back(*it);
+    }
+
+    if (targets.empty())
+        return;
+
+    // Flushing activates the context of each target: remember what was
+    // active so that the caller's context is left untouched
+    Uint64 contextId = Context::getActiveContextId();
+    const Context* context = Context::getActiveContext();
+    RenderTarget* activeTarget = NULL;
+
+    {
+        Lock mapLock(mutex);
+
+        ContextRenderTargetMap::iterator iter = contextRenderTargetMap.find(contextId);
+        if (iter != contextRenderTargetMap.end())
+        {
+            RenderTargetMap::iterator target = renderTargetMap.find(iter->second);
+            if (target != renderTargetMap.end())
+                activeTarget = target->second;
+        }
+    }
+
+    for (std::vector<RenderTarget*>::iterator it = targets.begin(); it != targets.end(); ++it)
+        (*it)->flush();
+
+    if (activeTarget)
+    {
+        if (!isActive(activeTarget->m_id))
+            activeTarget->setActive(true);
+    }
+    else if (context && (Context::getActiveContextId() != contextId))
+    {
+        const_cast<Context*>(context)->setActive(true);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::setBackend(Backend backend)
+{
+    if (backend == getBackend())
+        return true;
+
+    // Pending primitives must be rendered by the backend that received them
+    flush();
+
+    if (!isActive(m_id) && !setActive(true))
+        return false;
+
+    if (backend == Programmable)
+    {
+        if (!priv::ProgrammableRenderer::isAvailable())
+        {
+            err() << "Failed to select the programmable backend: your system doesn't support OpenGL 3.0" << std::endl;
+            return false;
+        }
+
+        priv::ProgrammableRenderer* renderer = new priv::ProgrammableRenderer;
+        if (!renderer->create())
+        {
+            delete renderer;
+            return false;
+        }
+
+        m_renderer = renderer;
+    }
+    else
+    {
+        m_renderer->unbind();
+
+        delete m_renderer;
+        m_renderer = NULL;
+    }
+
+    // The states set for the previous backend are not the ones the new one needs
+    m_cache.glStatesSet = false;
+    m_cache.enable = false;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTarget::Backend RenderTarget::getBackend() const
+{
+    return m_renderer ? Programmable : FixedFunction;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool RenderTarget::setActive(bool active)
 {
@@ -451,9 +600,43 @@ bool RenderTarget::setActive(bool active)
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setGLStatesTrackingEnabled(bool enabled)
+{
+    if (enabled && !m_statesTracker)
+    {
+        m_statesTracker = new priv::GLStatesTracker;
+    }
+    else if (!enabled && m_statesTracker)
+    {
+        delete m_statesTracker;
+        m_statesTracker = NULL;
+    }
+
+    m_statesCallCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isGLStatesTrackingEnabled() const
+{
+    return m_statesTracker != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTarget::getGLStatesCallCount() const
+{
+    return m_statesTracker ? m_statesTracker->getCallCount() : m_statesCallCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
+    // Pending primitives belong to the states that are about to be saved
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
         #ifdef SFML_DEBUG
@@ -467,16 +650,33 @@ void RenderTarget::pushGLStates()
             }
         #endif
 
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-            glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
-        #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
+        if (m_statesTracker)
+        {
+            // Each state is saved right before it is modified for the first time;
+            // the default states will be set, and thus saved, by the next draw
+            m_statesTracker->begin(m_renderer == NULL);
+            m_cache.glStatesSet = false;
+            return;
+        }
+
+        m_statesCallCount = 0;
+
+        // The attribute and matrix stacks don't exist in core profiles
+        if (!m_renderer)
+        {
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
+                glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+                m_statesCallCount += 2;
+            #endif
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+            m_statesCallCount += 6;
+        }
     }
 
     resetGLStates();
@@ -486,17 +686,41 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
+    // Pending primitives belong to the states that are about to be restored
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
+        if (m_statesTracker)
+        {
+            m_statesTracker->restore();
+
+            // Our cached states are no longer the current ones
+            m_cache.glStatesSet = false;
+            return;
+        }
+
+        m_statesCallCount = 0;
+
+        if (m_renderer)
+        {
+            // Give the default vertex array and program back to the user code
+            m_renderer->unbind();
+            m_statesCallCount += 2;
+            return;
+        }
+
         glCheck(glMatrixMode(GL_PROJECTION));
         glCheck(glPopMatrix());
         glCheck(glMatrixMode(GL_MODELVIEW));
         glCheck(glPopMatrix());
         glCheck(glMatrixMode(GL_TEXTURE));
         glCheck(glPopMatrix());
+        m_statesCallCount += 6;
         #ifndef SFML_OPENGL_ES
             glCheck(glPopClientAttrib());
             glCheck(glPopAttrib());
+            m_statesCallCount += 2;
         #endif
     }
 }
@@ -520,25 +744,39 @@ void RenderTarget::resetGLStates()
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
+        // Remember the states that are about to be modified, if popGLStates must restore them
+        if (m_statesTracker)
+            m_statesTracker->saveDefaultStates();
+
         // Make sure that the texture unit which is active is the number 0
         if (GLEXT_multitexture)
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+            if (!m_renderer)
+                glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
             glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
         }
 
         // Define the default OpenGL states
         glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
         glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
         glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glLoadIdentity());
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+        if (m_renderer)
+        {
+            // The programmable backend doesn't use any fixed-function state
+            m_renderer->resetStates();
+        }
+        else
+        {
+            glCheck(glDisable(GL_LIGHTING));
+            glCheck(glDisable(GL_ALPHA_TEST));
+            glCheck(glEnable(GL_TEXTURE_2D));
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glLoadIdentity());
+            glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
@@ -554,8 +792,9 @@ void RenderTarget::resetGLStates()
 
         m_cache.useVertexCache = false;
 
-        // Set the default view
-        setView(getView());
+        // Set the default view; setView() isn't used here since it would
+        // flush the pending primitives, which may be the ones being drawn
+        m_cache.viewChanged = true;
 
         m_cache.enable = true;
     }
@@ -569,29 +808,195 @@ void RenderTarget::initialize()
     m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
     m_view = m_defaultView;
 
+    // Primitives pending from a previous creation are obsolete
+    m_batch.vertices.clear();
+
     // Set GL states only on first draw, so that we don't pollute user's states
     m_cache.glStatesSet = false;
 
     // Generate a unique ID for this RenderTarget to track
     // whether it is active within a specific context
+    Uint64 previousId = m_id;
     m_id = getUniqueId();
+
+    Lock lock(mutex);
+    renderTargetMap.erase(previousId);
+    renderTargetMap[m_id] = this;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawVertices(const Vertex* vertices, std::size_t vertexCount,
+                                PrimitiveType type, const RenderStates& states)
+{
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_renderer)
+        {
+            setupProgrammableDraw(states);
+            m_renderer->draw(vertices, vertexCount, type);
+            cleanupDraw(states);
+            return;
+        }
+
+        // Check if the vertex count is low enough so that we can pre-transform them
+        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
+
+        if (useVertexCache)
+        {
+            // Pre-transform the vertices and store them into the vertex cache
+            states.transform.transformPoints(vertices, m_cache.vertexCache, vertexCount);
+        }
+
+        setupDraw(useVertexCache, states);
+
+        // Check if texture coordinates array is needed, and update client state accordingly
+        bool enableTexCoordsArray = (states.texture || states.shader);
+        if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
+        {
+            if (enableTexCoordsArray)
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+            else
+                glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
+
+        // If we switch between non-cache and cache mode or enable texture
+        // coordinates we need to set up the pointers to the vertices' components
+        if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
+        {
+            const char* data = reinterpret_cast<const char*>(vertices);
+
+            // If we pre-transform the vertices, we must use our internal vertex cache
+            if (useVertexCache)
+                data = reinterpret_cast<const char*>(m_cache.vertexCache);
+
+            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+            if (enableTexCoordsArray)
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+        }
+        else if (enableTexCoordsArray && !m_cache.texCoordsArrayEnabled)
+        {
+            // If we enter this block, we are already using our internal vertex cache
+            const char* data = reinterpret_cast<const char*>(m_cache.vertexCache);
+
+            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+        }
+
+        drawPrimitives(type, 0, vertexCount);
+        cleanupDraw(states);
+
+        // Update the cache
+        m_cache.useVertexCache = useVertexCache;
+        m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::batchVertices(const Vertex* vertices, std::size_t vertexCount,
+                                 PrimitiveType type, const RenderStates& states)
+{
+    // Find the independent primitive type that the primitives will be converted to
+    PrimitiveType batchType = Triangles;
+    if (type == Points)
+        batchType = Points;
+    else if ((type == Lines) || (type == LineStrip))
+        batchType = Lines;
+
+    // Render the pending primitives first if they can't be merged with the new ones
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (!m_batch.vertices.empty() && ((batchType != m_batch.type) ||
+                                      (states.blendMode != m_batch.blendMode) ||
+                                      (textureId != m_batch.textureId)))
+    {
+        flush();
+    }
+
+    m_batch.type      = batchType;
+    m_batch.blendMode = states.blendMode;
+    m_batch.texture   = states.texture;
+    m_batch.textureId = textureId;
+
+    // Append the vertices to the batch; primitives that share vertices must be
+    // unrolled, since consecutive strips or fans can't simply be concatenated
+    std::vector<Vertex>& batch = m_batch.vertices;
+    std::size_t first = batch.size();
+
+    switch (type)
+    {
+        case LineStrip:
+            for (std::size_t i = 0; i + 1 < vertexCount; ++i)
+            {
+                batch.push_back(vertices[i]);
+                batch.push_back(vertices[i + 1]);
+            }
+            break;
+
+        case TriangleStrip:
+            for (std::size_t i = 0; i + 2 < vertexCount; ++i)
+            {
+                batch.push_back(vertices[i]);
+                batch.push_back(vertices[i + 1]);
+                batch.push_back(vertices[i + 2]);
+            }
+            break;
+
+        case TriangleFan:
+            for (std::size_t i = 1; i + 1 < vertexCount; ++i)
+            {
+                batch.push_back(vertices[0]);
+                batch.push_back(vertices[i]);
+                batch.push_back(vertices[i + 1]);
+            }
+            break;
+
+        case Quads:
+            for (std::size_t i = 0; i + 3 < vertexCount; i += 4)
+            {
+                batch.push_back(vertices[i]);
+                batch.push_back(vertices[i + 1]);
+                batch.push_back(vertices[i + 2]);
+                batch.push_back(vertices[i]);
+                batch.push_back(vertices[i + 2]);
+                batch.push_back(vertices[i + 3]);
+            }
+            break;
+
+        default:
+            // Independent primitives are transformed straight into the batch
+            batch.resize(first + vertexCount);
+            states.transform.transformPoints(vertices, &batch[first], vertexCount);
+            return;
+    }
+
+    // Pre-transform the appended vertices in a single pass
+    if (batch.size() > first)
+        states.transform.transformPoints(&batch[first], &batch[first], batch.size() - first);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
+    if (m_statesTracker)
+        m_statesTracker->saveView();
+
     // Set the viewport
     IntRect viewport = getViewport(m_view);
     int top = getSize().y - (viewport.top + viewport.height);
     glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
 
-    // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+    // The programmable backend passes the view matrix to its shader at each draw
+    if (!m_renderer)
+    {
+        // Set the projection matrix
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+        // Go back to model-view mode
+        glCheck(glMatrixMode(GL_MODELVIEW));
+    }
 
     m_cache.viewChanged = false;
 }
@@ -664,7 +1069,24 @@ void RenderTarget::applyTransform(const Transform& transform)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTexture(const Texture* texture)
 {
-    Texture::bind(texture, Texture::Pixels);
+    if (m_renderer)
+    {
+        // The programmable backend converts the texture coordinates in its shader,
+        // the texture matrix must not be touched since it may not exist
+        if (texture && texture->m_layerCount)
+        {
+            glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, texture->m_texture));
+        }
+        else
+        {
+            glCheck(glBindTexture(GL_TEXTURE_2D, texture ? texture->m_texture : 0));
+        }
+    }
+    else
+    {
+        Texture::bind(texture, Texture::Pixels);
+    }
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
 }
@@ -673,7 +1095,15 @@ void RenderTarget::applyTexture(const Texture* texture)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyShader(const Shader* shader)
 {
-    Shader::bind(shader);
+    // The shader binds its textures to the units that follow the first one
+    if (m_statesTracker && shader)
+    {
+        for (std::size_t i = 0; i < shader->m_textures.size(); ++i)
+            m_statesTracker->saveTextureUnit(static_cast<unsigned int>(i + 1));
+    }
+
+    // The programmable backend flips render textures in its uniforms, not in the texture matrix
+    Shader::bind(shader, m_renderer == NULL);
 }
 
 
@@ -727,6 +1157,74 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setupProgrammableDraw(const RenderStates& states)
+{
+    // First set the persistent OpenGL states if it's the very first call
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+    else if (!m_cache.enable)
+        m_renderer->resetStates();
+
+    // Apply the viewport
+    if (!m_cache.enable || m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the blend mode
+    if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
+        applyBlendMode(states.blendMode);
+
+    // Apply the texture, always rebinding render-texture attachments (see setupDraw)
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (!m_cache.enable || (textureId != m_cache.lastTextureId) || (states.texture && states.texture->m_fboAttachment))
+        applyTexture(states.texture);
+
+    // Apply the shader
+    if (states.shader)
+        applyShader(states.shader);
+
+    // Compute the uniforms that replace the fixed-function matrices: the texture
+    // coordinates are transformed the same way Texture::bind does it, in pixels
+    // for the main texture and normalized for the ones of the shader
+    Transform transform = m_view.getTransform() * states.transform;
+
+    bool textured = states.texture && states.texture->m_texture;
+    std::size_t unitCount = 1;
+    Shader::TextureTable::const_iterator shaderTexture;
+    if (states.shader)
+    {
+        unitCount += states.shader->m_textures.size();
+        shaderTexture = states.shader->m_textures.begin();
+    }
+
+    for (std::size_t unit = 0; unit < unitCount; ++unit)
+    {
+        const Texture* texture = unit ? (shaderTexture++)->second : (textured ? states.texture : NULL);
+
+        float texCoordsTransform[4] = {1.f, 1.f, 0.f, 0.f};
+        if (texture)
+        {
+            if (unit == 0)
+            {
+                texCoordsTransform[0] = 1.f / texture->m_actualSize.x;
+                texCoordsTransform[1] = 1.f / texture->m_actualSize.y;
+            }
+
+            if (texture->m_pixelsFlipped)
+            {
+                texCoordsTransform[1] = -texCoordsTransform[1];
+                texCoordsTransform[3] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
+            }
+        }
+
+        m_renderer->setTexCoordsTransform(unit, texCoordsTransform);
+    }
+
+    unsigned int program = states.shader ? states.shader->getNativeHandle() : 0;
+    m_renderer->setProgram(program, program ? states.shader->m_programId : 0, transform.getMatrix(), unitCount, textured);
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
 {
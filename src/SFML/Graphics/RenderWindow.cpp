@@ -31,6 +31,16 @@
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 
 
+namespace
+{
+    // Render the pending batched primitives of a window before its buffers are swapped
+    void flushBeforeDisplay(void* window)
+    {
+        static_cast<sf::RenderWindow*>(window)->flush();
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -98,6 +108,10 @@ bool RenderWindow::setActive(bool active)
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
+    // Render the pending batched primitives, they are part of the contents;
+    // this doesn't change what the window displays, only when it is rendered
+    const_cast<RenderWindow*>(this)->flush();
+
     Vector2u windowSize = getSize();
 
     Texture texture;
@@ -118,6 +132,9 @@ void RenderWindow::onCreate()
         glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, reinterpret_cast<GLint*>(&m_defaultFrameBuffer)));
     }
 
+    // Flush the batch in display(), even when it is called through a sf::Window
+    setDisplayCallback(flushBeforeDisplay, this);
+
     // Just initialize the render target part
     RenderTarget::initialize();
 }
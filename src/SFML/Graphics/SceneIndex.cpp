@@ -0,0 +1,434 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SceneIndex.hpp>
+#include <SFML/Graphics/HashTable.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Objects that cover more cells than this are not stored in the grid
+    const float maxCellsPerObject = 64.f;
+
+    // Cell coordinates are clamped to this range to fit in an int
+    const float maxCellCoordinate = 1 << 30;
+
+    // Clamp a cell coordinate so that it fits in an int (NaN becomes 0)
+    float clampCell(float coordinate)
+    {
+        if (coordinate > maxCellCoordinate)
+            return maxCellCoordinate;
+        if (coordinate < -maxCellCoordinate)
+            return -maxCellCoordinate;
+        return (coordinate == coordinate) ? coordinate : 0.f;
+    }
+
+    // Build the key of a cell from its coordinates
+    sf::Uint64 cellKey(int x, int y)
+    {
+        return (static_cast<sf::Uint64>(static_cast<sf::Uint32>(x)) << 32) | static_cast<sf::Uint32>(y);
+    }
+
+    // Extract the coordinates of a cell from its key
+    int cellX(sf::Uint64 key)
+    {
+        return static_cast<int>(static_cast<sf::Uint32>(key >> 32));
+    }
+
+    int cellY(sf::Uint64 key)
+    {
+        return static_cast<int>(static_cast<sf::Uint32>(key & 0xFFFFFFFF));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SceneIndex::SceneIndex(float cellSize) :
+m_cellSize    (cellSize > 0.f ? cellSize : 256.f),
+m_objects     (),
+m_freeIds     (),
+m_cells       (new CellMap),
+m_largeObjects(),
+m_nextOrder   (0),
+m_queryStamp  (0),
+m_matches     (),
+m_visible     (),
+m_drawnCount  (0),
+m_culledCount (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SceneIndex::SceneIndex(const SceneIndex& copy) :
+Drawable      (copy),
+m_cellSize    (copy.m_cellSize),
+m_objects     (copy.m_objects),
+m_freeIds     (copy.m_freeIds),
+m_cells       (new CellMap(*copy.m_cells)),
+m_largeObjects(copy.m_largeObjects),
+m_nextOrder   (copy.m_nextOrder),
+m_queryStamp  (copy.m_queryStamp),
+m_matches     (),
+m_visible     (),
+m_drawnCount  (0),
+m_culledCount (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SceneIndex::~SceneIndex()
+{
+    delete m_cells;
+}
+
+
+////////////////////////////////////////////////////////////
+SceneIndex& SceneIndex::operator =(const SceneIndex& right)
+{
+    SceneIndex temp(right);
+
+    std::swap(m_cellSize,     temp.m_cellSize);
+    std::swap(m_objects,      temp.m_objects);
+    std::swap(m_freeIds,      temp.m_freeIds);
+    std::swap(m_cells,        temp.m_cells);
+    std::swap(m_largeObjects, temp.m_largeObjects);
+    std::swap(m_nextOrder,    temp.m_nextOrder);
+    std::swap(m_queryStamp,   temp.m_queryStamp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneIndex::add(const Drawable& drawable, const FloatRect& bounds)
+{
+    // Reuse the slot of a removed object if possible
+    std::size_t id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = m_objects.size();
+        m_objects.push_back(Object());
+    }
+
+    Object& object = m_objects[id];
+    object.drawable = &drawable;
+    object.bounds   = bounds;
+    object.cells    = getCellRange(bounds);
+    object.order    = m_nextOrder++;
+    object.stamp    = 0;
+
+    link(id);
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneIndex::remove(std::size_t id)
+{
+    if ((id >= m_objects.size()) || !m_objects[id].drawable)
+        return;
+
+    unlink(id);
+    m_objects[id].drawable = NULL;
+    m_freeIds.push_back(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneIndex::clear()
+{
+    m_objects.clear();
+    m_freeIds.clear();
+    m_cells->clear();
+    m_largeObjects.clear();
+    m_nextOrder = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneIndex::setBounds(std::size_t id, const FloatRect& bounds)
+{
+    if ((id >= m_objects.size()) || !m_objects[id].drawable)
+        return;
+
+    Object& object = m_objects[id];
+    object.bounds = bounds;
+
+    // Most moves stay within the same cells, in which case the grid is unchanged
+    CellRange cells = getCellRange(bounds);
+    if ((cells.left   == object.cells.left)  &&
+        (cells.top    == object.cells.top)   &&
+        (cells.right  == object.cells.right) &&
+        (cells.bottom == object.cells.bottom) &&
+        (cells.large  == object.cells.large))
+        return;
+
+    unlink(id);
+    object.cells = cells;
+    link(id);
+}
+
+
+////////////////////////////////////////////////////////////
+const FloatRect& SceneIndex::getBounds(std::size_t id) const
+{
+    return m_objects[id].bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+const Drawable* SceneIndex::getDrawable(std::size_t id) const
+{
+    return id < m_objects.size() ? m_objects[id].drawable : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneIndex::getObjectCount() const
+{
+    return m_objects.size() - m_freeIds.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneIndex::query(const FloatRect& area, std::vector<std::size_t>& result) const
+{
+    result.clear();
+    m_matches.clear();
+
+    // Objects are stored in several cells, the stamp makes sure they are only returned once
+    Uint64 stamp = ++m_queryStamp;
+
+    collect(m_largeObjects, area, stamp, m_matches);
+
+    CellRange range = getCellRange(area);
+    float cellCount = (static_cast<float>(range.right) - range.left + 1) * (static_cast<float>(range.bottom) - range.top + 1);
+    if (cellCount <= static_cast<float>(m_cells->getSize()))
+    {
+        // Look up each cell of the area
+        for (int x = range.left; x <= range.right; ++x)
+        {
+            for (int y = range.top; y <= range.bottom; ++y)
+            {
+                const std::vector<std::size_t>* ids = m_cells->find(cellKey(x, y));
+                if (ids)
+                    collect(*ids, area, stamp, m_matches);
+            }
+        }
+    }
+    else
+    {
+        // The area covers more cells than there are non-empty ones, iterate over these instead
+        for (std::size_t i = 0; i < m_cells->getSlotCount(); ++i)
+        {
+            Uint64 key;
+            const std::vector<std::size_t>* ids = m_cells->getEntry(i, key);
+            if (!ids)
+                continue;
+
+            int x = cellX(key);
+            int y = cellY(key);
+            if ((x >= range.left) && (x <= range.right) && (y >= range.top) && (y <= range.bottom))
+                collect(*ids, area, stamp, m_matches);
+        }
+    }
+
+    // Return the objects in insertion order
+    std::sort(m_matches.begin(), m_matches.end());
+
+    result.reserve(m_matches.size());
+    for (std::size_t i = 0; i < m_matches.size(); ++i)
+        result.push_back(m_matches[i].second);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneIndex::query(const View& view, std::vector<std::size_t>& result) const
+{
+    // The view transform maps its visible area to [-1, 1]
+    query(view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f)), result);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneIndex::getDrawnCount() const
+{
+    return m_drawnCount;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneIndex::getCulledCount() const
+{
+    return m_culledCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneIndex::draw(RenderTarget& target, RenderStates states) const
+{
+    // Express the visible area in the coordinate system of the objects
+    const View& view = target.getView();
+    FloatRect area = view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    area = states.transform.getInverse().transformRect(area);
+
+    query(area, m_visible);
+
+    for (std::size_t i = 0; i < m_visible.size(); ++i)
+        target.draw(*m_objects[m_visible[i]].drawable, states);
+
+    m_drawnCount = m_visible.size();
+    m_culledCount = getObjectCount() - m_drawnCount;
+}
+
+
+////////////////////////////////////////////////////////////
+SceneIndex::CellRange SceneIndex::getCellRange(const FloatRect& rectangle) const
+{
+    float left   = std::floor(rectangle.left / m_cellSize);
+    float top    = std::floor(rectangle.top / m_cellSize);
+    float right  = std::floor((rectangle.left + rectangle.width) / m_cellSize);
+    float bottom = std::floor((rectangle.top + rectangle.height) / m_cellSize);
+
+    // Handle rectangles with negative dimensions
+    if (left > right)
+        std::swap(left, right);
+    if (top > bottom)
+        std::swap(top, bottom);
+
+    left   = clampCell(left);
+    top    = clampCell(top);
+    right  = clampCell(right);
+    bottom = clampCell(bottom);
+
+    CellRange range;
+    range.left   = static_cast<int>(left);
+    range.top    = static_cast<int>(top);
+    range.right  = static_cast<int>(right);
+    range.bottom = static_cast<int>(bottom);
+    range.large  = (right - left + 1) * (bottom - top + 1) > maxCellsPerObject;
+
+    return range;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneIndex::link(std::size_t id)
+{
+    const CellRange& range = m_objects[id].cells;
+
+    if (range.large)
+    {
+        m_largeObjects.push_back(id);
+        return;
+    }
+
+    for (int x = range.left; x <= range.right; ++x)
+    {
+        for (int y = range.top; y <= range.bottom; ++y)
+        {
+            Uint64 key = cellKey(x, y);
+            std::vector<std::size_t>* ids = m_cells->find(key);
+            if (!ids)
+                ids = &m_cells->insert(key, std::vector<std::size_t>());
+
+            ids->push_back(id);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneIndex::unlink(std::size_t id)
+{
+    const CellRange& range = m_objects[id].cells;
+
+    if (range.large)
+    {
+        std::vector<std::size_t>::iterator it = std::find(m_largeObjects.begin(), m_largeObjects.end(), id);
+        if (it != m_largeObjects.end())
+            m_largeObjects.erase(it);
+        return;
+    }
+
+    for (int x = range.left; x <= range.right; ++x)
+    {
+        for (int y = range.top; y <= range.bottom; ++y)
+        {
+            Uint64 key = cellKey(x, y);
+            std::vector<std::size_t>* ids = m_cells->find(key);
+            if (!ids)
+                continue;
+
+            // The order of the objects within a cell doesn't matter, swap with the last one
+            std::vector<std::size_t>::iterator it = std::find(ids->begin(), ids->end(), id);
+            if (it != ids->end())
+            {
+                *it = ids->back();
+                ids->pop_back();
+            }
+
+            // Release empty cells
+            if (ids->empty())
+                m_cells->erase(key);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneIndex::collect(const std::vector<std::size_t>& ids, const FloatRect& area, Uint64 stamp,
+                         std::vector<std::pair<Uint64, std::size_t> >& result) const
+{
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        const Object& object = m_objects[ids[i]];
+        if (object.stamp == stamp)
+            continue;
+
+        object.stamp = stamp;
+        if (object.bounds.intersects(area))
+            result.push_back(std::make_pair(object.order, ids[i]));
+    }
+}
+
+} // namespace sf
@@ -31,12 +31,18 @@
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/ProgrammableRenderer.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <vector>
 
 
@@ -58,6 +64,25 @@ namespace
 {
     sf::Mutex maxTextureUnitsMutex;
     sf::Mutex isAvailableMutex;
+    sf::Mutex binaryCacheMutex;
+    sf::Mutex idMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used for the uniform locations cache (see RenderTarget)
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(idMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no program"
+
+        return id++;
+    }
+
+    // Directory where the program binaries are stored, empty if the cache is disabled
+    std::string binaryCacheDirectory;
+
+    // Tag written at the beginning of the program binary files
+    const char binaryCacheTag[4] = {'S', 'F', 'P', 'B'};
 
     GLint checkMaxTextureUnits()
     {
@@ -78,6 +103,159 @@ namespace
         return maxUnits;
     }
 
+    // FNV-1a hash of a string, starting from the given basis
+    sf::Uint32 hashString(const std::string& string, sf::Uint32 hash)
+    {
+        for (std::string::const_iterator it = string.begin(); it != string.end(); ++it)
+        {
+            hash ^= static_cast<unsigned char>(*it);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    // Get an OpenGL string, empty if not available
+    std::string getGlString(GLenum name)
+    {
+        const GLubyte* string = NULL;
+        glCheck(string = glGetString(name));
+
+        return string ? reinterpret_cast<const char*>(string) : "";
+    }
+
+    // Get the path of the program binary file for the given sources, empty if the cache can't be used
+    std::string getBinaryCachePath(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+    {
+        std::string directory;
+        {
+            sf::Lock lock(binaryCacheMutex);
+            directory = binaryCacheDirectory;
+        }
+
+        if (directory.empty() || !GLEXT_get_program_binary)
+            return "";
+
+        // Program binaries only work with the driver that created them,
+        // so the driver identification is part of the key
+        std::string key = getGlString(GL_VENDOR) + '\n' + getGlString(GL_RENDERER) + '\n' + getGlString(GL_VERSION);
+        key += "\nvertex\n";
+        key += vertexShaderCode ? vertexShaderCode : "";
+        key += "\ngeometry\n";
+        key += geometryShaderCode ? geometryShaderCode : "";
+        key += "\nfragment\n";
+        key += fragmentShaderCode ? fragmentShaderCode : "";
+
+        // Two hashes with different bases give a 64 bits key
+        std::ostringstream path;
+        path << directory;
+        if ((directory[directory.size() - 1] != '/') && (directory[directory.size() - 1] != '\\'))
+            path << '/';
+        path << std::hex << std::setfill('0')
+             << std::setw(8) << hashString(key, 2166136261u)
+             << std::setw(8) << hashString(key, 3735928559u)
+             << ".bin";
+
+        return path.str();
+    }
+
+    // Create a program from a binary file of the cache, returns 0 if the file doesn't exist or is rejected
+    GLEXT_GLhandle loadProgramBinary(const std::string& path)
+    {
+        if (path.empty())
+            return 0;
+
+        std::ifstream file(path.c_str(), std::ios_base::binary);
+        if (!file)
+            return 0;
+
+        // Read the header: tag, binary format and size
+        char tag[4];
+        sf::Uint32 format = 0;
+        sf::Uint32 size = 0;
+        file.read(tag, sizeof(tag));
+        file.read(reinterpret_cast<char*>(&format), sizeof(format));
+        file.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!file || (std::memcmp(tag, binaryCacheTag, sizeof(tag)) != 0) || (size == 0))
+            return 0;
+
+        // Don't trust the stored size: a truncated or corrupted file must not trigger a huge allocation
+        std::streampos dataStart = file.tellg();
+        file.seekg(0, std::ios_base::end);
+        std::streamoff remaining = file.tellg() - dataStart;
+        file.seekg(dataStart);
+        if (!file || (remaining < static_cast<std::streamoff>(size)))
+            return 0;
+
+        std::vector<char> binary(size);
+        if (!file.read(&binary[0], static_cast<std::streamsize>(size)))
+            return 0;
+
+        GLEXT_GLhandle program;
+        glCheck(program = GLEXT_glCreateProgramObject());
+
+        // The driver may reject the binary, for example after it was updated: this is
+        // expected and the caller compiles the sources instead, so don't report the
+        // error (usually GL_INVALID_ENUM) and check the link status instead
+        GLEXT_glProgramBinary(castFromGlHandle(program), static_cast<GLenum>(format), &binary[0], static_cast<GLsizei>(size));
+        glGetError();
+
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            glCheck(GLEXT_glDeleteObject(program));
+            return 0;
+        }
+
+        return program;
+    }
+
+    // Write the binary of a linked program to the cache
+    void saveProgramBinary(GLEXT_GLhandle program, const std::string& path, std::ostream& errors)
+    {
+        GLint size = 0;
+        glCheck(GLEXT_glGetProgramiv(castFromGlHandle(program), GLEXT_GL_PROGRAM_BINARY_LENGTH, &size));
+        if (size <= 0)
+            return;
+
+        std::vector<char> binary(static_cast<std::size_t>(size));
+        GLsizei written = 0;
+        GLenum format = 0;
+        glCheck(GLEXT_glGetProgramBinary(castFromGlHandle(program), size, &written, &format, &binary[0]));
+        if (written <= 0)
+            return;
+
+        std::ofstream file(path.c_str(), std::ios_base::binary);
+        if (!file)
+        {
+            errors << "Failed to save shader binary to \"" << path << "\"" << std::endl;
+            return;
+        }
+
+        sf::Uint32 header[2] = {static_cast<sf::Uint32>(format), static_cast<sf::Uint32>(written)};
+        file.write(binaryCacheTag, sizeof(binaryCacheTag));
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(&binary[0], written);
+    }
+
+    // Check the status of a shader or program object, and print its log on failure
+    bool checkObjectStatus(GLEXT_GLhandle object, GLenum status, const char* description)
+    {
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(object, status, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(object, sizeof(log), 0, log));
+            sf::err() << "Failed to " << description << ":" << std::endl
+                      << log << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
     // Read the contents of a file into an array of char
     bool getFileContents(const std::string& filename, std::vector<char>& buffer)
     {
@@ -197,6 +375,9 @@ struct Shader::UniformBinder : private NonCopyable
 
             // Store uniform location for further use outside constructor
             location = shader.getUniformLocation(name);
+
+            // The value set through a handle, if any, is now out of date
+            shader.invalidateUniformValue(location);
         }
     }
 
@@ -218,12 +399,158 @@ struct Shader::UniformBinder : private NonCopyable
 };
 
 
+////////////////////////////////////////////////////////////
+struct Shader::AsyncCompilation : private NonCopyable
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor: copy the source codes
+    ///
+    ////////////////////////////////////////////////////////////
+    AsyncCompilation(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode) :
+    vertexCode  (copyCode(vertexShaderCode)),
+    geometryCode(copyCode(geometryShaderCode)),
+    fragmentCode(copyCode(fragmentShaderCode)),
+    clock       (),
+    parallel    (false),
+    program     (0),
+    binaryPath  (),
+    shader      (),
+    errors      (),
+    mutex       (),
+    finished    (false),
+    thread      (&AsyncCompilation::run, this)
+    {
+        for (int i = 0; i < 3; ++i)
+            shaders[i] = 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor: wait for the compilation if it is still running
+    ///
+    /// The worker thread must already be finished if the calling
+    /// thread holds a context lock, see joinWorker.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AsyncCompilation()
+    {
+        // Wait for the worker thread before destroying what it uses
+        thread.wait();
+
+        if (parallel)
+        {
+            TransientContextLock lock;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                if (shaders[i])
+                    glCheck(GLEXT_glDeleteObject(shaders[i]));
+            }
+
+            if (program)
+                glCheck(GLEXT_glDeleteObject(program));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the compilation is done, without blocking
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFinished()
+    {
+        if (parallel)
+        {
+            TransientContextLock lock;
+
+            GLint completed = GL_FALSE;
+            glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_COMPLETION_STATUS, &completed));
+            return completed != GL_FALSE;
+        }
+
+        Lock lock(mutex);
+        return finished;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Worker thread: compile the sources in a new context
+    ///
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        {
+            // The context is shared with all the others, so the
+            // program created here can be used in any of them
+            Context context;
+
+            // sf::err() is not thread-safe: the messages are printed by the owning thread
+            shader.compile(getCode(vertexCode), getCode(geometryCode), getCode(fragmentCode), errors);
+        }
+
+        Lock lock(mutex);
+        finished = true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the worker thread is finished
+    ///
+    /// This must be called before taking a TransientContextLock:
+    /// without an active context, the lock holds the global
+    /// context mutex, which the worker thread needs to create
+    /// and destroy its own context.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void joinWorker(AsyncCompilation* compilation)
+    {
+        if (compilation)
+            compilation->thread.wait();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy a null-terminated source code, empty if null
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::vector<char> copyCode(const char* code)
+    {
+        return code ? std::vector<char>(code, code + std::strlen(code) + 1) : std::vector<char>();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a copied source code, null if empty
+    ///
+    ////////////////////////////////////////////////////////////
+    static const char* getCode(const std::vector<char>& code)
+    {
+        return code.empty() ? NULL : &code[0];
+    }
+
+    std::vector<char> vertexCode;   //!< Source code of the vertex shader
+    std::vector<char> geometryCode; //!< Source code of the geometry shader
+    std::vector<char> fragmentCode; //!< Source code of the fragment shader
+    Clock             clock;        //!< Time since the compilation started
+    bool              parallel;     //!< Is the driver compiling in its own threads?
+    GLEXT_GLhandle    program;      //!< Program being linked by the driver
+    GLEXT_GLhandle    shaders[3];   //!< Shaders being compiled by the driver (vertex, geometry, fragment)
+    std::string       binaryPath;   //!< Path of the program in the binary cache, if enabled
+    Shader            shader;       //!< Shader compiled by the worker thread
+    std::ostringstream errors;      //!< Error messages of the worker thread
+    Mutex             mutex;        //!< Mutex protecting the finished flag
+    bool              finished;     //!< Has the worker thread finished?
+    Thread            thread;       //!< Worker thread, used if the driver can't compile in parallel
+};
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
+m_programId     (0),
 m_currentTexture(-1),
 m_textures      (),
-m_uniforms      ()
+m_uniforms      (),
+m_uniformValues (),
+m_modifiedValues(),
+m_compileTime   (),
+m_isLoadedFromBinaryCache(false),
+m_hasAsyncLoadFailed(false),
+m_asyncCompilation(NULL)
 {
 }
 
@@ -231,8 +558,14 @@ m_uniforms      ()
 ////////////////////////////////////////////////////////////
 Shader::~Shader()
 {
+    // Let the asynchronous compilation finish, there's no way to interrupt the driver
+    AsyncCompilation::joinWorker(m_asyncCompilation);
+
     TransientContextLock lock;
 
+    // Discard the result of the asynchronous compilation
+    delete m_asyncCompilation;
+
     // Destroy effect program
     if (m_shaderProgram)
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
@@ -422,6 +755,132 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geomet
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFileAsync(const std::string& filename, Type type)
+{
+    // Read the file
+    std::vector<char> shader;
+    if (!getFileContents(filename, shader))
+    {
+        err() << "Failed to open shader file \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    // Start compiling the shader program
+    if (type == Vertex)
+        return compileAsync(&shader[0], NULL, NULL);
+    else if (type == Geometry)
+        return compileAsync(NULL, &shader[0], NULL);
+    else
+        return compileAsync(NULL, NULL, &shader[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFileAsync(const std::string& vertexShaderFilename, const std::string& fragmentShaderFilename)
+{
+    // Read the vertex shader file
+    std::vector<char> vertexShader;
+    if (!getFileContents(vertexShaderFilename, vertexShader))
+    {
+        err() << "Failed to open vertex shader file \"" << vertexShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Read the fragment shader file
+    std::vector<char> fragmentShader;
+    if (!getFileContents(fragmentShaderFilename, fragmentShader))
+    {
+        err() << "Failed to open fragment shader file \"" << fragmentShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Start compiling the shader program
+    return compileAsync(&vertexShader[0], NULL, &fragmentShader[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFileAsync(const std::string& vertexShaderFilename, const std::string& geometryShaderFilename, const std::string& fragmentShaderFilename)
+{
+    // Read the vertex shader file
+    std::vector<char> vertexShader;
+    if (!getFileContents(vertexShaderFilename, vertexShader))
+    {
+        err() << "Failed to open vertex shader file \"" << vertexShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Read the geometry shader file
+    std::vector<char> geometryShader;
+    if (!getFileContents(geometryShaderFilename, geometryShader))
+    {
+        err() << "Failed to open geometry shader file \"" << geometryShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Read the fragment shader file
+    std::vector<char> fragmentShader;
+    if (!getFileContents(fragmentShaderFilename, fragmentShader))
+    {
+        err() << "Failed to open fragment shader file \"" << fragmentShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Start compiling the shader program
+    return compileAsync(&vertexShader[0], &geometryShader[0], &fragmentShader[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const std::string& shader, Type type)
+{
+    // Start compiling the shader program
+    if (type == Vertex)
+        return compileAsync(shader.c_str(), NULL, NULL);
+    else if (type == Geometry)
+        return compileAsync(NULL, shader.c_str(), NULL);
+    else
+        return compileAsync(NULL, NULL, shader.c_str());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const std::string& vertexShader, const std::string& fragmentShader)
+{
+    // Start compiling the shader program
+    return compileAsync(vertexShader.c_str(), NULL, fragmentShader.c_str());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader)
+{
+    // Start compiling the shader program
+    return compileAsync(vertexShader.c_str(), geometryShader.c_str(), fragmentShader.c_str());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady()
+{
+    if (m_asyncCompilation && m_asyncCompilation->isFinished())
+        finishAsyncCompilation();
+
+    return !m_asyncCompilation;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::wait()
+{
+    if (m_asyncCompilation)
+        finishAsyncCompilation();
+
+    return !m_hasAsyncLoadFailed && (m_shaderProgram != 0);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, float x)
 {
@@ -661,102 +1120,296 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x)
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
 {
-    setUniform(name, x);
+    // Return the existing handle if the uniform was already requested
+    for (std::size_t i = 0; i < m_uniformValues.size(); ++i)
+    {
+        if (m_uniformValues[i].name == name)
+            return UniformHandle(static_cast<int>(i));
+    }
+
+    if (!m_shaderProgram)
+        return UniformHandle();
+
+    TransientContextLock lock;
+
+    int location = getUniformLocation(name);
+    if (location == -1)
+        return UniformHandle();
+
+    UniformValue value;
+    value.name     = name;
+    value.location = location;
+    value.type     = UniformValue::None;
+    value.modified = false;
+    m_uniformValues.push_back(value);
+
+    return UniformHandle(static_cast<int>(m_uniformValues.size() - 1));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x, float y)
+void Shader::setUniform(UniformHandle uniform, float x)
 {
-    setUniform(name, Glsl::Vec2(x, y));
+    setUniformValue(uniform, UniformValue::Float1, &x, NULL, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x, float y, float z)
+void Shader::setUniform(UniformHandle uniform, const Glsl::Vec2& v)
 {
-    setUniform(name, Glsl::Vec3(x, y, z));
+    const float values[2] = {v.x, v.y};
+    setUniformValue(uniform, UniformValue::Float2, values, NULL, 2);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x, float y, float z, float w)
+void Shader::setUniform(UniformHandle uniform, const Glsl::Vec3& v)
 {
-    setUniform(name, Glsl::Vec4(x, y, z, w));
+    const float values[3] = {v.x, v.y, v.z};
+    setUniformValue(uniform, UniformValue::Float3, values, NULL, 3);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Vector2f& v)
+void Shader::setUniform(UniformHandle uniform, const Glsl::Vec4& v)
 {
-    setUniform(name, v);
+    const float values[4] = {v.x, v.y, v.z, v.w};
+    setUniformValue(uniform, UniformValue::Float4, values, NULL, 4);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Vector3f& v)
+void Shader::setUniform(UniformHandle uniform, int x)
 {
-    setUniform(name, v);
+    setUniformValue(uniform, UniformValue::Int1, NULL, &x, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Color& color)
+void Shader::setUniform(UniformHandle uniform, const Glsl::Ivec2& v)
 {
-    setUniform(name, Glsl::Vec4(color));
+    const int values[2] = {v.x, v.y};
+    setUniformValue(uniform, UniformValue::Int2, NULL, values, 2);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Transform& transform)
+void Shader::setUniform(UniformHandle uniform, const Glsl::Ivec3& v)
 {
-    setUniform(name, Glsl::Mat4(transform));
+    const int values[3] = {v.x, v.y, v.z};
+    setUniformValue(uniform, UniformValue::Int3, NULL, values, 3);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Texture& texture)
+void Shader::setUniform(UniformHandle uniform, const Glsl::Ivec4& v)
 {
-    setUniform(name, texture);
+    const int values[4] = {v.x, v.y, v.z, v.w};
+    setUniformValue(uniform, UniformValue::Int4, NULL, values, 4);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, CurrentTextureType)
+void Shader::setUniform(UniformHandle uniform, bool x)
 {
-    setUniform(name, CurrentTexture);
+    setUniform(uniform, static_cast<int>(x));
 }
 
 
 ////////////////////////////////////////////////////////////
-unsigned int Shader::getNativeHandle() const
+void Shader::setUniform(UniformHandle uniform, const Glsl::Bvec2& v)
 {
-    return m_shaderProgram;
+    setUniform(uniform, Glsl::Ivec2(v));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::bind(const Shader* shader)
+void Shader::setUniform(UniformHandle uniform, const Glsl::Bvec3& v)
 {
-    TransientContextLock lock;
-
-    // Make sure that we can use shaders
-    if (!isAvailable())
-    {
-        err() << "Failed to bind or unbind shader: your system doesn't support shaders "
-              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
-        return;
-    }
+    setUniform(uniform, Glsl::Ivec3(v));
+}
 
-    if (shader && shader->m_shaderProgram)
-    {
-        // Enable the program
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Bvec4& v)
+{
+    setUniform(uniform, Glsl::Ivec4(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Mat3& matrix)
+{
+    setUniformValue(uniform, UniformValue::Matrix3, matrix.array, NULL, 3 * 3);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Mat4& matrix)
+{
+    setUniformValue(uniform, UniformValue::Matrix4, matrix.array, NULL, 4 * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformBlock(const std::string& name, unsigned int bindingPoint)
+{
+    if (m_shaderProgram)
+    {
+        TransientContextLock lock;
+
+        if (!GLEXT_uniform_buffer_object)
+        {
+            err() << "Failed to set uniform block \"" << name << "\": your system doesn't support uniform buffers" << std::endl;
+            return;
+        }
+
+        // Find the index of the block in the shader
+        GLuint index = GLEXT_GL_INVALID_INDEX;
+        glCheck(index = GLEXT_glGetUniformBlockIndex(m_shaderProgram, name.c_str()));
+        if (index == GLEXT_GL_INVALID_INDEX)
+        {
+            err() << "Uniform block \"" << name << "\" not found in shader" << std::endl;
+            return;
+        }
+
+        glCheck(GLEXT_glUniformBlockBinding(m_shaderProgram, index, bindingPoint));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x)
+{
+    setUniform(name, x);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x, float y)
+{
+    setUniform(name, Glsl::Vec2(x, y));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x, float y, float z)
+{
+    setUniform(name, Glsl::Vec3(x, y, z));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x, float y, float z, float w)
+{
+    setUniform(name, Glsl::Vec4(x, y, z, w));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Vector2f& v)
+{
+    setUniform(name, v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Vector3f& v)
+{
+    setUniform(name, v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Color& color)
+{
+    setUniform(name, Glsl::Vec4(color));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Transform& transform)
+{
+    setUniform(name, Glsl::Mat4(transform));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Texture& texture)
+{
+    setUniform(name, texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, CurrentTextureType)
+{
+    setUniform(name, CurrentTexture);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Shader::getNativeHandle() const
+{
+    return m_shaderProgram;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Shader::getCompileTime() const
+{
+    return m_compileTime;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isLoadedFromBinaryCache() const
+{
+    return m_isLoadedFromBinaryCache;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+    Lock lock(binaryCacheMutex);
+
+    binaryCacheDirectory = directory;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bind(const Shader* shader)
+{
+    bind(shader, true);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bind(const Shader* shader, bool useTextureMatrix)
+{
+    TransientContextLock lock;
+
+    // Make sure that we can use shaders
+    if (!isAvailable())
+    {
+        err() << "Failed to bind or unbind shader: your system doesn't support shaders "
+              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
+        return;
+    }
+
+    if (shader && shader->m_shaderProgram)
+    {
+        // Enable the program
+        glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
+
+        // Send the uniform values that were set through handles
+        shader->applyUniformValues();
 
         // Bind the textures
-        shader->bindTextures();
+        shader->bindTextures(useTextureMatrix);
 
         // Bind the current texture
         if (shader->m_currentTexture != -1)
@@ -825,24 +1478,39 @@ bool Shader::isGeometryAvailable()
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
 {
+    return compile(vertexShaderCode, geometryShaderCode, fragmentShaderCode, err());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode, std::ostream& errors)
+{
+    AsyncCompilation::joinWorker(m_asyncCompilation);
+
     TransientContextLock lock;
 
+    m_hasAsyncLoadFailed = false;
+
     // First make sure that we can use shaders
     if (!isAvailable())
     {
-        err() << "Failed to create a shader: your system doesn't support shaders "
-              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
+        errors << "Failed to create a shader: your system doesn't support shaders "
+               << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
         return false;
     }
 
     // Make sure we can use geometry shaders
     if (geometryShaderCode && !isGeometryAvailable())
     {
-        err() << "Failed to create a shader: your system doesn't support geometry shaders "
-              << "(you should test Shader::isGeometryAvailable() before trying to use geometry shaders)" << std::endl;
+        errors << "Failed to create a shader: your system doesn't support geometry shaders "
+               << "(you should test Shader::isGeometryAvailable() before trying to use geometry shaders)" << std::endl;
         return false;
     }
 
+    // Discard the result of the asynchronous compilation, if any
+    delete m_asyncCompilation;
+    m_asyncCompilation = NULL;
+
     // Destroy the shader if it was already created
     if (m_shaderProgram)
     {
@@ -855,8 +1523,24 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     m_textures.clear();
     m_uniforms.clear();
 
+    Clock clock;
+
+    // Look for the program in the binary cache first, compile the sources
+    // if it is not there or if the driver rejects the stored binary
+    const std::string binaryPath = getBinaryCachePath(vertexShaderCode, geometryShaderCode, fragmentShaderCode);
+    GLEXT_GLhandle shaderProgram = loadProgramBinary(binaryPath);
+    m_isLoadedFromBinaryCache = (shaderProgram != 0);
+
+    if (m_isLoadedFromBinaryCache)
+    {
+        m_shaderProgram = castFromGlHandle(shaderProgram);
+        resetUniforms();
+        glCheck(glFlush());
+        m_compileTime = clock.getElapsedTime();
+        return true;
+    }
+
     // Create the program
-    GLEXT_GLhandle shaderProgram;
     glCheck(shaderProgram = GLEXT_glCreateProgramObject());
 
     // Create the vertex shader if needed
@@ -875,8 +1559,8 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         {
             char log[1024];
             glCheck(GLEXT_glGetInfoLog(vertexShader, sizeof(log), 0, log));
-            err() << "Failed to compile vertex shader:" << std::endl
-                  << log << std::endl;
+            errors << "Failed to compile vertex shader:" << std::endl
+                   << log << std::endl;
             glCheck(GLEXT_glDeleteObject(vertexShader));
             glCheck(GLEXT_glDeleteObject(shaderProgram));
             return false;
@@ -902,8 +1586,8 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         {
             char log[1024];
             glCheck(GLEXT_glGetInfoLog(geometryShader, sizeof(log), 0, log));
-            err() << "Failed to compile geometry shader:" << std::endl
-                  << log << std::endl;
+            errors << "Failed to compile geometry shader:" << std::endl
+                   << log << std::endl;
             glCheck(GLEXT_glDeleteObject(geometryShader));
             glCheck(GLEXT_glDeleteObject(shaderProgram));
             return false;
@@ -930,8 +1614,8 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         {
             char log[1024];
             glCheck(GLEXT_glGetInfoLog(fragmentShader, sizeof(log), 0, log));
-            err() << "Failed to compile fragment shader:" << std::endl
-                  << log << std::endl;
+            errors << "Failed to compile fragment shader:" << std::endl
+                   << log << std::endl;
             glCheck(GLEXT_glDeleteObject(fragmentShader));
             glCheck(GLEXT_glDeleteObject(shaderProgram));
             return false;
@@ -942,6 +1626,14 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         glCheck(GLEXT_glDeleteObject(fragmentShader));
     }
 
+    // Give the vertex attributes of the programmable render target backend
+    // fixed locations, in case the shader declares them
+    priv::ProgrammableRenderer::bindAttributeLocations(castFromGlHandle(shaderProgram));
+
+    // Let the driver know that we will read back the program binary
+    if (!binaryPath.empty())
+        glCheck(GLEXT_glProgramParameteri(castFromGlHandle(shaderProgram), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
     // Link the program
     glCheck(GLEXT_glLinkProgram(shaderProgram));
 
@@ -952,24 +1644,203 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     {
         char log[1024];
         glCheck(GLEXT_glGetInfoLog(shaderProgram, sizeof(log), 0, log));
-        err() << "Failed to link shader:" << std::endl
-              << log << std::endl;
+        errors << "Failed to link shader:" << std::endl
+               << log << std::endl;
         glCheck(GLEXT_glDeleteObject(shaderProgram));
         return false;
     }
 
+    // Store the program in the binary cache for the next launches
+    if (!binaryPath.empty())
+        saveProgramBinary(shaderProgram, binaryPath, errors);
+
     m_shaderProgram = castFromGlHandle(shaderProgram);
 
+    // Look up the uniforms accessed through handles in the new program
+    resetUniforms();
+
     // Force an OpenGL flush, so that the shader will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
     glCheck(glFlush());
 
+    m_compileTime = clock.getElapsedTime();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::compileAsync(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+{
+    AsyncCompilation::joinWorker(m_asyncCompilation);
+
+    TransientContextLock lock;
+
+    m_hasAsyncLoadFailed = false;
+
+    // First make sure that we can use shaders
+    if (!isAvailable())
+    {
+        err() << "Failed to create a shader: your system doesn't support shaders "
+              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
+        return false;
+    }
+
+    // Make sure we can use geometry shaders
+    if (geometryShaderCode && !isGeometryAvailable())
+    {
+        err() << "Failed to create a shader: your system doesn't support geometry shaders "
+              << "(you should test Shader::isGeometryAvailable() before trying to use geometry shaders)" << std::endl;
+        return false;
+    }
+
+    // Discard the result of the previous asynchronous compilation, if any
+    delete m_asyncCompilation;
+    m_asyncCompilation = new AsyncCompilation(vertexShaderCode, geometryShaderCode, fragmentShaderCode);
+
+    if (!GLEXT_parallel_shader_compile)
+    {
+        // Compile in a worker thread, which has its own context
+        m_asyncCompilation->thread.launch();
+        return true;
+    }
+
+    // The driver compiles in its own threads: submit all the work,
+    // but don't query the results since it would wait for them
+    AsyncCompilation& compilation = *m_asyncCompilation;
+    compilation.parallel = true;
+    compilation.binaryPath = getBinaryCachePath(vertexShaderCode, geometryShaderCode, fragmentShaderCode);
+
+    // Loading from the binary cache is fast enough to be done right now
+    compilation.program = loadProgramBinary(compilation.binaryPath);
+    if (compilation.program)
+    {
+        compilation.binaryPath.clear();
+        finishAsyncCompilation();
+        m_isLoadedFromBinaryCache = true;
+        return true;
+    }
+
+    glCheck(compilation.program = GLEXT_glCreateProgramObject());
+
+    const char* codes[3] = {vertexShaderCode, geometryShaderCode, fragmentShaderCode};
+    const GLenum types[3] = {GLEXT_GL_VERTEX_SHADER, GLEXT_GL_GEOMETRY_SHADER, GLEXT_GL_FRAGMENT_SHADER};
+    for (int i = 0; i < 3; ++i)
+    {
+        if (codes[i])
+        {
+            glCheck(compilation.shaders[i] = GLEXT_glCreateShaderObject(types[i]));
+            glCheck(GLEXT_glShaderSource(compilation.shaders[i], 1, &codes[i], NULL));
+            glCheck(GLEXT_glCompileShader(compilation.shaders[i]));
+            glCheck(GLEXT_glAttachObject(compilation.program, compilation.shaders[i]));
+        }
+    }
+
+    priv::ProgrammableRenderer::bindAttributeLocations(castFromGlHandle(compilation.program));
+
+    // Let the driver know that we will read back the program binary
+    if (!compilation.binaryPath.empty())
+        glCheck(GLEXT_glProgramParameteri(castFromGlHandle(compilation.program), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
+    glCheck(GLEXT_glLinkProgram(compilation.program));
+
     return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::bindTextures() const
+void Shader::finishAsyncCompilation()
+{
+    AsyncCompilation::joinWorker(m_asyncCompilation);
+
+    TransientContextLock lock;
+
+    AsyncCompilation& compilation = *m_asyncCompilation;
+    GLEXT_GLhandle program = 0;
+
+    if (compilation.parallel)
+    {
+        // Querying the status waits for the driver if it is not done yet
+        static const char* descriptions[3] = {"compile vertex shader", "compile geometry shader", "compile fragment shader"};
+
+        bool success = true;
+        for (int i = 0; (i < 3) && success; ++i)
+        {
+            if (compilation.shaders[i])
+                success = checkObjectStatus(compilation.shaders[i], GLEXT_GL_OBJECT_COMPILE_STATUS, descriptions[i]);
+        }
+
+        if (success && checkObjectStatus(compilation.program, GLEXT_GL_OBJECT_LINK_STATUS, "link shader"))
+        {
+            // Store the program in the binary cache for the next launches
+            if (!compilation.binaryPath.empty())
+                saveProgramBinary(compilation.program, compilation.binaryPath, sf::err());
+
+            // Take ownership of the program
+            program = compilation.program;
+            compilation.program = 0;
+        }
+
+    }
+    else
+    {
+        // Print the errors of the worker thread from this one
+        const std::string errors = compilation.errors.str();
+        if (!errors.empty())
+            err() << errors << std::flush;
+
+        // Take ownership of the program compiled by the worker thread
+        program = castToGlHandle(compilation.shader.m_shaderProgram);
+        compilation.shader.m_shaderProgram = 0;
+    }
+
+    if (program)
+    {
+        // Replace the previous program
+        if (m_shaderProgram)
+            glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+
+        m_shaderProgram = castFromGlHandle(program);
+        m_compileTime = compilation.clock.getElapsedTime();
+        m_isLoadedFromBinaryCache = !compilation.parallel && compilation.shader.m_isLoadedFromBinaryCache;
+    }
+
+    // On failure, the previous program is kept so that drawing keeps working
+    m_hasAsyncLoadFailed = !program;
+
+    delete m_asyncCompilation;
+    m_asyncCompilation = NULL;
+
+    if (program)
+        resetUniforms();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::resetUniforms()
+{
+    m_programId = m_shaderProgram ? getUniqueId() : 0;
+    m_currentTexture = -1;
+    m_textures.clear();
+    m_uniforms.clear();
+
+    // Look up the uniforms accessed through handles again,
+    // their current values will be sent the next time the program is bound
+    m_modifiedValues.clear();
+    for (std::size_t i = 0; i < m_uniformValues.size(); ++i)
+    {
+        UniformValue& value = m_uniformValues[i];
+        value.location = m_shaderProgram ? getUniformLocation(value.name) : -1;
+        value.modified = (value.type != UniformValue::None);
+
+        if (value.modified)
+            m_modifiedValues.push_back(i);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindTextures(bool useTextureMatrix) const
 {
     TextureTable::const_iterator it = m_textures.begin();
     for (std::size_t i = 0; i < m_textures.size(); ++i)
@@ -977,7 +1848,21 @@ void Shader::bindTextures() const
         GLint index = static_cast<GLsizei>(i + 1);
         glCheck(GLEXT_glUniform1i(it->first, index));
         glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + index));
-        Texture::bind(it->second);
+
+        if (useTextureMatrix)
+        {
+            Texture::bind(it->second);
+        }
+        else if (it->second->m_layerCount)
+        {
+            glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, it->second->m_texture));
+        }
+        else
+        {
+            glCheck(glBindTexture(GL_TEXTURE_2D, it->second->m_texture));
+        }
+
         ++it;
     }
 
@@ -1009,6 +1894,91 @@ int Shader::getUniformLocation(const std::string& name)
     }
 }
 
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformValue(UniformHandle uniform, int type, const float* floats, const int* ints, std::size_t count)
+{
+    if ((uniform.m_index < 0) || (static_cast<std::size_t>(uniform.m_index) >= m_uniformValues.size()))
+        return;
+
+    UniformValue& value = m_uniformValues[static_cast<std::size_t>(uniform.m_index)];
+
+    // Nothing to do if the program already has this value
+    if (value.type == type)
+    {
+        if (floats && (std::memcmp(value.floats, floats, count * sizeof(float)) == 0))
+            return;
+
+        if (ints && (std::memcmp(value.ints, ints, count * sizeof(int)) == 0))
+            return;
+    }
+
+    if (floats)
+        std::memcpy(value.floats, floats, count * sizeof(float));
+    else
+        std::memcpy(value.ints, ints, count * sizeof(int));
+
+    value.type = static_cast<UniformValue::Type>(type);
+
+    if (!value.modified)
+    {
+        value.modified = true;
+        m_modifiedValues.push_back(static_cast<std::size_t>(uniform.m_index));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::invalidateUniformValue(int location)
+{
+    if (location == -1)
+        return;
+
+    for (std::size_t i = 0; i < m_uniformValues.size(); ++i)
+    {
+        UniformValue& value = m_uniformValues[i];
+        if (value.location == location)
+        {
+            // A pending value is skipped by applyUniformValues, and the
+            // next value set through the handle is never considered unchanged
+            value.type = UniformValue::None;
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::applyUniformValues() const
+{
+    for (std::vector<std::size_t>::const_iterator it = m_modifiedValues.begin(); it != m_modifiedValues.end(); ++it)
+    {
+        UniformValue& value = m_uniformValues[*it];
+        value.modified = false;
+
+        if (value.location == -1)
+            continue;
+
+        switch (value.type)
+        {
+            case UniformValue::Float1:  glCheck(GLEXT_glUniform1fv(value.location, 1, value.floats));                  break;
+            case UniformValue::Float2:  glCheck(GLEXT_glUniform2fv(value.location, 1, value.floats));                  break;
+            case UniformValue::Float3:  glCheck(GLEXT_glUniform3fv(value.location, 1, value.floats));                  break;
+            case UniformValue::Float4:  glCheck(GLEXT_glUniform4fv(value.location, 1, value.floats));                  break;
+            case UniformValue::Int1:    glCheck(GLEXT_glUniform1iv(value.location, 1, value.ints));                    break;
+            case UniformValue::Int2:    glCheck(GLEXT_glUniform2iv(value.location, 1, value.ints));                    break;
+            case UniformValue::Int3:    glCheck(GLEXT_glUniform3iv(value.location, 1, value.ints));                    break;
+            case UniformValue::Int4:    glCheck(GLEXT_glUniform4iv(value.location, 1, value.ints));                    break;
+            case UniformValue::Matrix3: glCheck(GLEXT_glUniformMatrix3fv(value.location, 1, GL_FALSE, value.floats)); break;
+            case UniformValue::Matrix4: glCheck(GLEXT_glUniformMatrix4fv(value.location, 1, GL_FALSE, value.floats)); break;
+            default:                                                                                                   break;
+        }
+    }
+
+    m_modifiedValues.clear();
+}
+
 } // namespace sf
 
 #else // SFML_OPENGL_ES
@@ -1024,7 +1994,16 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
-m_currentTexture(-1)
+m_programId     (0),
+m_currentTexture(-1),
+m_textures      (),
+m_uniforms      (),
+m_uniformValues (),
+m_modifiedValues(),
+m_compileTime   (),
+m_isLoadedFromBinaryCache(false),
+m_hasAsyncLoadFailed(false),
+m_asyncCompilation(NULL)
 {
 }
 
@@ -1098,6 +2077,62 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geomet
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFileAsync(const std::string& filename, Type type)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFileAsync(const std::string& vertexShaderFilename, const std::string& fragmentShaderFilename)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFileAsync(const std::string& vertexShaderFilename, const std::string& geometryShaderFilename, const std::string& fragmentShaderFilename)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const std::string& shader, Type type)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const std::string& vertexShader, const std::string& fragmentShader)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady()
+{
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::wait()
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, float x)
 {
@@ -1230,6 +2265,103 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    return UniformHandle();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Vec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Vec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Vec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, int x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Ivec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Ivec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Ivec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, bool x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Bvec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Bvec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Bvec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Mat3& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Glsl::Mat4& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformBlock(const std::string& name, unsigned int bindingPoint)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -1297,6 +2429,26 @@ unsigned int Shader::getNativeHandle() const
 }
 
 
+////////////////////////////////////////////////////////////
+Time Shader::getCompileTime() const
+{
+    return Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isLoadedFromBinaryCache() const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::bind(const Shader* shader)
 {
@@ -1325,7 +2477,13 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
 
 
 ////////////////////////////////////////////////////////////
-void Shader::bindTextures() const
+void Shader::bind(const Shader* shader, bool useTextureMatrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindTextures(bool useTextureMatrix) const
 {
 }
 
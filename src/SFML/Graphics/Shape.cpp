@@ -86,7 +86,7 @@ const Texture* Shape::getTexture() const
 void Shape::setTextureRect(const IntRect& rect)
 {
     m_textureRect = rect;
-    updateTexCoords();
+    m_dirty |= TexCoordsDirty;
 }
 
 
@@ -101,7 +101,7 @@ const IntRect& Shape::getTextureRect() const
 void Shape::setFillColor(const Color& color)
 {
     m_fillColor = color;
-    updateFillColors();
+    m_dirty |= FillColorsDirty;
 }
 
 
@@ -116,7 +116,7 @@ const Color& Shape::getFillColor() const
 void Shape::setOutlineColor(const Color& color)
 {
     m_outlineColor = color;
-    updateOutlineColors();
+    m_dirty |= OutlineColorsDirty;
 }
 
 
@@ -131,7 +131,7 @@ const Color& Shape::getOutlineColor() const
 void Shape::setOutlineThickness(float thickness)
 {
     m_outlineThickness = thickness;
-    update(); // recompute everything because the whole shape must be offset
+    m_dirty |= OutlineDirty; // the fill and the extrusion directions don't depend on the thickness
 }
 
 
@@ -145,6 +145,8 @@ float Shape::getOutlineThickness() const
 ////////////////////////////////////////////////////////////
 FloatRect Shape::getLocalBounds() const
 {
+    ensureGeometryUpdate();
+
     return m_bounds;
 }
 
@@ -165,14 +167,78 @@ m_outlineColor    (255, 255, 255),
 m_outlineThickness(0),
 m_vertices        (TriangleFan),
 m_outlineVertices (TriangleStrip),
+m_outlineNormals  (),
 m_insideBounds    (),
-m_bounds          ()
+m_bounds          (),
+m_dirty           (0)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shape::update()
+{
+    // The points will be fetched again the next time the geometry is needed
+    m_dirty |= PositionsDirty;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::draw(RenderTarget& target, RenderStates states) const
+{
+    ensureGeometryUpdate();
+
+    states.transform *= getTransform();
+
+    // Render the inside
+    states.texture = m_texture;
+    target.draw(m_vertices, states);
+
+    // Render the outline
+    if (m_outlineThickness != 0)
+    {
+        states.texture = NULL;
+        target.draw(m_outlineVertices, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::ensureGeometryUpdate() const
+{
+    // Do nothing, if geometry has not changed
+    if (!m_dirty)
+        return;
+
+    // Rebuilding the positions flags everything that depends on them
+    if (m_dirty & PositionsDirty)
+        updatePositions();
+
+    // Nothing else to update if the shape is degenerate
+    if (m_vertices.getVertexCount() == 0)
+    {
+        m_dirty = 0;
+        return;
+    }
+
+    if (m_dirty & FillColorsDirty)
+        updateFillColors();
+
+    if (m_dirty & TexCoordsDirty)
+        updateTexCoords();
+
+    if (m_dirty & (OutlineNormalsDirty | OutlineDirty))
+        updateOutline();
+
+    if (m_dirty & OutlineColorsDirty)
+        updateOutlineColors();
+
+    m_dirty = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updatePositions() const
 {
     // Get the total number of points of the shape
     std::size_t count = getPointCount();
@@ -183,7 +249,12 @@ void Shape::update()
         return;
     }
 
-    m_vertices.resize(count + 2); // + 2 for center and repeated first point
+    // Only new vertices need their color, existing ones keep it
+    if (m_vertices.getVertexCount() != count + 2)
+    {
+        m_vertices.resize(count + 2); // + 2 for center and repeated first point
+        m_dirty |= FillColorsDirty;
+    }
 
     // Position
     for (std::size_t i = 0; i < count; ++i)
@@ -191,44 +262,19 @@ void Shape::update()
     m_vertices[count + 1].position = m_vertices[1].position;
 
     // Update the bounding rectangle
-    m_vertices[0] = m_vertices[1]; // so that the result of getBounds() is correct
+    m_vertices[0].position = m_vertices[1].position; // so that the result of getBounds() is correct
     m_insideBounds = m_vertices.getBounds();
 
     // Compute the center and make it the first vertex
     m_vertices[0].position.x = m_insideBounds.left + m_insideBounds.width / 2;
     m_vertices[0].position.y = m_insideBounds.top + m_insideBounds.height / 2;
 
-    // Color
-    updateFillColors();
-
-    // Texture coordinates
-    updateTexCoords();
-
-    // Outline
-    updateOutline();
+    m_dirty |= TexCoordsDirty | OutlineNormalsDirty | OutlineDirty;
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shape::draw(RenderTarget& target, RenderStates states) const
-{
-    states.transform *= getTransform();
-
-    // Render the inside
-    states.texture = m_texture;
-    target.draw(m_vertices, states);
-
-    // Render the outline
-    if (m_outlineThickness != 0)
-    {
-        states.texture = NULL;
-        target.draw(m_outlineVertices, states);
-    }
-}
-
-
-////////////////////////////////////////////////////////////
-void Shape::updateFillColors()
+void Shape::updateFillColors() const
 {
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
         m_vertices[i].color = m_fillColor;
@@ -236,7 +282,7 @@ void Shape::updateFillColors()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateTexCoords()
+void Shape::updateTexCoords() const
 {
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
     {
@@ -249,18 +295,10 @@ void Shape::updateTexCoords()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateOutline()
+void Shape::updateOutlineNormals() const
 {
-    // Return if there is no outline
-    if (m_outlineThickness == 0.f)
-    {
-        m_outlineVertices.clear();
-        m_bounds = m_insideBounds;
-        return;
-    }
-
     std::size_t count = m_vertices.getVertexCount() - 2;
-    m_outlineVertices.resize((count + 1) * 2);
+    m_outlineNormals.resize(count);
 
     for (std::size_t i = 0; i < count; ++i)
     {
@@ -284,27 +322,55 @@ void Shape::updateOutline()
 
         // Combine them to get the extrusion direction
         float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
-        Vector2f normal = (n1 + n2) / factor;
+        m_outlineNormals[i] = (n1 + n2) / factor;
+    }
+}
 
-        // Update the outline points
-        m_outlineVertices[i * 2 + 0].position = p1;
-        m_outlineVertices[i * 2 + 1].position = p1 + normal * m_outlineThickness;
+
+////////////////////////////////////////////////////////////
+void Shape::updateOutline() const
+{
+    // Return if there is no outline
+    if (m_outlineThickness == 0.f)
+    {
+        m_outlineVertices.clear();
+        m_outlineNormals.clear();
+        m_bounds = m_insideBounds;
+        return;
+    }
+
+    std::size_t count = m_vertices.getVertexCount() - 2;
+
+    // The extrusion directions only change with the points, not with the thickness
+    if ((m_dirty & OutlineNormalsDirty) || (m_outlineNormals.size() != count))
+        updateOutlineNormals();
+
+    // Only new vertices need their color, existing ones keep it
+    if (m_outlineVertices.getVertexCount() != (count + 1) * 2)
+    {
+        m_outlineVertices.resize((count + 1) * 2);
+        m_dirty |= OutlineColorsDirty;
+    }
+
+    // Update the outline points
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Vector2f& point = m_vertices[i + 1].position;
+        m_outlineVertices[i * 2 + 0].position = point;
+        m_outlineVertices[i * 2 + 1].position = point + m_outlineNormals[i] * m_outlineThickness;
     }
 
     // Duplicate the first point at the end, to close the outline
     m_outlineVertices[count * 2 + 0].position = m_outlineVertices[0].position;
     m_outlineVertices[count * 2 + 1].position = m_outlineVertices[1].position;
 
-    // Update outline colors
-    updateOutlineColors();
-
     // Update the shape's bounds
     m_bounds = m_outlineVertices.getBounds();
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateOutlineColors()
+void Shape::updateOutlineColors() const
 {
     for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
         m_outlineVertices[i].color = m_outlineColor;
@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SHELFPACKER_HPP
+#define SFML_SHELFPACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Packing of rectangles into rows of similar heights
+///
+/// These functions are shared by sf::Font and sf::TextureAtlas.
+/// They work on any \a Shelves structure that provides:
+/// \li \c texture: the sf::Texture in which the rows are placed
+/// \li \c rows: a std::vector of rows, each with \c width, \c top and
+///     \c height members and a (top, height) constructor
+/// \li \c openRows: a std::multimap mapping the height of the rows
+///     which still have free space to their index
+/// \li \c nextRow: the Y position of the next new row
+///
+/// Growing the texture is left to the caller, since the way
+/// the new pixels must be initialized differs.
+///
+////////////////////////////////////////////////////////////
+namespace ShelfPacker
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Index returned when no row can hold a rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::size_t NoRow = static_cast<std::size_t>(-1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the open row that fits a rectangle best
+    ///
+    /// Rows which are much higher than the rectangle are
+    /// ignored, to avoid wasting their space.
+    ///
+    /// \param shelves Rows to search
+    /// \param width   Width of the rectangle
+    /// \param height  Height of the rectangle
+    ///
+    /// \return Index of the row, or NoRow if no open row fits
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Shelves>
+    std::size_t findRow(const Shelves& shelves, unsigned int width, unsigned int height)
+    {
+        unsigned int textureWidth = shelves.texture.getSize().x;
+
+        // Open rows are sorted by height, so the first one that has enough
+        // horizontal space left is the best fit; stop at rows that are too high
+        typedef std::multimap<unsigned int, std::size_t>::const_iterator Iterator;
+        for (Iterator it = shelves.openRows.lower_bound(height); it != shelves.openRows.end(); ++it)
+        {
+            if (static_cast<float>(height) / it->first < 0.7f)
+                break;
+
+            if (width <= textureWidth - shelves.rows[it->second].width)
+                return it->second;
+        }
+
+        return NoRow;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the height of the new row to create for a rectangle
+    ///
+    /// The row is 10% taller than the rectangle, so that it can
+    /// also hold rectangles slightly higher than this one.
+    ///
+    /// \param height Height of the rectangle
+    ///
+    /// \return Height of the row
+    ///
+    ////////////////////////////////////////////////////////////
+    inline unsigned int getRowHeight(unsigned int height)
+    {
+        return height + height / 10;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a new row fits in the current texture
+    ///
+    /// \param shelves Rows of the texture
+    /// \param width   Width that the row must be able to hold
+    /// \param height  Height of the row
+    ///
+    /// \return True if the row fits without growing the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Shelves>
+    bool hasRoomForRow(const Shelves& shelves, unsigned int width, unsigned int height)
+    {
+        return (shelves.nextRow + height <= shelves.texture.getSize().y) && (width <= shelves.texture.getSize().x);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a row at the end of a list of rows
+    ///
+    /// \param rows   List of rows
+    /// \param top    Y position of the row
+    /// \param height Height of the row
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Row>
+    void appendRow(std::vector<Row>& rows, unsigned int top, unsigned int height)
+    {
+        rows.push_back(Row(top, height));
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a new row below the existing ones
+    ///
+    /// The caller must check that it fits with hasRoomForRow.
+    ///
+    /// \param shelves Rows of the texture
+    /// \param height  Height of the row
+    ///
+    /// \return Index of the new row
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Shelves>
+    std::size_t addRow(Shelves& shelves, unsigned int height)
+    {
+        appendRow(shelves.rows, shelves.nextRow, height);
+        shelves.openRows.insert(std::make_pair(height, shelves.rows.size() - 1));
+        shelves.nextRow += height;
+
+        return shelves.rows.size() - 1;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reopen all the rows after the texture got wider
+    ///
+    /// \param shelves Rows of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Shelves>
+    void reopenRows(Shelves& shelves)
+    {
+        shelves.openRows.clear();
+        for (std::size_t i = 0; i < shelves.rows.size(); ++i)
+            shelves.openRows.insert(std::make_pair(shelves.rows[i].height, i));
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Empty a row and make it available again
+    ///
+    /// \param shelves Rows of the texture
+    /// \param index   Index of the row to empty
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Shelves>
+    void resetRow(Shelves& shelves, std::size_t index)
+    {
+        shelves.rows[index].width = 0;
+
+        // Make the row available again, if it was considered full
+        typedef std::multimap<unsigned int, std::size_t>::iterator Iterator;
+        std::pair<Iterator, Iterator> range = shelves.openRows.equal_range(shelves.rows[index].height);
+        for (Iterator it = range.first; it != range.second; ++it)
+        {
+            if (it->second == index)
+                return;
+        }
+
+        shelves.openRows.insert(std::make_pair(shelves.rows[index].height, index));
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve the space of a rectangle at the end of a row
+    ///
+    /// \param shelves Rows of the texture
+    /// \param index   Index of the row, which must have enough free space
+    /// \param width   Width of the rectangle
+    /// \param height  Height of the rectangle
+    ///
+    /// \return Position and size of the rectangle in the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Shelves>
+    IntRect allocate(Shelves& shelves, std::size_t index, unsigned int width, unsigned int height)
+    {
+        IntRect rect(shelves.rows[index].width, shelves.rows[index].top, width, height);
+        shelves.rows[index].width += width;
+
+        // Stop looking for space in rows which are almost full
+        const unsigned int rowHeight = shelves.rows[index].height;
+        if (shelves.texture.getSize().x - shelves.rows[index].width < rowHeight / 4)
+        {
+            typedef std::multimap<unsigned int, std::size_t>::iterator Iterator;
+            std::pair<Iterator, Iterator> range = shelves.openRows.equal_range(rowHeight);
+            for (Iterator it = range.first; it != range.second; ++it)
+            {
+                if (it->second == index)
+                {
+                    shelves.openRows.erase(it);
+                    break;
+                }
+            }
+        }
+
+        return rect;
+    }
+
+} // namespace ShelfPacker
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SHELFPACKER_HPP
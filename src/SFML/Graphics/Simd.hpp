@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SIMD_HPP
+#define SFML_SIMD_HPP
+
+////////////////////////////////////////////////////////////
+// Detect the SIMD instruction set available on the target:
+// SFML_GRAPHICS_SSE2 is defined on x86 processors supporting
+// SSE2 (which includes all x86-64 processors), and
+// SFML_GRAPHICS_NEON on ARM processors supporting NEON.
+// When neither is defined, the scalar code paths are used.
+////////////////////////////////////////////////////////////
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+
+    #define SFML_GRAPHICS_SSE2
+    #include <emmintrin.h>
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+    #define SFML_GRAPHICS_NEON
+    #include <arm_neon.h>
+
+#endif
+
+
+#endif // SFML_SIMD_HPP
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/StreamingVertexBuffer.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <utility>
+
+
+namespace
+{
+    // Index of the first quad using the texture of a quad, with the index of the quad itself;
+    // sorting on this key doesn't depend on where the textures are in memory
+    typedef std::pair<std::size_t, std::size_t> SortKey;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_quads        (),
+m_sortByTexture(false),
+m_vertices     (),
+m_ranges       (),
+m_buffer       (NULL),
+m_needUpdate   (false),
+m_drawCallCount(0),
+m_uploadedBytes(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(const SpriteBatch& copy) :
+Drawable       (copy),
+m_quads        (copy.m_quads),
+m_sortByTexture(copy.m_sortByTexture),
+m_vertices     (),
+m_ranges       (),
+m_buffer       (NULL),
+m_needUpdate   (true),
+m_drawCallCount(0),
+m_uploadedBytes(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::~SpriteBatch()
+{
+    delete m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch& SpriteBatch::operator =(const SpriteBatch& right)
+{
+    // The vertex buffers, if any, are kept, the copied sprites are uploaded on the next draw
+    m_quads         = right.m_quads;
+    m_sortByTexture = right.m_sortByTexture;
+    m_needUpdate    = true;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_quads.clear();
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::reserve(std::size_t spriteCount)
+{
+    m_quads.reserve(spriteCount);
+    m_vertices.reserve(spriteCount * 6);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::add(const Texture& texture, const IntRect& rectangle, const Transform& transform, const Color& color)
+{
+    float width  = static_cast<float>(std::abs(rectangle.width));
+    float height = static_cast<float>(std::abs(rectangle.height));
+
+    float left   = static_cast<float>(rectangle.left);
+    float right  = left + rectangle.width;
+    float top    = static_cast<float>(rectangle.top);
+    float bottom = top + rectangle.height;
+
+    Quad quad;
+    quad.texture = &texture;
+    quad.vertices[0] = Vertex(transform.transformPoint(0, 0),          color, Vector2f(left, top));
+    quad.vertices[1] = Vertex(transform.transformPoint(0, height),     color, Vector2f(left, bottom));
+    quad.vertices[2] = Vertex(transform.transformPoint(width, 0),      color, Vector2f(right, top));
+    quad.vertices[3] = Vertex(transform.transformPoint(width, height), color, Vector2f(right, bottom));
+
+    m_quads.push_back(quad);
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::add(const Sprite& sprite)
+{
+    if (sprite.getTexture())
+        add(*sprite.getTexture(), sprite.getTextureRect(), sprite.getTransform(), sprite.getColor());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getSpriteCount() const
+{
+    return m_quads.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTextureSortingEnabled(bool enabled)
+{
+    if (enabled != m_sortByTexture)
+    {
+        m_sortByTexture = enabled;
+        m_needUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::isTextureSortingEnabled() const
+{
+    return m_sortByTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SpriteBatch::getDrawCallCount() const
+{
+    return m_drawCallCount;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getUploadedByteCount() const
+{
+    return m_uploadedBytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    m_drawCallCount = 0;
+    m_uploadedBytes = 0;
+
+    if (m_quads.empty())
+        return;
+
+    // The vertex buffers are created on the first draw, when a context is known to be available
+    if (!m_buffer)
+        m_buffer = new priv::StreamingVertexBuffer(Triangles);
+
+    if (m_needUpdate)
+    {
+        updateGeometry();
+
+        // If the upload fails, the vertices are drawn from system memory until the next change
+        if (m_buffer->upload(&m_vertices[0], m_vertices.size()))
+            m_uploadedBytes = m_vertices.size() * sizeof(Vertex);
+
+        m_needUpdate = false;
+    }
+
+    for (std::vector<Range>::const_iterator it = m_ranges.begin(); it != m_ranges.end(); ++it)
+    {
+        states.texture = it->texture;
+        m_buffer->draw(target, &m_vertices[0], it->first, it->vertexCount, states);
+
+        ++m_drawCallCount;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::updateGeometry() const
+{
+    // Find the order in which the quads must be drawn
+    std::vector<SortKey> order(m_quads.size());
+    if (m_sortByTexture)
+    {
+        // Group the quads by texture, in the order in which the textures are first used
+        std::map<const Texture*, std::size_t> firstUses;
+        for (std::size_t i = 0; i < m_quads.size(); ++i)
+            order[i] = SortKey(firstUses.insert(std::make_pair(m_quads[i].texture, i)).first->second, i);
+
+        std::sort(order.begin(), order.end());
+    }
+    else
+    {
+        for (std::size_t i = 0; i < m_quads.size(); ++i)
+            order[i] = SortKey(i, i);
+    }
+
+    // Split each quad into two triangles, and start a new range every time the texture changes
+    m_vertices.resize(m_quads.size() * 6);
+    m_ranges.clear();
+
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        const Quad& quad = m_quads[order[i].second];
+        Vertex* vertices = &m_vertices[i * 6];
+
+        vertices[0] = quad.vertices[0];
+        vertices[1] = quad.vertices[1];
+        vertices[2] = quad.vertices[2];
+        vertices[3] = quad.vertices[2];
+        vertices[4] = quad.vertices[1];
+        vertices[5] = quad.vertices[3];
+
+        if (m_ranges.empty() || (m_ranges.back().texture != quad.texture))
+        {
+            Range range = {quad.texture, i * 6, 0};
+            m_ranges.push_back(range);
+        }
+
+        m_ranges.back().vertexCount += 6;
+    }
+}
+
+} // namespace sf
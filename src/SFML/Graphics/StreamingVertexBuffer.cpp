@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StreamingVertexBuffer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+StreamingVertexBuffer::StreamingVertexBuffer(PrimitiveType type) :
+m_current   (0),
+m_isUploaded(false),
+m_type      (type)
+{
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        m_buffers[i].setPrimitiveType(type);
+        m_buffers[i].setUsage(VertexBuffer::Stream);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingVertexBuffer::upload(const Vertex* vertices, std::size_t vertexCount)
+{
+    // Until an upload succeeds, the vertices are drawn from system memory
+    m_isUploaded = false;
+
+    if (!vertices || (vertexCount == 0) || !VertexBuffer::isAvailable())
+        return false;
+
+    std::size_t next = (m_current + 1) % 2;
+    VertexBuffer& buffer = m_buffers[next];
+
+    if (!buffer.getNativeHandle() && !buffer.create(vertexCount))
+        return false;
+
+    // Updating the whole buffer orphans its previous storage
+    // whenever it has to grow, so the driver never has to wait
+    if (!buffer.update(vertices, vertexCount, 0))
+        return false;
+
+    // Only switch to the new buffer once it holds the geometry
+    m_current = static_cast<unsigned int>(next);
+    m_isUploaded = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingVertexBuffer::draw(RenderTarget& target, const Vertex* vertices, std::size_t firstVertex,
+                                 std::size_t vertexCount, const RenderStates& states) const
+{
+    if (m_isUploaded)
+        target.draw(m_buffers[m_current], firstVertex, vertexCount, states);
+    else
+        target.draw(vertices + firstVertex, vertexCount, m_type, states);
+}
+
+} // namespace priv
+
+} // namespace sf
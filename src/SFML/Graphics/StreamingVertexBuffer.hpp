@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_STREAMINGVERTEXBUFFER_HPP
+#define SFML_STREAMINGVERTEXBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class RenderTarget;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pair of streaming vertex buffers used alternately,
+///        with a fallback to client-side vertex arrays
+///
+/// Each upload goes to the buffer that was not used for the
+/// previous geometry, which the GPU may still be reading from,
+/// so that uploading a new frame doesn't have to wait for the
+/// previous one to be rendered. If vertex buffers are not
+/// available or an upload fails, the vertices are drawn directly
+/// from system memory until the next successful upload.
+///
+////////////////////////////////////////////////////////////
+class StreamingVertexBuffer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// \param type Type of primitives stored in the buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit StreamingVertexBuffer(PrimitiveType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload new geometry
+    ///
+    /// \param vertices    Vertices to upload
+    /// \param vertexCount Number of vertices
+    ///
+    /// \return True if the vertices were uploaded, false if they must be drawn from system memory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool upload(const Vertex* vertices, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a range of the last uploaded geometry
+    ///
+    /// \a vertices must be the array passed to the last call to
+    /// upload; it is drawn directly if the upload failed.
+    ///
+    /// \param target      Render target to draw to
+    /// \param vertices    Vertices passed to the last upload
+    /// \param firstVertex Index of the first vertex to draw
+    /// \param vertexCount Number of vertices to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const Vertex* vertices, std::size_t firstVertex,
+              std::size_t vertexCount, const RenderStates& states) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    VertexBuffer  m_buffers[2]; //!< Streaming vertex buffers, used alternately
+    unsigned int  m_current;    //!< Index of the buffer holding the current geometry
+    bool          m_isUploaded; //!< Does the current buffer hold the last uploaded geometry?
+    PrimitiveType m_type;       //!< Type of primitives stored in the buffers
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_STREAMINGVERTEXBUFFER_HPP
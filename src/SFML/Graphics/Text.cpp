@@ -27,7 +27,9 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
 #include <cmath>
 
 
@@ -47,11 +49,24 @@ namespace
         vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
     }
 
-    // Add a glyph quad to the vertex array
-    void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness = 0)
+    // Get the character size of the glyphs used to display a text
+    unsigned int getGlyphSize(const sf::Font& font, unsigned int characterSize)
     {
-        float padding = 1.0;
+        return font.isDistanceFieldEnabled() ? font.getDistanceFieldSize() : characterSize;
+    }
 
+    // Get the vertex array holding the quads of a font texture, creating it if needed
+    sf::VertexArray& getVertices(std::vector<sf::VertexArray>& vertices, unsigned int textureIndex)
+    {
+        if (textureIndex >= vertices.size())
+            vertices.resize(textureIndex + 1, sf::VertexArray(sf::Triangles));
+
+        return vertices[textureIndex];
+    }
+
+    // Add a glyph quad to the vertex array
+    void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float padding, float outlineThickness = 0)
+    {
         float left   = glyph.bounds.left - padding;
         float top    = glyph.bounds.top - padding;
         float right  = glyph.bounds.left + glyph.bounds.width + padding;
@@ -76,20 +91,23 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Text::Text() :
-m_string             (),
-m_font               (NULL),
-m_characterSize      (30),
-m_letterSpacingFactor(1.f),
-m_lineSpacingFactor  (1.f),
-m_style              (Regular),
-m_fillColor          (255, 255, 255),
-m_outlineColor       (0, 0, 0),
-m_outlineThickness   (0),
-m_vertices           (Triangles),
-m_outlineVertices    (Triangles),
-m_bounds             (),
-m_geometryNeedUpdate (false),
-m_fontTextureId      (0)
+m_string                (),
+m_font                  (NULL),
+m_characterSize         (30),
+m_letterSpacingFactor   (1.f),
+m_lineSpacingFactor     (1.f),
+m_style                 (Regular),
+m_fillColor             (255, 255, 255),
+m_outlineColor          (0, 0, 0),
+m_outlineThickness      (0),
+m_vertices              (),
+m_outlineVertices       (),
+m_bounds                (),
+m_geometryNeedUpdate    (false),
+m_firstOutdatedCharacter(String::InvalidPos),
+m_lines                 (),
+m_characterPositions    (),
+m_fontGeneration        (0)
 {
 
 }
@@ -97,20 +115,23 @@ m_fontTextureId      (0)
 
 ////////////////////////////////////////////////////////////
 Text::Text(const String& string, const Font& font, unsigned int characterSize) :
-m_string             (string),
-m_font               (&font),
-m_characterSize      (characterSize),
-m_letterSpacingFactor(1.f),
-m_lineSpacingFactor  (1.f),
-m_style              (Regular),
-m_fillColor          (255, 255, 255),
-m_outlineColor       (0, 0, 0),
-m_outlineThickness   (0),
-m_vertices           (Triangles),
-m_outlineVertices    (Triangles),
-m_bounds             (),
-m_geometryNeedUpdate (true),
-m_fontTextureId      (0)
+m_string                (string),
+m_font                  (&font),
+m_characterSize         (characterSize),
+m_letterSpacingFactor   (1.f),
+m_lineSpacingFactor     (1.f),
+m_style                 (Regular),
+m_fillColor             (255, 255, 255),
+m_outlineColor          (0, 0, 0),
+m_outlineThickness      (0),
+m_vertices              (),
+m_outlineVertices       (),
+m_bounds                (),
+m_geometryNeedUpdate    (true),
+m_firstOutdatedCharacter(String::InvalidPos),
+m_lines                 (),
+m_characterPositions    (),
+m_fontGeneration        (0)
 {
 
 }
@@ -121,8 +142,14 @@ void Text::setString(const String& string)
 {
     if (m_string != string)
     {
+        // Only the characters after the common beginning of both strings need to be updated
+        std::size_t count = std::min(m_string.getSize(), string.getSize());
+        std::size_t firstChange = 0;
+        while ((firstChange < count) && (m_string[firstChange] == string[firstChange]))
+            ++firstChange;
+
         m_string = string;
-        m_geometryNeedUpdate = true;
+        m_firstOutdatedCharacter = std::min(m_firstOutdatedCharacter, firstChange);
     }
 }
 
@@ -200,8 +227,9 @@ void Text::setFillColor(const Color& color)
         // (if geometry is updated anyway, we can skip this step)
         if (!m_geometryNeedUpdate)
         {
-            for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
-                m_vertices[i].color = m_fillColor;
+            for (std::size_t i = 0; i < m_vertices.size(); ++i)
+                for (std::size_t j = 0; j < m_vertices[i].getVertexCount(); ++j)
+                    m_vertices[i][j].color = m_fillColor;
         }
     }
 }
@@ -218,8 +246,9 @@ void Text::setOutlineColor(const Color& color)
         // (if geometry is updated anyway, we can skip this step)
         if (!m_geometryNeedUpdate)
         {
-            for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
-                m_outlineVertices[i].color = m_outlineColor;
+            for (std::size_t i = 0; i < m_outlineVertices.size(); ++i)
+                for (std::size_t j = 0; j < m_outlineVertices[i].getVertexCount(); ++j)
+                    m_outlineVertices[i][j].color = m_outlineColor;
         }
     }
 }
@@ -317,40 +346,14 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (index > m_string.getSize())
         index = m_string.getSize();
 
-    // Precompute the variables needed by the algorithm
-    bool  isBold          = m_style & Bold;
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
-    float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
-    whitespaceWidth      += letterSpacing;
-    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
-
-    // Compute the position
-    Vector2f position;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < index; ++i)
-    {
-        Uint32 curChar = m_string[i];
-
-        // Apply the kerning offset
-        position.x += m_font->getKerning(prevChar, curChar, m_characterSize, isBold);
-        prevChar = curChar;
-
-        // Handle special characters
-        switch (curChar)
-        {
-            case ' ':  position.x += whitespaceWidth;             continue;
-            case '\t': position.x += whitespaceWidth * 4;         continue;
-            case '\n': position.y += lineSpacing; position.x = 0; continue;
-        }
+    // The positions of the characters are computed along with the geometry
+    ensureGeometryUpdate();
 
-        // For regular characters, add the advance offset of the glyph
-        position.x += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
-    }
+    // Distance field glyphs are laid out at their own size, then scaled
+    float scale = static_cast<float>(m_characterSize) / static_cast<float>(getGlyphSize(*m_font, m_characterSize));
 
     // Transform the position to global coordinates
-    position = getTransform().transformPoint(position);
-
-    return position;
+    return getTransform().transformPoint(m_characterPositions[index] * scale);
 }
 
 
@@ -378,13 +381,47 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         ensureGeometryUpdate();
 
         states.transform *= getTransform();
-        states.texture = &m_font->getTexture(m_characterSize);
+
+        // Distance field glyphs need a shader to be drawn, which also renders the style
+        unsigned int characterSize = getGlyphSize(*m_font, m_characterSize);
+        if (m_font->isDistanceFieldEnabled() && !states.shader)
+        {
+            Shader* shader = m_font->getDistanceFieldShader(target.getBackend() == RenderTarget::Programmable);
+            if (shader)
+            {
+                // Convert the thicknesses from pixels of the text to distances stored in the glyphs
+                float scale = static_cast<float>(m_characterSize) / static_cast<float>(characterSize);
+                float range = 2.f * m_font->getDistanceFieldSpread() * scale;
+                float boldness = (m_style & Bold) ? 0.5f / range : 0.f;
+
+                shader->setUniform("outlineColor", Glsl::Vec4(m_outlineColor));
+                shader->setUniform("outlineThickness", std::min(m_outlineThickness / range, 0.5f - boldness));
+                shader->setUniform("boldness", boldness);
+                states.shader = shader;
+            }
+        }
 
         // Only draw the outline if there is something to draw
         if (m_outlineThickness != 0)
-            target.draw(m_outlineVertices, states);
+        {
+            for (std::size_t i = 0; i < m_outlineVertices.size(); ++i)
+            {
+                if (m_outlineVertices[i].getVertexCount() == 0)
+                    continue;
 
-        target.draw(m_vertices, states);
+                states.texture = &m_font->getTexture(characterSize, static_cast<unsigned int>(i));
+                target.draw(m_outlineVertices[i], states);
+            }
+        }
+
+        for (std::size_t i = 0; i < m_vertices.size(); ++i)
+        {
+            if (m_vertices[i].getVertexCount() == 0)
+                continue;
+
+            states.texture = &m_font->getTexture(characterSize, static_cast<unsigned int>(i));
+            target.draw(m_vertices[i], states);
+        }
     }
 }
 
@@ -395,80 +432,149 @@ void Text::ensureGeometryUpdate() const
     if (!m_font)
         return;
 
-    // Do nothing, if geometry has not changed and the font texture has not changed
-    if (!m_geometryNeedUpdate && m_font->getTexture(m_characterSize).m_cacheId == m_fontTextureId)
+    // Distance field glyphs are laid out at their own size, then scaled
+    unsigned int characterSize = getGlyphSize(*m_font, m_characterSize);
+
+    // The glyphs may have moved if the font evicted some of them
+    Uint64 fontGeneration = m_font->getLayoutGeneration(characterSize);
+    if (fontGeneration != m_fontGeneration)
+        m_geometryNeedUpdate = true;
+
+    // Do nothing, if neither the geometry nor the string has changed
+    if (!m_geometryNeedUpdate && (m_firstOutdatedCharacter == String::InvalidPos))
         return;
 
-    // Save the current fonts texture id
-    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    // Find the line from which the geometry must be recomputed, the previous ones are kept
+    std::size_t lineIndex = 0;
+    if (m_geometryNeedUpdate || m_lines.empty())
+    {
+        Line firstLine;
+        firstLine.firstCharacter = 0;
+        firstLine.y = static_cast<float>(characterSize);
+        firstLine.minX = static_cast<float>(characterSize);
+        firstLine.minY = static_cast<float>(characterSize);
+        firstLine.maxX = 0.f;
+        firstLine.maxY = 0.f;
+
+        m_lines.assign(1, firstLine);
+    }
+    else
+    {
+        lineIndex = m_lines.size() - 1;
+        while ((lineIndex > 0) && (m_lines[lineIndex].firstCharacter > m_firstOutdatedCharacter))
+            --lineIndex;
+
+        m_lines.resize(lineIndex + 1);
+    }
 
     // Mark geometry as updated
     m_geometryNeedUpdate = false;
-
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_outlineVertices.clear();
+    m_firstOutdatedCharacter = String::InvalidPos;
+
+    // Remove the geometry of the lines to recompute
+    Line line = m_lines.back();
+    line.vertexCounts.resize(m_vertices.size(), 0);
+    line.outlineVertexCounts.resize(m_outlineVertices.size(), 0);
+    for (std::size_t i = 0; i < m_vertices.size(); ++i)
+        m_vertices[i].resize(line.vertexCounts[i]);
+    for (std::size_t i = 0; i < m_outlineVertices.size(); ++i)
+        m_outlineVertices[i].resize(line.outlineVertexCounts[i]);
+    m_characterPositions.resize(line.firstCharacter);
     m_bounds = FloatRect();
 
     // No text: nothing to draw
     if (m_string.isEmpty())
+    {
+        m_characterPositions.push_back(Vector2f());
+        m_fontGeneration = fontGeneration;
         return;
+    }
 
     // Compute values related to the text style
     bool  isBold             = m_style & Bold;
     bool  isUnderlined       = m_style & Underlined;
     bool  isStrikeThrough    = m_style & StrikeThrough;
     float italicShear        = (m_style & Italic) ? 0.209f : 0.f; // 12 degrees in radians
-    float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
-    float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
+    float underlineOffset    = m_font->getUnderlinePosition(characterSize);
+    float underlineThickness = m_font->getUnderlineThickness(characterSize);
+
+    // Distance field glyphs have the bold style and the outline applied by a shader,
+    // so the outline glyphs are not needed and the bold advance must be added
+    bool  isDistanceField    = m_font->isDistanceFieldEnabled();
+    float scale              = static_cast<float>(m_characterSize) / static_cast<float>(characterSize);
+    float outlineThickness   = m_outlineThickness / scale;
+    float boldAdvance        = (isBold && isDistanceField) ? 1.f / scale : 0.f;
+    float glyphPadding       = isDistanceField ? m_font->getDistanceFieldSpread() : 1.f;
 
     // Compute the location of the strike through dynamically
     // We use the center point of the lowercase 'x' glyph as the reference
     // We reuse the underline thickness as the thickness of the strike through as well
-    FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, isBold).bounds;
+    FloatRect xBounds = m_font->getGlyph(L'x', characterSize, isBold).bounds;
     float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
 
     // Precompute the variables needed by the algorithm
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+    float whitespaceWidth = m_font->getGlyph(L' ', characterSize, isBold).advance + boldAdvance;
     float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
     whitespaceWidth      += letterSpacing;
-    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
+    float lineSpacing     = m_font->getLineSpacing(characterSize) * m_lineSpacingFactor;
     float x               = 0.f;
-    float y               = static_cast<float>(m_characterSize);
-
-    // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    float y               = line.y;
+
+    // Create one quad for each character, starting from the first line to recompute
+    float minX = line.minX;
+    float minY = line.minY;
+    float maxX = line.maxX;
+    float maxY = line.maxY;
+    Uint32 prevChar = (line.firstCharacter > 0) ? L'\n' : 0;
+    for (std::size_t i = line.firstCharacter; i < m_string.getSize(); ++i)
     {
         Uint32 curChar = m_string[i];
 
+        // Save the state at the beginning of each line, so that the next updates can start from there
+        if ((i > line.firstCharacter) && (m_string[i - 1] == L'\n'))
+        {
+            Line newLine;
+            newLine.firstCharacter = i;
+            newLine.y = y;
+            newLine.minX = minX;
+            newLine.minY = minY;
+            newLine.maxX = maxX;
+            newLine.maxY = maxY;
+
+            for (std::size_t j = 0; j < m_vertices.size(); ++j)
+                newLine.vertexCounts.push_back(m_vertices[j].getVertexCount());
+            for (std::size_t j = 0; j < m_outlineVertices.size(); ++j)
+                newLine.outlineVertexCounts.push_back(m_outlineVertices[j].getVertexCount());
+
+            m_lines.push_back(newLine);
+        }
+
+        // Save the position of the character, relative to the top of the text
+        m_characterPositions.push_back(Vector2f(x, y - static_cast<float>(characterSize)));
+
         // Skip the \r char to avoid weird graphical issues
         if (curChar == '\r')
             continue;
 
         // Apply the kerning offset
-        x += m_font->getKerning(prevChar, curChar, m_characterSize, isBold);
+        x += m_font->getKerning(prevChar, curChar, characterSize, isBold);
 
         // If we're using the underlined style and there's a new line, draw a line
         if (isUnderlined && (curChar == L'\n' && prevChar != L'\n'))
         {
-            addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+            addLine(getVertices(m_vertices, 0), x, y, m_fillColor, underlineOffset, underlineThickness);
 
             if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+                addLine(getVertices(m_outlineVertices, 0), x, y, m_outlineColor, underlineOffset, underlineThickness, outlineThickness);
         }
 
         // If we're using the strike through style and there's a new line, draw a line across all characters
         if (isStrikeThrough && (curChar == L'\n' && prevChar != L'\n'))
         {
-            addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+            addLine(getVertices(m_vertices, 0), x, y, m_fillColor, strikeThroughOffset, underlineThickness);
 
             if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+                addLine(getVertices(m_outlineVertices, 0), x, y, m_outlineColor, strikeThroughOffset, underlineThickness, outlineThickness);
         }
 
         prevChar = curChar;
@@ -496,9 +602,9 @@ void Text::ensureGeometryUpdate() const
         }
 
         // Apply the outline
-        if (m_outlineThickness != 0)
+        if ((m_outlineThickness != 0) && !isDistanceField)
         {
-            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold, m_outlineThickness);
+            const Glyph& glyph = m_font->getGlyph(curChar, characterSize, isBold, m_outlineThickness);
 
             float left   = glyph.bounds.left;
             float top    = glyph.bounds.top;
@@ -506,7 +612,7 @@ void Text::ensureGeometryUpdate() const
             float bottom = glyph.bounds.top  + glyph.bounds.height;
 
             // Add the outline glyph to the vertices
-            addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear, m_outlineThickness);
+            addGlyphQuad(getVertices(m_outlineVertices, glyph.textureIndex), Vector2f(x, y), m_outlineColor, glyph, italicShear, glyphPadding, m_outlineThickness);
 
             // Update the current bounds with the outlined glyph bounds
             minX = std::min(minX, x + left   - italicShear * bottom - m_outlineThickness);
@@ -516,52 +622,83 @@ void Text::ensureGeometryUpdate() const
         }
 
         // Extract the current glyph's description
-        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold);
+        const Glyph& glyph = m_font->getGlyph(curChar, characterSize, isBold);
 
         // Add the glyph to the vertices
-        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italicShear);
+        addGlyphQuad(getVertices(m_vertices, glyph.textureIndex), Vector2f(x, y), m_fillColor, glyph, italicShear, glyphPadding);
 
-        // Update the current bounds with the non outlined glyph bounds
-        if (m_outlineThickness == 0)
+        // Update the current bounds with the non outlined glyph bounds (the outline is drawn around them for distance field glyphs)
+        if ((m_outlineThickness == 0) || isDistanceField)
         {
             float left   = glyph.bounds.left;
             float top    = glyph.bounds.top;
             float right  = glyph.bounds.left + glyph.bounds.width;
             float bottom = glyph.bounds.top  + glyph.bounds.height;
 
-            minX = std::min(minX, x + left  - italicShear * bottom);
-            maxX = std::max(maxX, x + right - italicShear * top);
-            minY = std::min(minY, y + top);
-            maxY = std::max(maxY, y + bottom);
+            minX = std::min(minX, x + left  - italicShear * bottom - outlineThickness);
+            maxX = std::max(maxX, x + right - italicShear * top    + outlineThickness);
+            minY = std::min(minY, y + top    - outlineThickness);
+            maxY = std::max(maxY, y + bottom + outlineThickness);
         }
 
         // Advance to the next character
-        x += glyph.advance + letterSpacing;
+        x += glyph.advance + boldAdvance + letterSpacing;
     }
 
     // If we're using the underlined style, add the last line
     if (isUnderlined && (x > 0))
     {
-        addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+        addLine(getVertices(m_vertices, 0), x, y, m_fillColor, underlineOffset, underlineThickness);
 
         if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+            addLine(getVertices(m_outlineVertices, 0), x, y, m_outlineColor, underlineOffset, underlineThickness, outlineThickness);
     }
 
     // If we're using the strike through style, add the last line across all characters
     if (isStrikeThrough && (x > 0))
     {
-        addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+        addLine(getVertices(m_vertices, 0), x, y, m_fillColor, strikeThroughOffset, underlineThickness);
 
         if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+            addLine(getVertices(m_outlineVertices, 0), x, y, m_outlineColor, strikeThroughOffset, underlineThickness, outlineThickness);
     }
 
+    // Save the position of the end of the string
+    m_characterPositions.push_back(Vector2f(x, y - static_cast<float>(characterSize)));
+
     // Update the bounding rectangle
     m_bounds.left = minX;
     m_bounds.top = minY;
     m_bounds.width = maxX - minX;
     m_bounds.height = maxY - minY;
+
+    // Scale the new distance field glyphs to the character size
+    if (scale != 1.f)
+    {
+        for (std::size_t i = 0; i < m_vertices.size(); ++i)
+        {
+            std::size_t first = (i < line.vertexCounts.size()) ? line.vertexCounts[i] : 0;
+            for (std::size_t j = first; j < m_vertices[i].getVertexCount(); ++j)
+                m_vertices[i][j].position *= scale;
+        }
+
+        for (std::size_t i = 0; i < m_outlineVertices.size(); ++i)
+        {
+            std::size_t first = (i < line.outlineVertexCounts.size()) ? line.outlineVertexCounts[i] : 0;
+            for (std::size_t j = first; j < m_outlineVertices[i].getVertexCount(); ++j)
+                m_outlineVertices[i][j].position *= scale;
+        }
+
+        m_bounds.left *= scale;
+        m_bounds.top *= scale;
+        m_bounds.width *= scale;
+        m_bounds.height *= scale;
+    }
+
+    // Save the layout generation of the font from before the glyphs were loaded:
+    // if loading them evicted glyphs that the kept lines still use, the next
+    // update sees a newer generation and lays the whole text out again
+    m_fontGeneration = fontGeneration;
 }
 
 } // namespace sf
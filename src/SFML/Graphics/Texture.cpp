@@ -27,15 +27,20 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <cassert>
 #include <cstring>
+#include <vector>
 
 
 namespace
@@ -53,11 +58,99 @@ namespace
 
         return id++;
     }
+
+    // Get the OpenGL internal format matching a block compression format,
+    // or 0 if the graphics driver can't sample it
+    GLenum getCompressedFormat(sf::priv::CompressedImage::Format format, bool sRgb)
+    {
+        static const bool s3tc = GLEXT_texture_compression_s3tc;
+        static const bool etc2 = GLEXT_texture_compression_etc2;
+
+        switch (format)
+        {
+            case sf::priv::CompressedImage::Bc1Rgb:   return s3tc ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB_S3TC_DXT1       : GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1)  : 0;
+            case sf::priv::CompressedImage::Bc1Rgba:  return s3tc ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1) : 0;
+            case sf::priv::CompressedImage::Bc2:      return s3tc ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3) : 0;
+            case sf::priv::CompressedImage::Bc3:      return s3tc ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5) : 0;
+            case sf::priv::CompressedImage::Etc2Rgb:  return etc2 ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ETC2            : GLEXT_GL_COMPRESSED_RGB8_ETC2)      : 0;
+            case sf::priv::CompressedImage::Etc2Rgba: return etc2 ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC : GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC) : 0;
+        }
+
+        return 0;
+    }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+/// \brief Ring of pixel buffers used to stream pixels to a texture
+///
+////////////////////////////////////////////////////////////
+struct Texture::PixelStream
+{
+    enum
+    {
+        BufferCount = 3 //!< Number of buffers in the ring
+    };
+
+    PixelStream();
+    ~PixelStream();
+
+    GLuint             buffers[BufferCount];    //!< Pixel unpack buffers
+    std::size_t        capacities[BufferCount]; //!< Size allocated for each buffer, in bytes
+    GLEXT_GLsync       fences[BufferCount];     //!< Fences signaled once the graphics card is done reading each buffer
+    unsigned int       current;                 //!< Index of the next buffer to use
+    std::vector<Uint8> staging;                 //!< Client memory used when pixel buffers are not available
+    Uint8*             pixels;                  //!< Pointer returned by lockPixels, null if the pixels are not locked
+    bool               mapped;                  //!< Do the locked pixels belong to a mapped pixel buffer?
+    unsigned int       x;                       //!< Left of the locked region
+    unsigned int       y;                       //!< Top of the locked region
+    unsigned int       width;                   //!< Width of the locked region
+    unsigned int       height;                  //!< Height of the locked region
+};
+
+
+////////////////////////////////////////////////////////////
+Texture::PixelStream::PixelStream() :
+current(0),
+staging(),
+pixels (NULL),
+mapped (false),
+x      (0),
+y      (0),
+width  (0),
+height (0)
+{
+    for (unsigned int i = 0; i < BufferCount; ++i)
+    {
+        buffers[i] = 0;
+        capacities[i] = 0;
+        fences[i] = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Texture::PixelStream::~PixelStream()
+{
+    // Nothing to release if pixel buffers were never used
+    if (!buffers[0])
+        return;
+
+    TransientContextLock lock;
+
+    for (unsigned int i = 0; i < BufferCount; ++i)
+    {
+        if (fences[i])
+            glCheck(GLEXT_glDeleteSync(fences[i]));
+
+        if (buffers[i])
+            glCheck(GLEXT_glDeleteBuffers(1, &buffers[i]));
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Texture::Texture() :
 m_size         (0, 0),
@@ -69,7 +162,10 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_pixelStream  (NULL),
+m_layerCount   (0),
+m_isCompressed (false)
 {
 }
 
@@ -85,7 +181,10 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_pixelStream  (NULL),
+m_layerCount   (0),
+m_isCompressed (false)
 {
     if (copy.m_texture)
     {
@@ -98,12 +197,20 @@ m_cacheId      (getUniqueId())
             err() << "Failed to copy texture, failed to create new texture" << std::endl;
         }
     }
+
+    setStreaming(copy.isStreaming());
 }
 
 
 ////////////////////////////////////////////////////////////
 Texture::~Texture()
 {
+    // Render the pending primitives that still use this texture
+    RenderTarget::flushBatches(*this);
+
+    // Destroy the pixel buffers
+    delete m_pixelStream;
+
     // Destroy the OpenGL texture
     if (m_texture)
     {
@@ -144,12 +251,16 @@ bool Texture::create(unsigned int width, unsigned int height)
         return false;
     }
 
+    // Render the pending primitives that use the previous contents
+    RenderTarget::flushBatches(*this);
+
     // All the validity checks passed, we can store the new texture settings
     m_size.x        = width;
     m_size.y        = height;
     m_actualSize    = actualSize;
     m_pixelsFlipped = false;
     m_fboAttachment = false;
+    m_isCompressed  = false;
 
     // Create the OpenGL texture if it doesn't exist yet
     if (!m_texture)
@@ -217,6 +328,14 @@ bool Texture::create(unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 {
+    // Block-compressed files don't need to be decoded to RGBA pixels
+    FileInputStream stream;
+    if (stream.open(filename) && priv::CompressedImage::isCompressed(stream))
+    {
+        priv::CompressedImage compressed;
+        return compressed.loadFromStream(stream, err()) && loadFromCompressedImage(compressed, area);
+    }
+
     Image image;
     return image.loadFromFile(filename) && loadFromImage(image, area);
 }
@@ -225,6 +344,16 @@ bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect& area)
 {
+    // Block-compressed files don't need to be decoded to RGBA pixels
+    if (priv::CompressedImage::isCompressed(data, size))
+    {
+        MemoryInputStream stream;
+        stream.open(data, size);
+
+        priv::CompressedImage compressed;
+        return compressed.loadFromStream(stream, err()) && loadFromCompressedImage(compressed, area);
+    }
+
     Image image;
     return image.loadFromMemory(data, size) && loadFromImage(image, area);
 }
@@ -233,6 +362,14 @@ bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect&
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 {
+    // Block-compressed files don't need to be decoded to RGBA pixels
+    stream.seek(0);
+    if (priv::CompressedImage::isCompressed(stream))
+    {
+        priv::CompressedImage compressed;
+        return compressed.loadFromStream(stream, err()) && loadFromCompressedImage(compressed, area);
+    }
+
     Image image;
     return image.loadFromStream(stream) && loadFromImage(image, area);
 }
@@ -322,6 +459,24 @@ Image Texture::copyToImage() const
 
     TransientContextLock lock;
 
+#ifndef SFML_OPENGL_ES
+
+    if (m_layerCount)
+    {
+        // Texture arrays are copied as a vertical strip of layers, the way they are addressed
+        priv::TextureSaver save(GLEXT_GL_TEXTURE_2D_ARRAY);
+
+        std::vector<Uint8> pixels(m_size.x * m_size.y * m_layerCount * 4);
+        glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+        glCheck(glGetTexImage(GLEXT_GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+
+        Image image;
+        image.create(m_size.x, m_size.y * m_layerCount, pixels);
+        return image;
+    }
+
+#endif // SFML_OPENGL_ES
+
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
@@ -349,15 +504,15 @@ Image Texture::copyToImage() const
 
 #else
 
-    if ((m_size == m_actualSize) && !m_pixelsFlipped)
+    if (m_size == m_actualSize)
     {
-        // Texture is not padded nor flipped, we can use a direct copy
+        // Texture is not padded, we can use a direct copy (flipped pixels are fixed in place afterwards)
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
         glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
     }
     else
     {
-        // Texture is either padded or flipped, we have to use a slower algorithm
+        // Texture is padded, we have to use a slower algorithm
 
         // All the pixels will first be copied to a temporary array
         std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * 4);
@@ -387,9 +542,16 @@ Image Texture::copyToImage() const
 
 #endif // SFML_OPENGL_ES
 
-    // Create the image
+    // Create the image, moving the pixels into it
     Image image;
-    image.create(m_size.x, m_size.y, &pixels[0]);
+    image.create(m_size.x, m_size.y, pixels);
+
+#ifndef SFML_OPENGL_ES
+
+    if (m_pixelsFlipped && (m_size == m_actualSize))
+        image.flipVertically();
+
+#endif // SFML_OPENGL_ES
 
     return image;
 }
@@ -409,7 +571,23 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
     assert(x + width <= m_size.x);
     assert(y + height <= m_size.y);
 
-    if (pixels && m_texture)
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, its pixels are compressed" << std::endl;
+        return;
+    }
+
+    if (pixels && m_texture && m_pixelStream)
+    {
+        // Stream the pixels through a pixel buffer, without waiting for the driver
+        Uint8* destination = lockPixels(width, height, x, y);
+        if (destination)
+        {
+            std::memcpy(destination, pixels, static_cast<std::size_t>(width) * height * 4);
+            unlockPixels();
+        }
+    }
+    else if (pixels && m_texture)
     {
         TransientContextLock lock;
 
@@ -448,6 +626,18 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
     if (!m_texture || !texture.m_texture)
         return;
 
+    if (texture.m_layerCount)
+    {
+        err() << "Failed to update texture, the source is a texture array" << std::endl;
+        return;
+    }
+
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, its pixels are compressed" << std::endl;
+        return;
+    }
+
 #ifndef SFML_OPENGL_ES
 
     {
@@ -457,7 +647,8 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         priv::ensureExtensionsInit();
     }
 
-    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit)
+    // Compressed textures can't be attached to a frame buffer, they are copied through their decoded pixels
+    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit && !texture.m_isCompressed)
     {
         TransientContextLock lock;
 
@@ -568,6 +759,12 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
     assert(x + window.getSize().x <= m_size.x);
     assert(y + window.getSize().y <= m_size.y);
 
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, its pixels are compressed" << std::endl;
+        return;
+    }
+
     if (m_texture && window.setActive(true))
     {
         TransientContextLock lock;
@@ -590,6 +787,173 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::setStreaming(bool streaming)
+{
+    if (streaming && !m_pixelStream)
+    {
+        m_pixelStream = new PixelStream;
+    }
+    else if (!streaming && m_pixelStream)
+    {
+        // Transfer the pending pixels before releasing the buffers
+        unlockPixels();
+
+        delete m_pixelStream;
+        m_pixelStream = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isStreaming() const
+{
+    return m_pixelStream != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* Texture::lockPixels(unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+
+    if (!m_texture || !width || !height)
+        return NULL;
+
+    if (m_isCompressed)
+    {
+        err() << "Failed to lock texture pixels, its pixels are compressed" << std::endl;
+        return NULL;
+    }
+
+    setStreaming(true);
+    PixelStream& stream = *m_pixelStream;
+
+    if (stream.pixels)
+    {
+        err() << "Failed to lock the pixels of a texture, they are already locked" << std::endl;
+        return NULL;
+    }
+
+    stream.x      = x;
+    stream.y      = y;
+    stream.width  = width;
+    stream.height = height;
+
+    std::size_t size = static_cast<std::size_t>(width) * height * 4;
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (GLEXT_pixel_buffer_object && GLEXT_map_buffer_range && GLEXT_sync)
+    {
+        GLuint&       buffer = stream.buffers[stream.current];
+        GLEXT_GLsync& fence  = stream.fences[stream.current];
+
+        // Wait until the graphics card is done reading the previous contents of the buffer;
+        // with enough buffers in the ring, this has already happened most of the time
+        if (fence)
+        {
+            glCheck(GLEXT_glClientWaitSync(fence, GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, static_cast<GLuint64>(-1)));
+            glCheck(GLEXT_glDeleteSync(fence));
+            fence = NULL;
+        }
+
+        if (!buffer)
+            glCheck(GLEXT_glGenBuffers(1, &buffer));
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer));
+
+        // Grow the buffer if the region doesn't fit
+        if (stream.capacities[stream.current] < size)
+        {
+            glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), NULL, GLEXT_GL_STREAM_DRAW));
+            stream.capacities[stream.current] = size;
+        }
+
+        // The fence guarantees that the buffer is not in use, no need for the driver to synchronize
+        void* pixels = NULL;
+        GLbitfield access = GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT | GLEXT_GL_MAP_UNSYNCHRONIZED_BIT;
+        glCheck(pixels = GLEXT_glMapBufferRange(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size), access));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+        if (pixels)
+        {
+            stream.pixels = static_cast<Uint8*>(pixels);
+            stream.mapped = true;
+
+            return stream.pixels;
+        }
+    }
+
+    // Pixel buffers are not available, use client memory
+    stream.staging.resize(size);
+    stream.pixels = &stream.staging[0];
+    stream.mapped = false;
+
+    return stream.pixels;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::unlockPixels()
+{
+    if (!m_pixelStream || !m_pixelStream->pixels)
+        return;
+
+    PixelStream& stream = *m_pixelStream;
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+
+    if (stream.mapped)
+    {
+        // Copy the pixels from the pixel buffer to the texture, the driver does it asynchronously
+        GLboolean unmapped = GL_FALSE;
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, stream.buffers[stream.current]));
+        glCheck(unmapped = GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+
+        if (unmapped)
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, stream.x, stream.y, stream.width, stream.height, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        else
+            err() << "Failed to update texture, the contents of its pixel buffer were lost" << std::endl;
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+        // Insert a fence to know when the buffer can be written again, and move on to the next one
+        glCheck(stream.fences[stream.current] = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        stream.current = (stream.current + 1) % PixelStream::BufferCount;
+    }
+    else
+    {
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, stream.x, stream.y, stream.width, stream.height, GL_RGBA, GL_UNSIGNED_BYTE, stream.pixels));
+    }
+
+    stream.pixels = NULL;
+
+    // The texture object is the same, so the render target's cache only
+    // needs to be invalidated if the texture matrix changes
+    if (m_hasMipmap)
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        m_hasMipmap = false;
+    }
+
+    if (m_pixelsFlipped)
+    {
+        m_pixelsFlipped = false;
+        m_cacheId = getUniqueId();
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::setSmooth(bool smooth)
 {
@@ -739,7 +1103,17 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
     if (texture && texture->m_texture)
     {
         // Bind the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+        if (texture->m_layerCount)
+        {
+            // Texture arrays can only be sampled by shaders, make sure
+            // that the fixed pipeline doesn't sample a previous texture
+            glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, texture->m_texture));
+        }
+        else
+        {
+            glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+        }
 
         // Check if we need to define a special texture matrix
         if ((coordinateType == Pixels) || texture->m_pixelsFlipped)
@@ -822,6 +1196,10 @@ Texture& Texture::operator =(const Texture& right)
 ////////////////////////////////////////////////////////////
 void Texture::swap(Texture& right)
 {
+    // Pending primitives must be rendered with the contents they were drawn with
+    RenderTarget::flushBatches(*this);
+    RenderTarget::flushBatches(right);
+
     std::swap(m_size,          right.m_size);
     std::swap(m_actualSize,    right.m_actualSize);
     std::swap(m_texture,       right.m_texture);
@@ -831,6 +1209,9 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_pixelStream,   right.m_pixelStream);
+    std::swap(m_layerCount,    right.m_layerCount);
+    std::swap(m_isCompressed,  right.m_isCompressed);
 
     m_cacheId = getUniqueId();
     right.m_cacheId = getUniqueId();
@@ -844,6 +1225,56 @@ unsigned int Texture::getNativeHandle() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedImage(const priv::CompressedImage& image, const IntRect& area)
+{
+    const int width  = static_cast<int>(image.getSize().x);
+    const int height = static_cast<int>(image.getSize().y);
+
+    // Only whole blocks can be uploaded, so sub-areas are loaded from the decoded pixels
+    GLenum format = 0;
+    if (area.width == 0 || (area.height == 0) ||
+       ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
+    {
+        TransientContextLock lock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        // Compressed blocks can't be padded to a power of two size either
+        if ((getValidSize(image.getSize().x) == image.getSize().x) && (getValidSize(image.getSize().y) == image.getSize().y))
+            format = getCompressedFormat(image.getFormat(), m_sRgb && GLEXT_texture_sRGB);
+    }
+
+    if (!format)
+    {
+        // The graphics driver can't sample these blocks, decode them on the CPU
+        Image decoded;
+        image.decompress(decoded);
+        return loadFromImage(decoded, area);
+    }
+
+    if (!create(image.getSize().x, image.getSize().y))
+        return false;
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // Replace the storage allocated by create with the compressed blocks
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(GLEXT_glCompressedTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, static_cast<GLsizei>(image.getDataSize()), image.getData()));
+    m_isCompressed = true;
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getValidSize(unsigned int size)
 {
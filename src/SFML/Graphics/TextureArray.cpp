@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cassert>
+
+
+namespace
+{
+    sf::Mutex maximumLayerCountMutex;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureArray::TextureArray() :
+m_texture()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::create(unsigned int width, unsigned int height, unsigned int layerCount)
+{
+    // Check if texture parameters are valid before creating it
+    if ((width == 0) || (height == 0) || (layerCount == 0))
+    {
+        err() << "Failed to create texture array, invalid size (" << width << "x" << height << "x" << layerCount << ")" << std::endl;
+        return false;
+    }
+
+    if (!isAvailable())
+    {
+        err() << "Failed to create texture array, OpenGL extension EXT_texture_array unavailable" << std::endl;
+        return false;
+    }
+
+    // Check the maximum texture size and number of layers
+    unsigned int maxSize = Texture::getMaximumSize();
+    unsigned int maxLayerCount = getMaximumLayerCount();
+    if ((width > maxSize) || (height > maxSize) || (layerCount > maxLayerCount))
+    {
+        err() << "Failed to create texture array, its size is too high "
+              << "(" << width << "x" << height << "x" << layerCount << ", "
+              << "maximum is " << maxSize << "x" << maxSize << "x" << maxLayerCount << ")"
+              << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // The array is built in a new texture, which is swapped with the current one
+    // once ready so that the texture rendering cache sees a new texture
+    Texture texture;
+    texture.m_size       = Vector2u(width, height);
+    texture.m_actualSize = texture.m_size;
+    texture.m_isSmooth   = m_texture.m_isSmooth;
+    texture.m_sRgb       = m_texture.m_sRgb && GLEXT_texture_sRGB;
+    texture.m_layerCount = layerCount;
+
+    GLuint name;
+    glCheck(glGenTextures(1, &name));
+    texture.m_texture = static_cast<unsigned int>(name);
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save(GLEXT_GL_TEXTURE_2D_ARRAY);
+
+    // Initialize the texture
+    glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, texture.m_texture));
+    glCheck(GLEXT_glTexImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, (texture.m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA), width, height, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GLEXT_GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GLEXT_GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, texture.m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, texture.m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    m_texture.swap(texture);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(unsigned int layer, const Image& image)
+{
+    update(layer, image.getPixelsPtr(), image.getSize().x, image.getSize().y, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(unsigned int layer, const Image& image, unsigned int x, unsigned int y)
+{
+    update(layer, image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(unsigned int layer, const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    assert(layer < m_texture.m_layerCount);
+    assert(x + width <= m_texture.m_size.x);
+    assert(y + height <= m_texture.m_size.y);
+
+    if (pixels && m_texture.m_texture)
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save(GLEXT_GL_TEXTURE_2D_ARRAY);
+
+        // Copy pixels from the given array to the layer
+        glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture.m_texture));
+        glCheck(GLEXT_glTexSubImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, x, y, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+
+        // Force an OpenGL flush, so that the texture array will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureArray::getSize() const
+{
+    return m_texture.m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getLayerCount() const
+{
+    return m_texture.m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TextureArray::getTextureRect(unsigned int layer, const IntRect& rectangle) const
+{
+    IntRect rect = rectangle;
+    if ((rect.width == 0) || (rect.height == 0))
+        rect = IntRect(0, 0, m_texture.m_size.x, m_texture.m_size.y);
+
+    rect.top += static_cast<int>(layer * m_texture.m_size.y);
+
+    return rect;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setSmooth(bool smooth)
+{
+    if (smooth != m_texture.m_isSmooth)
+    {
+        m_texture.m_isSmooth = smooth;
+
+        if (m_texture.m_texture)
+        {
+            TransientContextLock lock;
+
+            // Make sure that the current texture binding will be preserved
+            priv::TextureSaver save(GLEXT_GL_TEXTURE_2D_ARRAY);
+
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture.m_texture));
+            glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, smooth ? GL_LINEAR : GL_NEAREST));
+            glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, smooth ? GL_LINEAR : GL_NEAREST));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isSmooth() const
+{
+    return m_texture.m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setSrgb(bool sRgb)
+{
+    m_texture.m_sRgb = sRgb;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isSrgb() const
+{
+    return m_texture.m_sRgb;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureArray::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isAvailable()
+{
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    return GLEXT_texture_array != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getMaximumLayerCount()
+{
+    Lock lock(maximumLayerCountMutex);
+
+    static bool checked = false;
+    static GLint count = 0;
+
+    if (!checked)
+    {
+        checked = true;
+
+        if (isAvailable())
+        {
+            TransientContextLock lock;
+
+            glCheck(glGetIntegerv(GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS, &count));
+        }
+    }
+
+    return static_cast<unsigned int>(count);
+}
+
+} // namespace sf
@@ -0,0 +1,398 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/ShelfPacker.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+
+namespace
+{
+    // Size of the first texture of an atlas
+    const unsigned int initialTextureSize = 256;
+
+    // Transparent pixels left on the right and bottom of every image
+    const unsigned int padding = 1;
+
+    // (Re)create a texture filled with transparent pixels
+    bool createTransparentTexture(sf::Texture& texture, unsigned int size, bool smooth)
+    {
+        sf::Image image;
+        image.create(size, size, sf::Color::Transparent);
+
+        if (!texture.loadFromImage(image))
+            return false;
+
+        texture.setSmooth(smooth);
+        return true;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const std::size_t TextureAtlas::InvalidIndex = static_cast<std::size_t>(-1);
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas(unsigned int maximumTextureSize) :
+m_pages      (),
+m_entries    (),
+m_freeEntries(),
+m_maximumSize(maximumTextureSize),
+m_isSmooth   (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::add(const Image& image)
+{
+    Entry entry;
+    if (!insert(image, entry))
+        return InvalidIndex;
+
+    // Reuse the index of a removed image if there is one
+    if (!m_freeEntries.empty())
+    {
+        std::size_t index = m_freeEntries.back();
+        m_freeEntries.pop_back();
+        m_entries[index] = entry;
+        return index;
+    }
+
+    m_entries.push_back(entry);
+    return m_entries.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::addFromFile(const std::string& filename)
+{
+    Image image;
+    if (!image.loadFromFile(filename))
+        return InvalidIndex;
+
+    return add(image);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::remove(std::size_t index)
+{
+    if ((index < m_entries.size()) && (m_entries[index].page != InvalidIndex))
+    {
+        m_entries[index] = Entry();
+        m_freeEntries.push_back(index);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::repack()
+{
+    // Copy the pixels of all the textures back from the graphics card
+    std::vector<Image> images(m_pages.size());
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+        images[i] = m_pages[i].texture.copyToImage();
+
+    // Insert the tallest images first, rows of similar heights waste less space
+    std::vector<std::pair<int, std::size_t> > order;
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_entries[i].page != InvalidIndex)
+            order.push_back(std::make_pair(-m_entries[i].rect.height, i));
+    }
+    std::sort(order.begin(), order.end());
+
+    // Start again with empty textures, keeping the texture instances
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+    {
+        Page& page = m_pages[i];
+        page.rows.clear();
+        page.openRows.clear();
+        page.nextRow = 0;
+        createTransparentTexture(page.texture, page.texture.getSize().x, m_isSmooth);
+    }
+
+    bool success = true;
+    const std::vector<Entry> previous = m_entries;
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        const std::size_t index = order[i].second;
+        const Entry& entry = previous[index];
+
+        Image image;
+        image.create(entry.rect.width, entry.rect.height);
+        image.copy(images[entry.page], 0, 0, entry.rect);
+
+        if (!insert(image, m_entries[index]))
+        {
+            // Should not happen since all the images fitted before, but don't keep a dangling location
+            m_entries[index] = Entry();
+            m_freeEntries.push_back(index);
+            success = false;
+        }
+    }
+
+    // Release the textures that are not used anymore, wherever they are,
+    // and renumber the textures of the images accordingly
+    std::vector<std::size_t> newIndices(m_pages.size(), InvalidIndex);
+    std::size_t pageCount = 0;
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+    {
+        if (!m_pages[i].rows.empty())
+            newIndices[i] = pageCount++;
+    }
+
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+    {
+        // Swap instead of assigning, copying a texture would copy its pixels
+        if ((newIndices[i] != InvalidIndex) && (newIndices[i] != i))
+        {
+            Page& target = m_pages[newIndices[i]];
+            target.texture.swap(m_pages[i].texture);
+            target.rows.swap(m_pages[i].rows);
+            target.openRows.swap(m_pages[i].openRows);
+            std::swap(target.nextRow, m_pages[i].nextRow);
+        }
+    }
+    m_pages.resize(pageCount);
+
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->page != InvalidIndex)
+            it->page = newIndices[it->page];
+    }
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::clear()
+{
+    m_pages.clear();
+    m_entries.clear();
+    m_freeEntries.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getTextureCount() const
+{
+    return m_pages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getTexture(std::size_t textureIndex) const
+{
+    assert(textureIndex < m_pages.size());
+
+    return m_pages[textureIndex].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getTextureIndex(std::size_t index) const
+{
+    assert(index < m_entries.size());
+
+    return m_entries[index].page;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TextureAtlas::getTextureRect(std::size_t index) const
+{
+    assert(index < m_entries.size());
+
+    return m_entries[index].rect;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    if (smooth != m_isSmooth)
+    {
+        m_isSmooth = smooth;
+
+        for (std::deque<Page>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+            it->texture.setSmooth(smooth);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::insert(const Image& image, Entry& entry)
+{
+    const unsigned int width       = image.getSize().x + padding;
+    const unsigned int height      = image.getSize().y + padding;
+    const unsigned int maximumSize = std::min(m_maximumSize, Texture::getMaximumSize());
+
+    if ((image.getSize().x == 0) || (image.getSize().y == 0))
+    {
+        err() << "Failed to add image to texture atlas, the image is empty" << std::endl;
+        return false;
+    }
+
+    if ((width > maximumSize) || (height > maximumSize))
+    {
+        err() << "Failed to add image to texture atlas, its size is too high "
+              << "(" << image.getSize().x << "x" << image.getSize().y << ", "
+              << "maximum is " << maximumSize - padding << "x" << maximumSize - padding << ")"
+              << std::endl;
+        return false;
+    }
+
+    Page* page = NULL;
+    std::size_t pageIndex = 0;
+    std::size_t rowIndex = priv::ShelfPacker::NoRow;
+
+    // Find the row that fits well the image, in all the textures
+    for (std::size_t i = 0; (i < m_pages.size()) && !page; ++i)
+    {
+        rowIndex = priv::ShelfPacker::findRow(m_pages[i], width, height);
+        if (rowIndex != priv::ShelfPacker::NoRow)
+        {
+            page = &m_pages[i];
+            pageIndex = i;
+        }
+    }
+
+    // If we didn't find a matching row, create a new one
+    if (!page)
+    {
+        unsigned int rowHeight = std::min(priv::ShelfPacker::getRowHeight(height), maximumSize);
+
+        // Try the existing textures first, then a new one
+        for (std::size_t i = 0; (i < m_pages.size()) && !page; ++i)
+        {
+            if (createRow(m_pages[i], width, rowHeight))
+            {
+                page = &m_pages[i];
+                pageIndex = i;
+            }
+        }
+
+        if (!page)
+        {
+            // Start small and let the texture grow as images are added,
+            // so that a new texture doesn't cost its maximum size right away
+            unsigned int size = initialTextureSize;
+            while ((size < width) || (size < rowHeight))
+                size *= 2;
+
+            m_pages.push_back(Page());
+            if (!createTransparentTexture(m_pages.back().texture, std::min(size, maximumSize), m_isSmooth) ||
+                !createRow(m_pages.back(), width, rowHeight))
+            {
+                m_pages.pop_back();
+                err() << "Failed to add image to texture atlas, failed to create texture" << std::endl;
+                return false;
+            }
+
+            page = &m_pages.back();
+            pageIndex = m_pages.size() - 1;
+        }
+
+        rowIndex = page->rows.size() - 1;
+    }
+
+    // Find the image's rectangle on the selected row, without its padding
+    entry.page = pageIndex;
+    entry.rect = priv::ShelfPacker::allocate(*page, rowIndex, width, height);
+    entry.rect.width = image.getSize().x;
+    entry.rect.height = image.getSize().y;
+
+    // Copy the pixels to the texture
+    page->texture.update(image, entry.rect.left, entry.rect.top);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Row* TextureAtlas::createRow(Page& page, unsigned int width, unsigned int height)
+{
+    const unsigned int maximumSize = std::min(m_maximumSize, Texture::getMaximumSize());
+
+    while (!priv::ShelfPacker::hasRoomForRow(page, width, height))
+    {
+        // Not enough space: resize the texture if possible
+        unsigned int size = page.texture.getSize().x;
+        if (size >= maximumSize)
+            return NULL;
+
+        // Make the texture 2 times bigger, the new area being transparent
+        Texture newTexture;
+        if (!createTransparentTexture(newTexture, std::min(size * 2, maximumSize), m_isSmooth))
+            return NULL;
+
+        newTexture.update(page.texture);
+        page.texture.swap(newTexture);
+
+        // The existing rows got wider, so they may have free space again
+        priv::ShelfPacker::reopenRows(page);
+    }
+
+    // We can now create the new row
+    priv::ShelfPacker::addRow(page, height);
+
+    return &page.rows.back();
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Page::Page() :
+nextRow(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Entry::Entry() :
+page(InvalidIndex),
+rect()
+{
+}
+
+} // namespace sf
@@ -0,0 +1,325 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureReadback.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/Window/Window.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstddef>
+#include <cstring>
+
+
+namespace
+{
+    // Release pixels allocated with new[]
+    void deleteArray(sf::Uint8* pixels, void*)
+    {
+        delete[] pixels;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureReadback::TextureReadback() :
+m_size      (0, 0),
+m_actualSize(0, 0),
+m_flipped   (false),
+m_buffer    (0),
+m_capacity  (0),
+m_fence     (NULL),
+m_image     (),
+m_texture   (),
+m_isPending (false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReadback::~TextureReadback()
+{
+    cancel();
+
+    if (m_buffer)
+    {
+        TransientContextLock lock;
+
+        GLuint buffer = static_cast<GLuint>(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::start(const Texture& texture)
+{
+    cancel();
+
+    if (!texture.m_texture)
+        return false;
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    m_size       = texture.m_size;
+    m_actualSize = texture.m_actualSize;
+    m_flipped    = texture.m_pixelsFlipped;
+
+#ifndef SFML_OPENGL_ES
+
+    if (GLEXT_pixel_buffer_object && GLEXT_map_buffer_range && GLEXT_sync)
+    {
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        std::size_t size = static_cast<std::size_t>(m_actualSize.x) * m_actualSize.y * 4;
+
+        if (!m_buffer)
+        {
+            GLuint buffer = 0;
+            glCheck(GLEXT_glGenBuffers(1, &buffer));
+            m_buffer = static_cast<unsigned int>(buffer);
+        }
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+
+        // Grow the buffer if the texture doesn't fit
+        if (m_capacity < size)
+        {
+            glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), NULL, GLEXT_GL_STREAM_READ));
+            m_capacity = size;
+        }
+
+        // With a pack buffer bound, the pixels are written to the buffer
+        // by the graphics card without blocking the CPU
+        glCheck(glBindTexture(GL_TEXTURE_2D, texture.m_texture));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+        GLEXT_GLsync fence = NULL;
+        glCheck(fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        m_fence = fence;
+
+        m_isPending = true;
+        return true;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // Pixel buffers are not available, read the pixels synchronously
+    m_image = texture.copyToImage();
+    m_size = m_image.getSize();
+
+    m_isPending = true;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::start(const Window& window)
+{
+    Vector2u size = window.getSize();
+
+    // Reuse the internal texture as long as the window keeps the same size
+    if ((m_texture.getSize() != size) && !m_texture.create(size.x, size.y))
+    {
+        cancel();
+        return false;
+    }
+
+    m_texture.update(window);
+
+    return start(m_texture);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::start(RenderWindow& window)
+{
+    // Render the pending batched primitives, so that they are captured too
+    window.flush();
+
+    return start(static_cast<const Window&>(window));
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::isPending() const
+{
+    return m_isPending;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::isReady() const
+{
+    if (!m_isPending)
+        return false;
+
+    // Pixels read synchronously are always ready
+    if (!m_fence)
+        return true;
+
+    TransientContextLock lock;
+
+    // Poll the fence without waiting, making sure that the pending commands get executed
+    GLenum status = GLEXT_GL_WAIT_FAILED;
+    glCheck(status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_fence), GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+
+    return (status != GLEXT_GL_TIMEOUT_EXPIRED) && (status != GLEXT_GL_WAIT_FAILED);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureReadback::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::copyToPixels(Uint8* pixels)
+{
+    if (!m_isPending || !pixels)
+        return false;
+
+    if (!m_fence)
+    {
+        // The pixels were read synchronously
+        if (m_image.getPixelsPtr())
+            std::memcpy(pixels, m_image.getPixelsPtr(), static_cast<std::size_t>(m_size.x) * m_size.y * 4);
+
+        cancel();
+        return true;
+    }
+
+    TransientContextLock lock;
+
+    // Wait until the pixels have been written to the buffer
+    glCheck(GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_fence), GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, static_cast<GLuint64>(-1)));
+
+    std::size_t size = static_cast<std::size_t>(m_actualSize.x) * m_actualSize.y * 4;
+    const void* mapped = NULL;
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+    glCheck(mapped = GLEXT_glMapBufferRange(GLEXT_GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GLEXT_GL_MAP_READ_BIT));
+
+    if (mapped)
+    {
+        const Uint8* src = static_cast<const Uint8*>(mapped);
+
+        if ((m_size == m_actualSize) && !m_flipped)
+        {
+            // Texture is not padded nor flipped, we can use a direct copy
+            std::memcpy(pixels, src, size);
+        }
+        else
+        {
+            // Copy the useful rows, in the right order
+            std::ptrdiff_t srcPitch = static_cast<std::ptrdiff_t>(m_actualSize.x) * 4;
+            std::size_t    dstPitch = static_cast<std::size_t>(m_size.x) * 4;
+
+            // Handle the case where source pixels are flipped vertically
+            if (m_flipped)
+            {
+                src += srcPitch * (m_size.y - 1);
+                srcPitch = -srcPitch;
+            }
+
+            for (unsigned int i = 0; i < m_size.y; ++i)
+            {
+                std::memcpy(pixels + i * dstPitch, src, dstPitch);
+                src += srcPitch;
+            }
+        }
+
+        glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+    }
+    else
+    {
+        err() << "Failed to read the pixels of a texture, its pixel buffer could not be mapped" << std::endl;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    cancel();
+    return mapped != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::copyToImage(Image& image)
+{
+    if (!m_isPending)
+        return false;
+
+    if (!m_fence)
+    {
+        // The pixels were read synchronously, hand them over
+        image = m_image;
+        cancel();
+        return true;
+    }
+
+    // Write the pixels directly to the storage of the image
+    Uint8* pixels = new Uint8[static_cast<std::size_t>(m_size.x) * m_size.y * 4];
+    Vector2u size = m_size;
+
+    if (!copyToPixels(pixels))
+    {
+        delete[] pixels;
+        return false;
+    }
+
+    image.create(size.x, size.y, pixels, &deleteArray);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureReadback::cancel()
+{
+    if (m_fence)
+    {
+        TransientContextLock lock;
+
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_fence)));
+        m_fence = NULL;
+    }
+
+    m_image = Image();
+    m_isPending = false;
+}
+
+} // namespace sf
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
 
 
 namespace sf
@@ -33,16 +34,17 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-TextureSaver::TextureSaver()
+TextureSaver::TextureSaver(GLenum target) :
+m_target(target)
 {
-    glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &m_textureBinding));
+    glCheck(glGetIntegerv((target == GL_TEXTURE_2D) ? GL_TEXTURE_BINDING_2D : GLEXT_GL_TEXTURE_BINDING_2D_ARRAY, &m_textureBinding));
 }
 
 
 ////////////////////////////////////////////////////////////
 TextureSaver::~TextureSaver()
 {
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_textureBinding));
+    glCheck(glBindTexture(m_target, m_textureBinding));
 }
 
 } // namespace priv
@@ -44,12 +44,14 @@ class TextureSaver
 public:
 
     ////////////////////////////////////////////////////////////
-    /// \brief Default constructor
+    /// \brief Constructor
     ///
     /// The current texture binding is saved.
     ///
+    /// \param target Texture target whose binding is saved
+    ///
     ////////////////////////////////////////////////////////////
-    TextureSaver();
+    explicit TextureSaver(GLenum target = GL_TEXTURE_2D);
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -64,7 +66,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    GLint m_textureBinding; //!< Texture binding to restore
+    GLenum m_target;         //!< Texture target whose binding is saved
+    GLint  m_textureBinding; //!< Texture binding to restore
 };
 
 } // namespace priv
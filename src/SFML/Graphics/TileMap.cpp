@@ -0,0 +1,539 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Beyond this number of ranges of modified tiles in a chunk, the closest ones
+    // are merged: a few redundant tiles cost less than many small uploads
+    const std::size_t maxDirtyRanges = 8;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const Uint32 TileMap::EmptyTile = 0xFFFFFFFF;
+
+
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_size           (0, 0),
+m_tileSize       (0, 0),
+m_chunkSize      (0),
+m_chunkCount     (0, 0),
+m_texture        (NULL),
+m_tilesetColumns (0),
+m_tiles          (),
+m_chunks         (),
+m_cachedChunks   (),
+m_chunkCacheSize (256),
+m_drawCount      (0),
+m_vertices       (),
+m_drawnChunkCount(0),
+m_uploadedBytes  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TileMap::TileMap(const TileMap& copy) :
+Drawable         (copy),
+Transformable    (copy),
+m_size           (copy.m_size),
+m_tileSize       (copy.m_tileSize),
+m_chunkSize      (copy.m_chunkSize),
+m_chunkCount     (copy.m_chunkCount),
+m_texture        (copy.m_texture),
+m_tilesetColumns (copy.m_tilesetColumns),
+m_tiles          (copy.m_tiles),
+m_chunks         (copy.m_chunks.size()),
+m_cachedChunks   (),
+m_chunkCacheSize (copy.m_chunkCacheSize),
+m_drawCount      (0),
+m_vertices       (),
+m_drawnChunkCount(0),
+m_uploadedBytes  (0)
+{
+    // The chunks of the copy have no vertex buffer yet
+    for (std::size_t i = 0; i < m_chunks.size(); ++i)
+    {
+        m_chunks[i].buffer = NULL;
+        m_chunks[i].lastDraw = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TileMap::~TileMap()
+{
+    releaseAllChunks();
+}
+
+
+////////////////////////////////////////////////////////////
+TileMap& TileMap::operator =(const TileMap& right)
+{
+    if (this != &right)
+    {
+        TileMap temp(right);
+
+        Transformable::operator =(temp);
+        std::swap(m_size,           temp.m_size);
+        std::swap(m_tileSize,       temp.m_tileSize);
+        std::swap(m_chunkSize,      temp.m_chunkSize);
+        std::swap(m_chunkCount,     temp.m_chunkCount);
+        std::swap(m_texture,        temp.m_texture);
+        std::swap(m_tilesetColumns, temp.m_tilesetColumns);
+        std::swap(m_chunkCacheSize, temp.m_chunkCacheSize);
+        m_tiles.swap(temp.m_tiles);
+        m_chunks.swap(temp.m_chunks);
+        m_cachedChunks.swap(temp.m_cachedChunks);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::create(const Vector2u& size, const Vector2u& tileSize, unsigned int chunkSize)
+{
+    m_size       = size;
+    m_tileSize   = tileSize;
+    m_chunkSize  = std::max(chunkSize, 1u);
+    m_chunkCount = Vector2u((size.x + m_chunkSize - 1) / m_chunkSize, (size.y + m_chunkSize - 1) / m_chunkSize);
+
+    m_tiles.assign(static_cast<std::size_t>(size.x) * size.y, EmptyTile);
+
+    // Buffers are only created when their chunk is drawn for the first time
+    Chunk chunk;
+    chunk.buffer = NULL;
+    chunk.lastDraw = 0;
+
+    releaseAllChunks();
+    m_chunks.clear();
+    m_chunks.resize(static_cast<std::size_t>(m_chunkCount.x) * m_chunkCount.y, chunk);
+    m_cachedChunks.clear();
+
+    // Find the number of tiles per row of the tileset again, since the tile size may have changed
+    if (m_texture)
+        setTexture(*m_texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTexture(const Texture& texture)
+{
+    unsigned int columns = m_tileSize.x > 0 ? texture.getSize().x / m_tileSize.x : 0;
+
+    // The texture coordinates only depend on the layout of the tileset
+    if (columns != m_tilesetColumns)
+    {
+        m_tilesetColumns = columns;
+        invalidateAll();
+    }
+
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int x, unsigned int y, Uint32 tile)
+{
+    if ((x >= m_size.x) || (y >= m_size.y))
+        return;
+
+    Uint32& current = m_tiles[static_cast<std::size_t>(y) * m_size.x + x];
+    if (current == tile)
+        return;
+
+    current = tile;
+
+    // Mark the tile in its chunk
+    std::size_t index = (y / m_chunkSize) * m_chunkCount.x + x / m_chunkSize;
+    unsigned int local = (y % m_chunkSize) * getChunkArea(index).width + x % m_chunkSize;
+    invalidate(index, local, local);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTiles(const Uint32* tiles)
+{
+    if (m_tiles.empty())
+        return;
+
+    std::copy(tiles, tiles + m_tiles.size(), m_tiles.begin());
+    invalidateAll();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TileMap::getTile(unsigned int x, unsigned int y) const
+{
+    if ((x >= m_size.x) || (y >= m_size.y))
+        return EmptyTile;
+
+    return m_tiles[static_cast<std::size_t>(y) * m_size.x + x];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TileMap::getChunkSize() const
+{
+    return m_chunkSize;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_size.x) * m_tileSize.x, static_cast<float>(m_size.y) * m_tileSize.y);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setChunkCacheSize(std::size_t chunkCount)
+{
+    m_chunkCacheSize = chunkCount;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileMap::getChunkCacheSize() const
+{
+    return m_chunkCacheSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileMap::getCachedChunkCount() const
+{
+    return m_cachedChunks.size();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TileMap::getDrawnChunkCount() const
+{
+    return m_drawnChunkCount;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileMap::getUploadedByteCount() const
+{
+    return m_uploadedBytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, RenderStates states) const
+{
+    m_drawnChunkCount = 0;
+    m_uploadedBytes = 0;
+
+    if (m_chunks.empty() || (m_tileSize.x == 0) || (m_tileSize.y == 0))
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    // Express the visible area in the local coordinate system of the map
+    const View& view = target.getView();
+    FloatRect area = view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    area = states.transform.getInverse().transformRect(area);
+
+    // Find the range of chunks that intersect it
+    float chunkWidth  = static_cast<float>(m_chunkSize) * m_tileSize.x;
+    float chunkHeight = static_cast<float>(m_chunkSize) * m_tileSize.y;
+    float left   = std::max(std::floor(area.left / chunkWidth), 0.f);
+    float top    = std::max(std::floor(area.top / chunkHeight), 0.f);
+    float right  = std::min(std::floor((area.left + area.width) / chunkWidth), static_cast<float>(m_chunkCount.x) - 1);
+    float bottom = std::min(std::floor((area.top + area.height) / chunkHeight), static_cast<float>(m_chunkCount.y) - 1);
+    if (!(left <= right) || !(top <= bottom))
+        return;
+
+    bool useVertexBuffer = VertexBuffer::isAvailable();
+    ++m_drawCount;
+
+    for (unsigned int y = static_cast<unsigned int>(top); y <= static_cast<unsigned int>(bottom); ++y)
+    {
+        for (unsigned int x = static_cast<unsigned int>(left); x <= static_cast<unsigned int>(right); ++x)
+        {
+            std::size_t index = y * m_chunkCount.x + x;
+            Chunk& chunk = m_chunks[index];
+            Rect<unsigned int> chunkArea = getChunkArea(index);
+            unsigned int tileCount = chunkArea.width * chunkArea.height;
+
+            chunk.lastDraw = m_drawCount;
+
+            bool drawBuffer = useVertexBuffer;
+            if (drawBuffer && !chunk.buffer)
+            {
+                // First time the chunk is visible, or since it was released: all its tiles must be uploaded
+                VertexBuffer* buffer = new VertexBuffer(Triangles, VertexBuffer::Static);
+                if (buffer->create(tileCount * 6))
+                {
+                    chunk.buffer = buffer;
+                    m_cachedChunks.push_back(index);
+                    invalidate(index, 0, tileCount - 1);
+                }
+                else
+                {
+                    delete buffer;
+                    drawBuffer = false;
+                }
+            }
+
+            if (drawBuffer)
+            {
+                // Upload only the ranges of tiles that changed
+                for (std::size_t i = 0; (i < chunk.dirtyTiles.size()) && drawBuffer; ++i)
+                {
+                    const TileRange& range = chunk.dirtyTiles[i];
+                    buildTiles(index, range.first, range.second);
+                    if (chunk.buffer->update(&m_vertices[0], m_vertices.size(), range.first * 6))
+                        m_uploadedBytes += m_vertices.size() * sizeof(Vertex);
+                    else
+                        drawBuffer = false;
+                }
+
+                if (drawBuffer)
+                {
+                    chunk.dirtyTiles.clear();
+                    target.draw(*chunk.buffer, states);
+                }
+            }
+
+            // Without vertex buffers, the chunk is built and sent every frame
+            if (!drawBuffer)
+            {
+                buildTiles(index, 0, tileCount - 1);
+                target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+            }
+
+            ++m_drawnChunkCount;
+        }
+    }
+
+    releaseChunks();
+}
+
+
+////////////////////////////////////////////////////////////
+Rect<unsigned int> TileMap::getChunkArea(std::size_t index) const
+{
+    unsigned int left = static_cast<unsigned int>(index % m_chunkCount.x) * m_chunkSize;
+    unsigned int top  = static_cast<unsigned int>(index / m_chunkCount.x) * m_chunkSize;
+
+    // Chunks on the right and bottom borders may be smaller
+    return Rect<unsigned int>(left, top, std::min(m_chunkSize, m_size.x - left), std::min(m_chunkSize, m_size.y - top));
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::invalidate(std::size_t index, unsigned int first, unsigned int last) const
+{
+    Chunk& chunk = m_chunks[index];
+
+    // Chunks that were never drawn will be uploaded entirely anyway
+    if (!chunk.buffer)
+        return;
+
+    // Merge the new range with the ranges that it overlaps or touches
+    std::vector<TileRange>& ranges = chunk.dirtyTiles;
+    std::vector<TileRange>::iterator begin = ranges.begin();
+    while ((begin != ranges.end()) && (begin->second + 1 < first))
+        ++begin;
+
+    std::vector<TileRange>::iterator end = begin;
+    while ((end != ranges.end()) && (end->first <= last + 1))
+    {
+        first = std::min(first, end->first);
+        last  = std::max(last, end->second);
+        ++end;
+    }
+
+    begin = ranges.erase(begin, end);
+    ranges.insert(begin, TileRange(first, last));
+
+    // Too many ranges: merge the two that are the closest to each other
+    if (ranges.size() > maxDirtyRanges)
+    {
+        std::size_t closest = 0;
+        for (std::size_t i = 1; i + 1 < ranges.size(); ++i)
+        {
+            if (ranges[i + 1].first - ranges[i].second < ranges[closest + 1].first - ranges[closest].second)
+                closest = i;
+        }
+
+        ranges[closest].second = ranges[closest + 1].second;
+        ranges.erase(ranges.begin() + static_cast<std::ptrdiff_t>(closest + 1));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::invalidateAll() const
+{
+    for (std::size_t i = 0; i < m_chunks.size(); ++i)
+    {
+        Rect<unsigned int> area = getChunkArea(i);
+        invalidate(i, 0, area.width * area.height - 1);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::releaseChunks() const
+{
+    if (m_cachedChunks.size() <= m_chunkCacheSize)
+        return;
+
+    // Sort the cached chunks from the least to the most recently drawn
+    std::vector<std::pair<Uint64, std::size_t> > chunks(m_cachedChunks.size());
+    for (std::size_t i = 0; i < m_cachedChunks.size(); ++i)
+        chunks[i] = std::make_pair(m_chunks[m_cachedChunks[i]].lastDraw, m_cachedChunks[i]);
+
+    std::sort(chunks.begin(), chunks.end());
+
+    // Release the oldest ones, but never the chunks that were just drawn
+    std::size_t released = 0;
+    while ((chunks.size() - released > m_chunkCacheSize) && (chunks[released].first != m_drawCount))
+    {
+        Chunk& chunk = m_chunks[chunks[released].second];
+        delete chunk.buffer;
+        chunk.buffer = NULL;
+        chunk.dirtyTiles.clear();
+        ++released;
+    }
+
+    m_cachedChunks.clear();
+    for (std::size_t i = released; i < chunks.size(); ++i)
+        m_cachedChunks.push_back(chunks[i].second);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::releaseAllChunks()
+{
+    for (std::vector<std::size_t>::const_iterator it = m_cachedChunks.begin(); it != m_cachedChunks.end(); ++it)
+    {
+        Chunk& chunk = m_chunks[*it];
+        delete chunk.buffer;
+        chunk.buffer = NULL;
+        chunk.dirtyTiles.clear();
+    }
+
+    m_cachedChunks.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::buildTiles(std::size_t index, unsigned int first, unsigned int last) const
+{
+    Rect<unsigned int> area = getChunkArea(index);
+    float tileWidth  = static_cast<float>(m_tileSize.x);
+    float tileHeight = static_cast<float>(m_tileSize.y);
+
+    m_vertices.resize((last - first + 1) * 6);
+
+    for (unsigned int i = first; i <= last; ++i)
+    {
+        Vertex* quad = &m_vertices[(i - first) * 6];
+
+        unsigned int x = area.left + i % area.width;
+        unsigned int y = area.top + i / area.width;
+        Uint32 tile = m_tiles[static_cast<std::size_t>(y) * m_size.x + x];
+
+        // Empty tiles keep their place in the buffer as degenerate triangles
+        if (tile == EmptyTile)
+        {
+            for (std::size_t j = 0; j < 6; ++j)
+                quad[j] = Vertex();
+            continue;
+        }
+
+        float left   = x * tileWidth;
+        float top    = y * tileHeight;
+        float right  = left + tileWidth;
+        float bottom = top + tileHeight;
+
+        float u = 0.f;
+        float v = 0.f;
+        if (m_tilesetColumns > 0)
+        {
+            u = static_cast<float>(tile % m_tilesetColumns) * tileWidth;
+            v = static_cast<float>(tile / m_tilesetColumns) * tileHeight;
+        }
+
+        quad[0] = Vertex(Vector2f(left, top),     Vector2f(u, v));
+        quad[1] = Vertex(Vector2f(left, bottom),  Vector2f(u, v + tileHeight));
+        quad[2] = Vertex(Vector2f(right, top),    Vector2f(u + tileWidth, v));
+        quad[3] = quad[2];
+        quad[4] = quad[1];
+        quad[5] = Vertex(Vector2f(right, bottom), Vector2f(u + tileWidth, v + tileHeight));
+    }
+}
+
+} // namespace sf
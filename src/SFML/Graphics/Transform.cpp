@@ -26,9 +26,94 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Simd.hpp>
+#include <algorithm>
 #include <cmath>
 
 
+namespace
+{
+    // Transform an array of positions; consecutive positions are separated by stride bytes,
+    // which lets the same kernel work on tightly packed points and on vertices.
+    // Only the 2D affine part of the matrix is read, the projective row is always (0, 0, 1).
+    void transformPositions(const float* matrix, const char* in, char* out, std::size_t stride, std::size_t count)
+    {
+        const float a = matrix[0];
+        const float b = matrix[4];
+        const float c = matrix[12];
+        const float d = matrix[1];
+        const float e = matrix[5];
+        const float f = matrix[13];
+
+        std::size_t i = 0;
+
+        if ((a == 1.f) && (b == 0.f) && (d == 0.f) && (e == 1.f))
+        {
+            // Pure translation: no multiplication needed
+            for (; i < count; ++i)
+            {
+                const float* src = reinterpret_cast<const float*>(in + i * stride);
+                float* dst = reinterpret_cast<float*>(out + i * stride);
+                dst[0] = src[0] + c;
+                dst[1] = src[1] + f;
+            }
+            return;
+        }
+
+    #if defined(SFML_GRAPHICS_SSE2)
+
+        // Two points per register: [x0 y0 x1 y1]
+        const __m128 mx = _mm_setr_ps(a, d, a, d);
+        const __m128 my = _mm_setr_ps(b, e, b, e);
+        const __m128 mt = _mm_setr_ps(c, f, c, f);
+        for (; i + 2 <= count; i += 2)
+        {
+            const char* src = in + i * stride;
+            char* dst = out + i * stride;
+            __m128 p = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(src));
+            p = _mm_loadh_pi(p, reinterpret_cast<const __m64*>(src + stride));
+            __m128 xs = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 ys = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, mx), _mm_mul_ps(ys, my)), mt);
+            _mm_storel_pi(reinterpret_cast<__m64*>(dst), r);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(dst + stride), r);
+        }
+
+    #elif defined(SFML_GRAPHICS_NEON)
+
+        // Two points per iteration, transposed so that X and Y are in separate registers
+        const float32x2_t tx = vdup_n_f32(c);
+        const float32x2_t ty = vdup_n_f32(f);
+        for (; i + 2 <= count; i += 2)
+        {
+            const char* src = in + i * stride;
+            char* dst = out + i * stride;
+            float32x2x2_t p = vtrn_f32(vld1_f32(reinterpret_cast<const float*>(src)),
+                                       vld1_f32(reinterpret_cast<const float*>(src + stride)));
+            float32x2_t x = vadd_f32(vadd_f32(vmul_n_f32(p.val[0], a), vmul_n_f32(p.val[1], b)), tx);
+            float32x2_t y = vadd_f32(vadd_f32(vmul_n_f32(p.val[0], d), vmul_n_f32(p.val[1], e)), ty);
+            float32x2x2_t r = vtrn_f32(x, y);
+            vst1_f32(reinterpret_cast<float*>(dst), r.val[0]);
+            vst1_f32(reinterpret_cast<float*>(dst + stride), r.val[1]);
+        }
+
+    #endif
+
+        // Remaining points (or all of them without SIMD support)
+        for (; i < count; ++i)
+        {
+            const float* src = reinterpret_cast<const float*>(in + i * stride);
+            float* dst = reinterpret_cast<float*>(out + i * stride);
+            const float x = src[0];
+            const float y = src[1];
+            dst[0] = a * x + b * y + c;
+            dst[1] = d * x + e * y + f;
+        }
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -113,13 +198,14 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
     // Transform the 4 corners of the rectangle
-    const Vector2f points[] =
+    Vector2f points[] =
     {
-        transformPoint(rectangle.left, rectangle.top),
-        transformPoint(rectangle.left, rectangle.top + rectangle.height),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top + rectangle.height)
+        Vector2f(rectangle.left, rectangle.top),
+        Vector2f(rectangle.left, rectangle.top + rectangle.height),
+        Vector2f(rectangle.left + rectangle.width, rectangle.top),
+        Vector2f(rectangle.left + rectangle.width, rectangle.top + rectangle.height)
     };
+    transformPoints(points, points, 4);
 
     // Compute the bounding rectangle of the transformed points
     float left = points[0].x;
@@ -138,6 +224,32 @@ FloatRect Transform::transformRect(const FloatRect& rectangle) const
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* points, Vector2f* result, std::size_t count) const
+{
+    if (count == 0)
+        return;
+
+    transformPositions(m_matrix, reinterpret_cast<const char*>(&points[0].x),
+                       reinterpret_cast<char*>(&result[0].x), sizeof(Vector2f), count);
+}
+
+
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vertex* vertices, Vertex* result, std::size_t count) const
+{
+    if (count == 0)
+        return;
+
+    // Copy the colors and texture coordinates, then transform the positions in place
+    if (vertices != result)
+        std::copy(vertices, vertices + count, result);
+
+    char* positions = reinterpret_cast<char*>(&result[0].position.x);
+    transformPositions(m_matrix, positions, positions, sizeof(Vertex), count);
+}
+
+
 ////////////////////////////////////////////////////////////
 Transform& Transform::combine(const Transform& transform)
 {
@@ -29,7 +29,21 @@
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/Window/WindowImpl.hpp>
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <map>
+
+
+namespace
+{
+    // Functions registered with setDisplayCallback, by window; they are kept
+    // outside of the class so that its layout doesn't depend on them
+    typedef std::pair<void(*)(void*), void*> DisplayCallbackEntry;
+    typedef std::map<const sf::Window*, DisplayCallbackEntry> DisplayCallbackMap;
+    DisplayCallbackMap displayCallbacks;
+    sf::Mutex displayCallbackMutex;
+}
 
 
 namespace sf
@@ -65,6 +79,8 @@ m_frameTimeLimit(Time::Zero)
 Window::~Window()
 {
     close();
+
+    setDisplayCallback(NULL, NULL);
 }
 
 
@@ -214,6 +230,19 @@ bool Window::setActive(bool active) const
 ////////////////////////////////////////////////////////////
 void Window::display()
 {
+    // Let the derived class finish the frame first
+    DisplayCallbackEntry callback(NULL, NULL);
+    {
+        Lock lock(displayCallbackMutex);
+
+        DisplayCallbackMap::const_iterator it = displayCallbacks.find(this);
+        if (it != displayCallbacks.end())
+            callback = it->second;
+    }
+
+    if (callback.first)
+        callback.first(callback.second);
+
     // Display the backbuffer on screen
     if (setActive())
         m_context->display();
@@ -227,6 +256,18 @@ void Window::display()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setDisplayCallback(DisplayCallback callback, void* arg)
+{
+    Lock lock(displayCallbackMutex);
+
+    if (callback)
+        displayCallbacks[this] = DisplayCallbackEntry(callback, arg);
+    else
+        displayCallbacks.erase(this);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::initialize()
 {
@@ -0,0 +1,63 @@
+#include <SFML/Graphics/CircleShape.hpp>
+#include "GraphicsUtil.hpp"
+#include <cmath>
+
+TEST_CASE("sf::CircleShape class", "[graphics]")
+{
+    SECTION("Points")
+    {
+        sf::CircleShape circle(10.f, 8);
+        CHECK(circle.getPointCount() == 8);
+
+        const float pi = 3.141592654f;
+        for (std::size_t i = 0; i < circle.getPointCount(); ++i)
+        {
+            float angle = i * 2 * pi / 8 - pi / 2;
+            sf::Vector2f point = circle.getPoint(i);
+            CHECK(point.x == Approx(10.f + std::cos(angle) * 10.f));
+            CHECK(point.y == Approx(10.f + std::sin(angle) * 10.f));
+        }
+    }
+
+    SECTION("Radius and point count changes")
+    {
+        sf::CircleShape circle(5.f, 4);
+        CHECK(circle.getPoint(1).x == Approx(10.f));
+        CHECK(circle.getPoint(1).y == Approx(5.f));
+
+        circle.setRadius(20.f);
+        CHECK(circle.getPoint(1).x == Approx(40.f));
+        CHECK(circle.getPoint(1).y == Approx(20.f));
+
+        circle.setPointCount(8);
+        CHECK(circle.getPointCount() == 8);
+        CHECK(circle.getPoint(2).x == Approx(40.f));
+        CHECK(circle.getPoint(2).y == Approx(20.f));
+    }
+
+    SECTION("Bounds")
+    {
+        sf::CircleShape circle(10.f, 4);
+        sf::FloatRect bounds = circle.getLocalBounds();
+        CHECK(bounds.left == Approx(0.f));
+        CHECK(bounds.top == Approx(0.f));
+        CHECK(bounds.width == Approx(20.f));
+        CHECK(bounds.height == Approx(20.f));
+
+        circle.setRadius(15.f);
+        bounds = circle.getLocalBounds();
+        CHECK(bounds.width == Approx(30.f));
+        CHECK(bounds.height == Approx(30.f));
+
+        // The outline of a square extends its corners along the diagonals
+        circle.setOutlineThickness(1.f);
+        bounds = circle.getLocalBounds();
+        CHECK(bounds.left == Approx(-std::sqrt(2.f)));
+        CHECK(bounds.width == Approx(30.f + 2 * std::sqrt(2.f)));
+
+        circle.setOutlineThickness(0.f);
+        bounds = circle.getLocalBounds();
+        CHECK(bounds.left == Approx(0.f));
+        CHECK(bounds.width == Approx(30.f));
+    }
+}
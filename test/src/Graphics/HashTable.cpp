@@ -0,0 +1,128 @@
+#include <SFML/Graphics/HashTable.hpp>
+#include <map>
+#include "GraphicsUtil.hpp"
+
+TEST_CASE("sf::priv::HashTable class template", "[graphics]")
+{
+    sf::priv::HashTable<int> table;
+
+    SECTION("Default constructor")
+    {
+        CHECK(table.getSize() == 0);
+        CHECK(table.find(0) == NULL);
+        CHECK(table.find(42) == NULL);
+    }
+
+    SECTION("Insertion")
+    {
+        table.insert(1, 10);
+        table.insert(2, 20);
+
+        REQUIRE(table.find(1) != NULL);
+        REQUIRE(table.find(2) != NULL);
+        CHECK(*table.find(1) == 10);
+        CHECK(*table.find(2) == 20);
+        CHECK(table.find(3) == NULL);
+        CHECK(table.getSize() == 2);
+
+        SECTION("Replacement")
+        {
+            table.insert(1, 11);
+            CHECK(*table.find(1) == 11);
+            CHECK(table.getSize() == 2);
+        }
+
+        SECTION("Const lookup")
+        {
+            const sf::priv::HashTable<int>& constTable = table;
+            REQUIRE(constTable.find(2) != NULL);
+            CHECK(*constTable.find(2) == 20);
+            CHECK(constTable.find(3) == NULL);
+        }
+    }
+
+    SECTION("Growth")
+    {
+        for (sf::Uint64 i = 0; i < 1000; ++i)
+            table.insert(i << 32, static_cast<int>(i));
+
+        CHECK(table.getSize() == 1000);
+
+        bool allFound = true;
+        for (sf::Uint64 i = 0; i < 1000; ++i)
+        {
+            const int* value = table.find(i << 32);
+            allFound = allFound && value && (*value == static_cast<int>(i));
+        }
+        CHECK(allFound);
+        CHECK(table.find(static_cast<sf::Uint64>(1000) << 32) == NULL);
+    }
+
+    SECTION("Erasure")
+    {
+        std::map<sf::Uint64, int> reference;
+        for (sf::Uint64 i = 0; i < 200; ++i)
+        {
+            table.insert(i * 16, static_cast<int>(i));
+            reference[i * 16] = static_cast<int>(i);
+        }
+
+        // Erase every third key, so that the remaining ones have to be shifted back
+        for (sf::Uint64 i = 0; i < 200; i += 3)
+        {
+            table.erase(i * 16);
+            reference.erase(i * 16);
+        }
+        table.erase(12345);
+
+        CHECK(table.getSize() == reference.size());
+
+        bool matches = true;
+        for (sf::Uint64 i = 0; i < 200; ++i)
+        {
+            const int* value = table.find(i * 16);
+            std::map<sf::Uint64, int>::const_iterator it = reference.find(i * 16);
+            if (it == reference.end())
+                matches = matches && !value;
+            else
+                matches = matches && value && (*value == it->second);
+        }
+        CHECK(matches);
+    }
+
+    SECTION("Iteration")
+    {
+        for (sf::Uint64 i = 1; i <= 100; ++i)
+            table.insert(i * 7, static_cast<int>(i));
+
+        std::size_t count = 0;
+        bool matches = true;
+        for (std::size_t i = 0; i < table.getSlotCount(); ++i)
+        {
+            sf::Uint64 key = 0;
+            const int* value = table.getEntry(i, key);
+            if (value)
+            {
+                ++count;
+                matches = matches && (key == static_cast<sf::Uint64>(*value) * 7);
+            }
+        }
+        CHECK(count == 100);
+        CHECK(matches);
+    }
+
+    SECTION("Clear")
+    {
+        table.insert(1, 10);
+        table.insert(2, 20);
+        table.clear();
+
+        CHECK(table.getSize() == 0);
+        CHECK(table.find(1) == NULL);
+        CHECK(table.find(2) == NULL);
+
+        table.insert(3, 30);
+        REQUIRE(table.find(3) != NULL);
+        CHECK(*table.find(3) == 30);
+    }
+}
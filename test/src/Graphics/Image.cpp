@@ -0,0 +1,347 @@
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // Fill an image with pixels covering many combinations of color and alpha values
+    void createPattern(sf::Image& image, unsigned int width, unsigned int height, unsigned int seed)
+    {
+        image.create(width, height);
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                unsigned int i = (x + y * width) * 97 + seed;
+                image.setPixel(x, y, sf::Color(i * 31 % 256, i * 57 % 256, i * 13 % 256, i * 7 % 256));
+            }
+        }
+    }
+
+    // Pixel deleter that counts how many times it is called
+    void countingDeleter(sf::Uint8* pixels, void* userData)
+    {
+        delete[] pixels;
+        ++*static_cast<int*>(userData);
+    }
+
+    // Append bytes and little endian integers to a file in memory
+    void appendBytes(std::vector<sf::Uint8>& file, const sf::Uint8* bytes, std::size_t count)
+    {
+        file.insert(file.end(), bytes, bytes + count);
+    }
+    void appendInteger(std::vector<sf::Uint8>& file, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            file.push_back(static_cast<sf::Uint8>(value >> (8 * i)));
+    }
+}
+
+TEST_CASE("sf::Image class", "[graphics]")
+{
+    // Odd sizes exercise both the vectorized loops and the remaining pixels
+    const unsigned int width  = 37;
+    const unsigned int height = 5;
+
+    SECTION("Create with color")
+    {
+        sf::Image image;
+        image.create(width, height, sf::Color(10, 20, 30, 40));
+        CHECK(image.getSize() == sf::Vector2u(width, height));
+        CHECK(image.getPixel(0, 0) == sf::Color(10, 20, 30, 40));
+        CHECK(image.getPixel(width - 1, height - 1) == sf::Color(10, 20, 30, 40));
+    }
+
+    SECTION("Copy")
+    {
+        sf::Image image;
+        createPattern(image, width, height, 0);
+
+        sf::Image copy(image);
+        CHECK(copy.getSize() == image.getSize());
+        CHECK(copy.getPixelsPtr() != image.getPixelsPtr());
+        CHECK(copy.getPixel(width - 1, height - 1) == image.getPixel(width - 1, height - 1));
+
+        sf::Image assigned;
+        assigned = image;
+        CHECK(assigned.getPixel(3, 2) == image.getPixel(3, 2));
+
+        assigned = sf::Image();
+        CHECK(assigned.getSize() == sf::Vector2u(0, 0));
+        CHECK(assigned.getPixelsPtr() == NULL);
+    }
+
+    SECTION("Create from a moved buffer")
+    {
+        std::vector<sf::Uint8> pixels(width * height * 4, 42);
+        const sf::Uint8* storage = &pixels[0];
+
+        sf::Image image;
+        image.create(width, height, pixels);
+        CHECK(pixels.empty());
+        CHECK(image.getPixelsPtr() == storage);
+        CHECK(image.getPixel(width - 1, height - 1) == sf::Color(42, 42, 42, 42));
+
+        // A buffer that is too small is rejected and left untouched
+        std::vector<sf::Uint8> small(4 * 4, 0);
+        image.create(width, height, small);
+        CHECK(small.size() == 16);
+        CHECK(image.getSize() == sf::Vector2u(0, 0));
+    }
+
+    SECTION("Create from adopted pixels")
+    {
+        int released = 0;
+
+        {
+            sf::Uint8* pixels = new sf::Uint8[width * height * 4];
+            sf::Image image;
+            image.create(width, height, pixels, &countingDeleter, &released);
+            CHECK(image.getPixelsPtr() == pixels);
+
+            image.setPixel(1, 1, sf::Color::Yellow);
+            CHECK(pixels[(1 + width) * 4 + 1] == 255);
+            CHECK(released == 0);
+
+            // Replacing the pixels releases the adopted ones
+            image.create(2, 2, sf::Color::Red);
+            CHECK(released == 1);
+
+            image.create(width, height, new sf::Uint8[width * height * 4], &countingDeleter, &released);
+        }
+        CHECK(released == 2);
+
+        // Adopting an empty image releases the pixels immediately
+        sf::Image image;
+        image.create(0, 0, new sf::Uint8[4], &countingDeleter, &released);
+        CHECK(released == 3);
+        CHECK(image.getSize() == sf::Vector2u(0, 0));
+    }
+
+    SECTION("Save and load")
+    {
+        sf::Image image;
+        createPattern(image, width, height, 7);
+
+        std::vector<sf::Uint8> file;
+        REQUIRE(image.saveToMemory(file, "png"));
+
+        sf::Image loaded;
+        REQUIRE(loaded.loadFromMemory(&file[0], file.size()));
+        CHECK(loaded.getSize() == image.getSize());
+        CHECK(std::equal(image.getPixelsPtr(), image.getPixelsPtr() + width * height * 4, loaded.getPixelsPtr()));
+    }
+
+    SECTION("createMaskFromColor")
+    {
+        sf::Image image;
+        image.create(width, height, sf::Color::Red);
+        image.setPixel(3, 1, sf::Color::Green);
+        image.setPixel(width - 1, height - 1, sf::Color::Green);
+        image.createMaskFromColor(sf::Color::Red, 12);
+
+        CHECK(image.getPixel(0, 0) == sf::Color(255, 0, 0, 12));
+        CHECK(image.getPixel(width - 2, height - 1) == sf::Color(255, 0, 0, 12));
+        CHECK(image.getPixel(3, 1) == sf::Color::Green);
+        CHECK(image.getPixel(width - 1, height - 1) == sf::Color::Green);
+    }
+
+    SECTION("copy with alpha")
+    {
+        sf::Image source;
+        sf::Image destination;
+        createPattern(source, width, height, 1);
+        createPattern(destination, width, height, 2);
+
+        sf::Image result = destination;
+        result.copy(source, 0, 0, sf::IntRect(), true);
+
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                sf::Color src = source.getPixel(x, y);
+                sf::Color dst = destination.getPixel(x, y);
+                sf::Color expected((src.r * src.a + dst.r * (255 - src.a)) / 255,
+                                   (src.g * src.a + dst.g * (255 - src.a)) / 255,
+                                   (src.b * src.a + dst.b * (255 - src.a)) / 255,
+                                   src.a + dst.a * (255 - src.a) / 255);
+                CHECK(result.getPixel(x, y) == expected);
+            }
+        }
+    }
+
+    SECTION("fill")
+    {
+        sf::Image image;
+        image.create(width, height, sf::Color::Black);
+        image.fill(sf::Color::Blue, sf::IntRect(2, 1, 30, 2));
+
+        CHECK(image.getPixel(1, 1) == sf::Color::Black);
+        CHECK(image.getPixel(2, 1) == sf::Color::Blue);
+        CHECK(image.getPixel(31, 2) == sf::Color::Blue);
+        CHECK(image.getPixel(32, 2) == sf::Color::Black);
+        CHECK(image.getPixel(2, 3) == sf::Color::Black);
+
+        // The rectangle is clipped to the image
+        image.fill(sf::Color::White, sf::IntRect(30, 3, 100, 100));
+        CHECK(image.getPixel(width - 1, height - 1) == sf::Color::White);
+        CHECK(image.getPixel(29, 4) == sf::Color::Black);
+
+        // An empty rectangle fills the whole image
+        image.fill(sf::Color::Red);
+        CHECK(image.getPixel(0, 0) == sf::Color::Red);
+        CHECK(image.getPixel(width - 1, height - 1) == sf::Color::Red);
+    }
+
+    SECTION("blend")
+    {
+        sf::Image image;
+        createPattern(image, width, height, 3);
+
+        sf::Color color(200, 100, 50, 128);
+        sf::Image expected = image;
+        sf::Image source;
+        source.create(width, height, color);
+        expected.copy(source, 0, 0, sf::IntRect(), true);
+
+        image.blend(color);
+        for (unsigned int y = 0; y < height; ++y)
+            for (unsigned int x = 0; x < width; ++x)
+                CHECK(image.getPixel(x, y) == expected.getPixel(x, y));
+    }
+
+    SECTION("premultiplyAlpha")
+    {
+        sf::Image image;
+        createPattern(image, width, height, 4);
+        sf::Image original = image;
+        image.premultiplyAlpha();
+
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                sf::Color color = original.getPixel(x, y);
+                sf::Color expected((color.r * color.a + 127) / 255,
+                                   (color.g * color.a + 127) / 255,
+                                   (color.b * color.a + 127) / 255,
+                                   color.a);
+                CHECK(image.getPixel(x, y) == expected);
+            }
+        }
+    }
+
+    SECTION("swizzle")
+    {
+        sf::Image image;
+        createPattern(image, width, height, 5);
+        sf::Image original = image;
+        image.swizzle(2, 1, 0, 3);
+
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                sf::Color color = original.getPixel(x, y);
+                CHECK(image.getPixel(x, y) == sf::Color(color.b, color.g, color.r, color.a));
+            }
+        }
+
+        image.swizzle(3, 3, 3, 0);
+        sf::Color color = original.getPixel(5, 2);
+        CHECK(image.getPixel(5, 2) == sf::Color(color.a, color.a, color.a, color.b));
+    }
+
+    SECTION("flipHorizontally")
+    {
+        sf::Image image;
+        createPattern(image, width, height, 6);
+        sf::Image original = image;
+        image.flipHorizontally();
+
+        for (unsigned int y = 0; y < height; ++y)
+            for (unsigned int x = 0; x < width; ++x)
+                CHECK(image.getPixel(x, y) == original.getPixel(width - 1 - x, y));
+    }
+
+    SECTION("load DDS file")
+    {
+        // 5x3 pixels, made of two DXT1 blocks
+        std::vector<sf::Uint8> file;
+        const sf::Uint8 signature[] = {'D', 'D', 'S', ' '};
+        appendBytes(file, signature, sizeof(signature));
+        appendInteger(file, 124);             // header size
+        appendInteger(file, 0x1007);          // flags
+        appendInteger(file, 3);               // height
+        appendInteger(file, 5);               // width
+        appendInteger(file, 16);              // linear size
+        for (int i = 0; i < 13; ++i)
+            appendInteger(file, 0);           // depth, mipmap count, reserved
+        appendInteger(file, 32);              // pixel format size
+        appendInteger(file, 0x4);             // pixel format flags
+        const sf::Uint8 fourCC[] = {'D', 'X', 'T', '1'};
+        appendBytes(file, fourCC, sizeof(fourCC));
+        for (int i = 0; i < 10; ++i)
+            appendInteger(file, 0);           // masks, caps, reserved
+
+        // Red and blue with their two interpolated colors, then a transparent block
+        const sf::Uint8 blocks[] = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0x00, 0x00, 0x00,
+                                    0x1F, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF};
+        appendBytes(file, blocks, sizeof(blocks));
+
+        sf::Image image;
+        REQUIRE(image.loadFromMemory(&file[0], file.size()));
+        CHECK(image.getSize() == sf::Vector2u(5, 3));
+        CHECK(image.getPixel(0, 0) == sf::Color(255, 0, 0));
+        CHECK(image.getPixel(1, 0) == sf::Color(0, 0, 255));
+        CHECK(image.getPixel(2, 0) == sf::Color(170, 0, 85));
+        CHECK(image.getPixel(3, 0) == sf::Color(85, 0, 170));
+        CHECK(image.getPixel(0, 2) == sf::Color(255, 0, 0));
+        CHECK(image.getPixel(4, 0) == sf::Color(0, 0, 0, 0));
+        CHECK(image.getPixel(4, 2) == sf::Color(0, 0, 0, 0));
+
+        // Files that end before their last block are rejected
+        file.pop_back();
+        sf::Image truncated;
+        CHECK(!truncated.loadFromMemory(&file[0], file.size()));
+        CHECK(truncated.getSize() == sf::Vector2u(0, 0));
+    }
+
+    SECTION("load KTX file")
+    {
+        // 4x4 pixels, made of one ETC2 block with EAC alpha
+        std::vector<sf::Uint8> file;
+        const sf::Uint8 identifier[] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+        appendBytes(file, identifier, sizeof(identifier));
+        appendInteger(file, 0x04030201);      // endianness
+        appendInteger(file, 0);               // type
+        appendInteger(file, 1);               // type size
+        appendInteger(file, 0);               // format
+        appendInteger(file, 0x9278);          // internal format (RGBA8 ETC2 EAC)
+        appendInteger(file, 0x1908);          // base internal format
+        appendInteger(file, 4);               // width
+        appendInteger(file, 4);               // height
+        appendInteger(file, 0);               // depth
+        appendInteger(file, 0);               // array elements
+        appendInteger(file, 1);               // faces
+        appendInteger(file, 1);               // mipmap levels
+        appendInteger(file, 4);               // metadata size
+        appendInteger(file, 0);               // metadata
+        appendInteger(file, 16);              // image size
+
+        // Alpha around 100, then two individual colors side by side
+        const sf::Uint8 block[] = {100, 0x20, 0x12, 0x49, 0x24, 0x92, 0x49, 0x24,
+                                   0xF0, 0x88, 0x0F, 0x00, 0x00, 0x40, 0x00, 0x40};
+        appendBytes(file, block, sizeof(block));
+
+        sf::Image image;
+        REQUIRE(image.loadFromMemory(&file[0], file.size()));
+        CHECK(image.getSize() == sf::Vector2u(4, 4));
+        CHECK(image.getPixel(0, 0) == sf::Color(255, 138, 2, 94));
+        CHECK(image.getPixel(0, 1) == sf::Color(255, 138, 2, 104));
+        CHECK(image.getPixel(1, 2) == sf::Color(247, 128, 0, 104));
+        CHECK(image.getPixel(3, 3) == sf::Color(2, 138, 255, 104));
+    }
+}
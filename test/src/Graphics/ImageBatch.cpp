@@ -0,0 +1,86 @@
+#include <SFML/Graphics/ImageBatch.hpp>
+#include <SFML/System/Err.hpp>
+#include "GraphicsUtil.hpp"
+#include <sstream>
+#include <vector>
+
+TEST_CASE("sf::ImageBatch class", "[graphics]")
+{
+    // Encode a few images of different sizes and colors
+    const std::size_t imageCount = 9;
+    std::vector<std::vector<sf::Uint8> > files(imageCount);
+    for (std::size_t i = 0; i < imageCount; ++i)
+    {
+        sf::Image image;
+        image.create(static_cast<unsigned int>(i + 1), 3, sf::Color(static_cast<sf::Uint8>(i * 20), 100, 200));
+        REQUIRE(image.saveToMemory(files[i], "png"));
+    }
+
+    SECTION("Empty batch")
+    {
+        sf::ImageBatch batch;
+        CHECK(batch.getImageCount() == 0);
+        CHECK(batch.getProgress() == 1.f);
+
+        batch.launch();
+        batch.wait();
+        CHECK(!batch.isLoading());
+    }
+
+    SECTION("Load from memory")
+    {
+        sf::ImageBatch batch;
+        for (std::size_t i = 0; i < imageCount; ++i)
+            CHECK(batch.addFromMemory(&files[i][0], files[i].size()) == i);
+
+        const char invalid[] = "not an image";
+        std::size_t invalidIndex = batch.addFromMemory(invalid, sizeof(invalid));
+        CHECK(batch.getImageCount() == imageCount + 1);
+        CHECK(batch.getProgress() == 0.f);
+
+        batch.launch(3);
+        batch.wait();
+        CHECK(!batch.isLoading());
+        CHECK(batch.getProgress() == 1.f);
+
+        for (std::size_t i = 0; i < imageCount; ++i)
+        {
+            REQUIRE(batch.isLoaded(i));
+            CHECK(batch.getImage(i).getSize() == sf::Vector2u(static_cast<unsigned int>(i + 1), 3));
+            CHECK(batch.getImage(i).getPixel(0, 2) == sf::Color(static_cast<sf::Uint8>(i * 20), 100, 200));
+        }
+        CHECK(!batch.isLoaded(invalidIndex));
+        CHECK(batch.getImage(invalidIndex).getSize() == sf::Vector2u(0, 0));
+
+        // Images added afterwards are loaded by the next launch
+        std::size_t index = batch.addFromMemory(&files[0][0], files[0].size());
+        CHECK(!batch.isLoaded(index));
+        CHECK(batch.getImage(index).getSize() == sf::Vector2u(0, 0));
+        batch.launch();
+        batch.wait();
+        CHECK(batch.isLoaded(index));
+
+        batch.clear();
+        CHECK(batch.getImageCount() == 0);
+    }
+
+    SECTION("Errors")
+    {
+        sf::ImageBatch batch;
+        const char invalid[] = "not an image";
+        batch.addFromMemory(invalid, sizeof(invalid));
+        batch.addFromMemory(invalid, sizeof(invalid));
+
+        // The messages of the workers are written by the thread that waits for them
+        std::ostringstream errors;
+        std::streambuf* previous = sf::err().rdbuf(errors.rdbuf());
+        batch.launch(2);
+        batch.wait();
+        sf::err().rdbuf(previous);
+
+        std::string messages = errors.str();
+        std::size_t first = messages.find("Failed to load image from memory");
+        REQUIRE(first != std::string::npos);
+        CHECK(messages.find("Failed to load image from memory", first + 1) != std::string::npos);
+    }
+}
@@ -0,0 +1,70 @@
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include "GraphicsUtil.hpp"
+
+TEST_CASE("sf::ParticleSystem class", "[graphics]")
+{
+    SECTION("Default constructor")
+    {
+        sf::ParticleSystem particles;
+        CHECK(particles.getParticleCount() == 0);
+        CHECK(particles.getTexture() == NULL);
+        CHECK(particles.getParticleSize() == sf::Vector2f(1.f, 1.f));
+        CHECK(particles.getAcceleration() == sf::Vector2f(0.f, 0.f));
+        CHECK(particles.isFadingEnabled());
+        CHECK(particles.getUploadedByteCount() == 0);
+    }
+
+    SECTION("Emission")
+    {
+        sf::ParticleSystem particles;
+        particles.emit(sf::Vector2f(1.f, 2.f), sf::Vector2f(0.f, 0.f), sf::seconds(1.f));
+        particles.emit(sf::Vector2f(3.f, 4.f), sf::Vector2f(0.f, 0.f), sf::Time::Zero);
+        REQUIRE(particles.getParticleCount() == 1);
+        CHECK(particles.getParticlePosition(0) == sf::Vector2f(1.f, 2.f));
+
+        particles.clear();
+        CHECK(particles.getParticleCount() == 0);
+    }
+
+    SECTION("Simulation")
+    {
+        // Enough particles to go through both the vector and the scalar paths
+        const std::size_t count = 11;
+
+        sf::ParticleSystem particles;
+        particles.setAcceleration(sf::Vector2f(0.f, 10.f));
+        for (std::size_t i = 0; i < count; ++i)
+            particles.emit(sf::Vector2f(static_cast<float>(i), 0.f), sf::Vector2f(2.f, 0.f), sf::seconds(10.f));
+
+        particles.update(sf::seconds(0.5f));
+        REQUIRE(particles.getParticleCount() == count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Vector2f position = particles.getParticlePosition(i);
+            CHECK(position.x == Approx(static_cast<float>(i) + 1.f));
+            CHECK(position.y == Approx(2.5f));
+        }
+
+        particles.update(sf::seconds(0.5f));
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Vector2f position = particles.getParticlePosition(i);
+            CHECK(position.x == Approx(static_cast<float>(i) + 2.f));
+            CHECK(position.y == Approx(7.5f));
+        }
+    }
+
+    SECTION("Expiration")
+    {
+        sf::ParticleSystem particles;
+        for (int i = 0; i < 10; ++i)
+            particles.emit(sf::Vector2f(0.f, 0.f), sf::Vector2f(0.f, 0.f), sf::seconds(i % 2 ? 1.f : 3.f));
+        CHECK(particles.getParticleCount() == 10);
+
+        particles.update(sf::seconds(2.f));
+        CHECK(particles.getParticleCount() == 5);
+
+        particles.update(sf::seconds(2.f));
+        CHECK(particles.getParticleCount() == 0);
+    }
+}
@@ -0,0 +1,131 @@
+#include <SFML/Graphics/SceneIndex.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/View.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+TEST_CASE("sf::SceneIndex class", "[graphics]")
+{
+    sf::RectangleShape shape(sf::Vector2f(10.f, 10.f));
+    std::vector<std::size_t> result;
+
+    SECTION("Empty index")
+    {
+        sf::SceneIndex index;
+        CHECK(index.getObjectCount() == 0);
+        CHECK(index.getDrawnCount() == 0);
+        CHECK(index.getCulledCount() == 0);
+
+        index.query(sf::FloatRect(-100.f, -100.f, 200.f, 200.f), result);
+        CHECK(result.empty());
+    }
+
+    SECTION("Range queries")
+    {
+        sf::SceneIndex index(32.f);
+        std::size_t a = index.add(shape, sf::FloatRect(0.f, 0.f, 10.f, 10.f));
+        std::size_t b = index.add(shape, sf::FloatRect(100.f, 0.f, 10.f, 10.f));
+        std::size_t c = index.add(shape, sf::FloatRect(-50.f, -50.f, 70.f, 70.f));
+        CHECK(index.getObjectCount() == 3);
+        CHECK(index.getDrawable(a) == &shape);
+
+        index.query(sf::FloatRect(5.f, 5.f, 1.f, 1.f), result);
+        REQUIRE(result.size() == 2);
+        CHECK(result[0] == a);
+        CHECK(result[1] == c);
+
+        index.query(sf::FloatRect(95.f, -5.f, 10.f, 10.f), result);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] == b);
+
+        index.query(sf::FloatRect(-1000.f, -1000.f, 2000.f, 2000.f), result);
+        REQUIRE(result.size() == 3);
+        CHECK(result[0] == a);
+        CHECK(result[1] == b);
+        CHECK(result[2] == c);
+
+        index.query(sf::FloatRect(500.f, 500.f, 10.f, 10.f), result);
+        CHECK(result.empty());
+    }
+
+    SECTION("Moving and removing objects")
+    {
+        sf::SceneIndex index(32.f);
+        std::size_t a = index.add(shape, sf::FloatRect(0.f, 0.f, 10.f, 10.f));
+        std::size_t b = index.add(shape, sf::FloatRect(40.f, 0.f, 10.f, 10.f));
+
+        index.setBounds(a, sf::FloatRect(300.f, 300.f, 10.f, 10.f));
+        CHECK(index.getBounds(a) == sf::FloatRect(300.f, 300.f, 10.f, 10.f));
+
+        index.query(sf::FloatRect(0.f, 0.f, 20.f, 20.f), result);
+        CHECK(result.empty());
+
+        index.query(sf::FloatRect(305.f, 305.f, 1.f, 1.f), result);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] == a);
+
+        index.remove(b);
+        CHECK(index.getObjectCount() == 1);
+        CHECK(index.getDrawable(b) == NULL);
+
+        index.query(sf::FloatRect(-1000.f, -1000.f, 2000.f, 2000.f), result);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] == a);
+
+        // Removed identifiers are reused
+        std::size_t c = index.add(shape);
+        CHECK(c == b);
+        CHECK(index.getBounds(c) == shape.getGlobalBounds());
+
+        index.clear();
+        CHECK(index.getObjectCount() == 0);
+    }
+
+    SECTION("Large objects")
+    {
+        sf::SceneIndex index(1.f);
+        std::size_t a = index.add(shape, sf::FloatRect(-5000.f, -5000.f, 10000.f, 10000.f));
+
+        index.query(sf::FloatRect(4000.f, 4000.f, 1.f, 1.f), result);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] == a);
+
+        index.setBounds(a, sf::FloatRect(0.f, 0.f, 0.5f, 0.5f));
+        index.query(sf::FloatRect(4000.f, 4000.f, 1.f, 1.f), result);
+        CHECK(result.empty());
+    }
+
+    SECTION("Copy")
+    {
+        sf::SceneIndex index(32.f);
+        std::size_t a = index.add(shape, sf::FloatRect(0.f, 0.f, 10.f, 10.f));
+
+        sf::SceneIndex copy(index);
+        index.remove(a);
+        copy.query(sf::FloatRect(5.f, 5.f, 1.f, 1.f), result);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] == a);
+
+        index = copy;
+        index.query(sf::FloatRect(5.f, 5.f, 1.f, 1.f), result);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] == a);
+    }
+
+    SECTION("View queries")
+    {
+        sf::SceneIndex index(32.f);
+        std::size_t a = index.add(shape, sf::FloatRect(0.f, 0.f, 10.f, 10.f));
+        index.add(shape, sf::FloatRect(200.f, 0.f, 10.f, 10.f));
+
+        sf::View view(sf::FloatRect(0.f, 0.f, 100.f, 100.f));
+        index.query(view, result);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] == a);
+
+        view.setCenter(205.f, 5.f);
+        index.query(view, result);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] != a);
+    }
+}
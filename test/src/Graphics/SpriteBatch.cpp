@@ -0,0 +1,145 @@
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include "GraphicsUtil.hpp"
+
+TEST_CASE("sf::SpriteBatch class", "[graphics]")
+{
+    SECTION("Default constructor")
+    {
+        sf::SpriteBatch batch;
+        CHECK(batch.getSpriteCount() == 0);
+        CHECK(!batch.isTextureSortingEnabled());
+        CHECK(batch.getDrawCallCount() == 0);
+        CHECK(batch.getUploadedByteCount() == 0);
+    }
+
+    SECTION("Sprites without texture")
+    {
+        sf::SpriteBatch batch;
+        batch.reserve(10);
+        batch.add(sf::Sprite());
+        CHECK(batch.getSpriteCount() == 0);
+    }
+
+    SECTION("Texture sorting")
+    {
+        sf::SpriteBatch batch;
+        batch.setTextureSortingEnabled(true);
+        CHECK(batch.isTextureSortingEnabled());
+
+        batch.setTextureSortingEnabled(false);
+        CHECK(!batch.isTextureSortingEnabled());
+    }
+
+    SECTION("Copy")
+    {
+        sf::SpriteBatch batch;
+        batch.setTextureSortingEnabled(true);
+
+        sf::SpriteBatch copy(batch);
+        CHECK(copy.isTextureSortingEnabled());
+        CHECK(copy.getSpriteCount() == 0);
+
+        sf::SpriteBatch assigned;
+        assigned = copy;
+        CHECK(assigned.isTextureSortingEnabled());
+        CHECK(assigned.getDrawCallCount() == 0);
+    }
+}
+
+// Textures and vertex buffers need an OpenGL context, so this test case is hidden
+// by default; run it on a machine with a display with: test-sfml-graphics [display]
+TEST_CASE("sf::SpriteBatch drawing", "[graphics][.display]")
+{
+    const std::size_t spriteBytes = 6 * sizeof(sf::Vertex);
+    const sf::IntRect rect(0, 0, 4, 4);
+
+    sf::Image image;
+    image.create(4, 4, sf::Color::Red);
+    sf::Texture red;
+    REQUIRE(red.loadFromImage(image));
+
+    image.create(4, 4, sf::Color::Blue);
+    sf::Texture blue;
+    REQUIRE(blue.loadFromImage(image));
+
+    sf::RenderTexture target;
+    REQUIRE(target.create(16, 4));
+
+    SECTION("Draw calls and uploads")
+    {
+        sf::SpriteBatch batch;
+        batch.add(red, rect);
+        batch.add(blue, rect, sf::Transform().translate(4.f, 0.f));
+        batch.add(red, rect, sf::Transform().translate(8.f, 0.f));
+        REQUIRE(batch.getSpriteCount() == 3);
+
+        // One draw call each time the texture changes
+        target.draw(batch);
+        CHECK(batch.getDrawCallCount() == 3);
+        CHECK(batch.getUploadedByteCount() == 3 * spriteBytes);
+
+        // Nothing changed
+        target.draw(batch);
+        CHECK(batch.getDrawCallCount() == 3);
+        CHECK(batch.getUploadedByteCount() == 0);
+
+        // Sorting groups the sprites of the same texture
+        batch.setTextureSortingEnabled(true);
+        target.draw(batch);
+        CHECK(batch.getDrawCallCount() == 2);
+        CHECK(batch.getUploadedByteCount() == 3 * spriteBytes);
+
+        // Adding a sprite uploads the whole batch again
+        batch.add(blue, rect, sf::Transform().translate(12.f, 0.f));
+        target.draw(batch);
+        CHECK(batch.getDrawCallCount() == 2);
+        CHECK(batch.getUploadedByteCount() == 4 * spriteBytes);
+
+        batch.clear();
+        target.draw(batch);
+        CHECK(batch.getDrawCallCount() == 0);
+        CHECK(batch.getUploadedByteCount() == 0);
+    }
+
+    SECTION("Generated vertices")
+    {
+        sf::SpriteBatch batch;
+        batch.add(red, rect);
+        batch.add(blue, rect, sf::Transform().translate(4.f, 0.f));
+        batch.add(red, rect, sf::Transform().translate(8.f, 0.f), sf::Color::Black);
+
+        target.clear(sf::Color::Green);
+        target.draw(batch);
+        target.display();
+
+        sf::Image pixels = target.getTexture().copyToImage();
+        CHECK(pixels.getPixel(1, 1) == sf::Color::Red);
+        CHECK(pixels.getPixel(6, 2) == sf::Color::Blue);
+        CHECK(pixels.getPixel(10, 3) == sf::Color::Black);
+        CHECK(pixels.getPixel(13, 1) == sf::Color::Green);
+    }
+
+    SECTION("Ordering")
+    {
+        // Three sprites drawn at the same place: the last one drawn is visible
+        sf::SpriteBatch batch;
+        batch.add(red, rect);
+        batch.add(blue, rect);
+        batch.add(red, rect);
+
+        // Without sorting, the insertion order is kept
+        target.clear();
+        target.draw(batch);
+        target.display();
+        CHECK(target.getTexture().copyToImage().getPixel(1, 1) == sf::Color::Red);
+
+        // With sorting, the textures are drawn in the order of their first use
+        batch.setTextureSortingEnabled(true);
+        target.clear();
+        target.draw(batch);
+        target.display();
+        CHECK(target.getTexture().copyToImage().getPixel(1, 1) == sf::Color::Blue);
+    }
+}
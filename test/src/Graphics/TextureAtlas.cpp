@@ -0,0 +1,95 @@
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include "GraphicsUtil.hpp"
+
+// Textures need an OpenGL context, so this test case is hidden by default;
+// run it on a machine with a display with: test-sfml-graphics [display]
+TEST_CASE("sf::TextureAtlas class", "[graphics][.display]")
+{
+    sf::Image small;
+    small.create(10, 10, sf::Color::Red);
+
+    sf::Image large;
+    large.create(500, 500, sf::Color::Blue);
+
+    SECTION("Insertion")
+    {
+        sf::TextureAtlas atlas;
+        CHECK(atlas.getTextureCount() == 0);
+
+        std::size_t first = atlas.add(small);
+        std::size_t second = atlas.add(small);
+        REQUIRE(first == 0);
+        REQUIRE(second == 1);
+        CHECK(atlas.getTextureCount() == 1);
+        CHECK(atlas.getTextureIndex(first) == 0);
+        CHECK(atlas.getTextureRect(first).width == 10);
+        CHECK(atlas.getTextureRect(first).height == 10);
+
+        // Images don't overlap, and are separated by padding
+        CHECK(!atlas.getTextureRect(first).intersects(atlas.getTextureRect(second)));
+
+        // The pixels are copied to the texture
+        sf::Image pixels = atlas.getTexture(0).copyToImage();
+        sf::IntRect rect = atlas.getTextureRect(second);
+        CHECK(pixels.getPixel(rect.left, rect.top) == sf::Color::Red);
+    }
+
+    SECTION("Invalid images")
+    {
+        sf::TextureAtlas atlas(256);
+        CHECK(atlas.add(sf::Image()) == sf::TextureAtlas::InvalidIndex);
+        CHECK(atlas.add(large) == sf::TextureAtlas::InvalidIndex);
+        CHECK(atlas.getTextureCount() == 0);
+    }
+
+    SECTION("Growth")
+    {
+        sf::TextureAtlas atlas(512);
+
+        // The first texture grows to fit the image
+        std::size_t first = atlas.add(large);
+        REQUIRE(first != sf::TextureAtlas::InvalidIndex);
+        CHECK(atlas.getTextureCount() == 1);
+        CHECK(atlas.getTexture(0).getSize() == sf::Vector2u(512, 512));
+
+        // The next texture starts small again
+        std::size_t second = atlas.add(small);
+        REQUIRE(second != sf::TextureAtlas::InvalidIndex);
+        CHECK(atlas.getTextureCount() == 2);
+        CHECK(atlas.getTextureIndex(second) == 1);
+        CHECK(atlas.getTexture(1).getSize() == sf::Vector2u(256, 256));
+    }
+
+    SECTION("Removal")
+    {
+        sf::TextureAtlas atlas;
+        std::size_t first = atlas.add(small);
+        atlas.add(small);
+
+        atlas.remove(first);
+        CHECK(atlas.getTextureIndex(first) == sf::TextureAtlas::InvalidIndex);
+
+        // The index of the removed image is reused
+        CHECK(atlas.add(small) == first);
+        CHECK(atlas.getTextureIndex(first) == 0);
+    }
+
+    SECTION("Repack")
+    {
+        sf::TextureAtlas atlas(512);
+        std::size_t first = atlas.add(large);
+        std::size_t second = atlas.add(small);
+        REQUIRE(atlas.getTextureCount() == 2);
+
+        // Removing the large image empties the first texture, which is released
+        atlas.remove(first);
+        CHECK(atlas.repack());
+        CHECK(atlas.getTextureCount() == 1);
+        CHECK(atlas.getTextureIndex(second) == 0);
+
+        sf::Image pixels = atlas.getTexture(0).copyToImage();
+        sf::IntRect rect = atlas.getTextureRect(second);
+        CHECK(rect.width == 10);
+        CHECK(pixels.getPixel(rect.left, rect.top) == sf::Color::Red);
+    }
+}
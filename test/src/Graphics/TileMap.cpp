@@ -0,0 +1,124 @@
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+TEST_CASE("sf::TileMap class", "[graphics]")
+{
+    SECTION("Default constructor")
+    {
+        sf::TileMap map;
+        CHECK(map.getSize() == sf::Vector2u(0, 0));
+        CHECK(map.getTexture() == NULL);
+        CHECK(map.getTile(0, 0) == sf::TileMap::EmptyTile);
+        CHECK(map.getLocalBounds() == sf::FloatRect(0.f, 0.f, 0.f, 0.f));
+        CHECK(map.getDrawnChunkCount() == 0);
+        CHECK(map.getUploadedByteCount() == 0);
+        CHECK(map.getChunkCacheSize() == 256);
+        CHECK(map.getCachedChunkCount() == 0);
+    }
+
+    SECTION("Creation")
+    {
+        sf::TileMap map;
+        map.create(sf::Vector2u(100, 50), sf::Vector2u(16, 8), 32);
+        CHECK(map.getSize() == sf::Vector2u(100, 50));
+        CHECK(map.getTileSize() == sf::Vector2u(16, 8));
+        CHECK(map.getChunkSize() == 32);
+        CHECK(map.getTile(99, 49) == sf::TileMap::EmptyTile);
+        CHECK(map.getLocalBounds() == sf::FloatRect(0.f, 0.f, 1600.f, 400.f));
+
+        map.setPosition(10.f, 20.f);
+        CHECK(map.getGlobalBounds() == sf::FloatRect(10.f, 20.f, 1600.f, 400.f));
+    }
+
+    SECTION("Tiles")
+    {
+        sf::TileMap map;
+        map.create(sf::Vector2u(10, 10), sf::Vector2u(16, 16), 4);
+
+        map.setTile(3, 7, 42);
+        CHECK(map.getTile(3, 7) == 42);
+        CHECK(map.getTile(7, 3) == sf::TileMap::EmptyTile);
+
+        // Out of the map
+        map.setTile(10, 0, 1);
+        CHECK(map.getTile(10, 0) == sf::TileMap::EmptyTile);
+
+        std::vector<sf::Uint32> tiles(100);
+        for (std::size_t i = 0; i < tiles.size(); ++i)
+            tiles[i] = static_cast<sf::Uint32>(i);
+        map.setTiles(&tiles[0]);
+        CHECK(map.getTile(0, 0) == 0);
+        CHECK(map.getTile(9, 0) == 9);
+        CHECK(map.getTile(3, 7) == 73);
+        CHECK(map.getTile(9, 9) == 99);
+    }
+}
+
+// Vertex buffers need an OpenGL context, so this test case is hidden by default;
+// run it on a machine with a display with: test-sfml-graphics [display]
+TEST_CASE("sf::TileMap drawing", "[graphics][.display]")
+{
+    if (!sf::VertexBuffer::isAvailable())
+        return;
+
+    const std::size_t tileBytes = 6 * sizeof(sf::Vertex);
+    const sf::View firstChunk(sf::FloatRect(0.f, 0.f, 100.f, 100.f));
+    const sf::View otherChunk(sf::FloatRect(200.f, 200.f, 40.f, 40.f));
+
+    sf::RenderTexture target;
+    REQUIRE(target.create(64, 64));
+    target.setView(firstChunk);
+
+    // A 4x4 grid of chunks of 8x8 tiles, 128x128 pixels each
+    sf::TileMap map;
+    map.create(sf::Vector2u(32, 32), sf::Vector2u(16, 16), 8);
+    std::vector<sf::Uint32> tiles(32 * 32, 0);
+    map.setTiles(&tiles[0]);
+
+    SECTION("Upload")
+    {
+        target.draw(map);
+        CHECK(map.getDrawnChunkCount() == 1);
+        CHECK(map.getCachedChunkCount() == 1);
+        CHECK(map.getUploadedByteCount() == 64 * tileBytes);
+
+        // Nothing changed
+        target.draw(map);
+        CHECK(map.getUploadedByteCount() == 0);
+
+        // Tiles in opposite corners of a chunk are uploaded separately
+        map.setTile(0, 0, 1);
+        map.setTile(7, 7, 1);
+        target.draw(map);
+        CHECK(map.getUploadedByteCount() == 2 * tileBytes);
+
+        // Adjacent tiles are uploaded together
+        map.setTile(1, 0, 1);
+        map.setTile(2, 0, 1);
+        target.draw(map);
+        CHECK(map.getUploadedByteCount() == 2 * tileBytes);
+    }
+
+    SECTION("Eviction")
+    {
+        map.setChunkCacheSize(1);
+        CHECK(map.getChunkCacheSize() == 1);
+
+        target.draw(map);
+        CHECK(map.getCachedChunkCount() == 1);
+
+        // Drawing another chunk releases the first one
+        target.setView(otherChunk);
+        target.draw(map);
+        CHECK(map.getCachedChunkCount() == 1);
+        CHECK(map.getUploadedByteCount() == 64 * tileBytes);
+
+        // So it is uploaded again when it becomes visible
+        target.setView(firstChunk);
+        target.draw(map);
+        CHECK(map.getCachedChunkCount() == 1);
+        CHECK(map.getUploadedByteCount() == 64 * tileBytes);
+    }
+}
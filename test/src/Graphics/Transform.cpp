@@ -0,0 +1,127 @@
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    // Fill an array with points that are not aligned on a grid
+    std::vector<sf::Vector2f> makePoints(std::size_t count)
+    {
+        std::vector<sf::Vector2f> points(count);
+        for (std::size_t i = 0; i < count; ++i)
+            points[i] = sf::Vector2f(static_cast<float>(i) * 1.5f - 3.f, static_cast<float>(i % 7) * -2.25f + 1.f);
+        return points;
+    }
+
+    void checkPoints(const sf::Transform& transform, std::size_t count)
+    {
+        std::vector<sf::Vector2f> points = makePoints(count);
+        std::vector<sf::Vector2f> result(count);
+        transform.transformPoints(&points[0], &result[0], count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Vector2f expected = transform.transformPoint(points[i]);
+            CHECK(result[i].x == Approx(expected.x));
+            CHECK(result[i].y == Approx(expected.y));
+        }
+    }
+}
+
+TEST_CASE("sf::Transform class", "[graphics]")
+{
+    SECTION("transformPoints with Vector2f")
+    {
+        SECTION("Identity")
+        {
+            checkPoints(sf::Transform::Identity, 9);
+        }
+
+        SECTION("Translation")
+        {
+            sf::Transform transform;
+            transform.translate(10.f, -4.f);
+            checkPoints(transform, 9);
+        }
+
+        SECTION("General transform")
+        {
+            sf::Transform transform;
+            transform.translate(10.f, -4.f).rotate(30.f).scale(2.f, 0.5f);
+            checkPoints(transform, 1);
+            checkPoints(transform, 2);
+            checkPoints(transform, 17);
+        }
+
+        SECTION("In place")
+        {
+            sf::Transform transform;
+            transform.rotate(45.f).scale(3.f, 3.f);
+
+            std::vector<sf::Vector2f> points = makePoints(5);
+            std::vector<sf::Vector2f> original = points;
+            transform.transformPoints(&points[0], &points[0], points.size());
+
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                sf::Vector2f expected = transform.transformPoint(original[i]);
+                CHECK(points[i].x == Approx(expected.x));
+                CHECK(points[i].y == Approx(expected.y));
+            }
+        }
+    }
+
+    SECTION("transformPoints with Vertex")
+    {
+        sf::Transform transform;
+        transform.translate(-1.f, 2.f).rotate(60.f).scale(1.5f, -2.f);
+
+        std::vector<sf::Vector2f> positions = makePoints(7);
+        std::vector<sf::Vertex> vertices(positions.size());
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+            vertices[i] = sf::Vertex(positions[i], sf::Color(static_cast<sf::Uint8>(i * 30), 20, 40), sf::Vector2f(static_cast<float>(i), 5.f));
+
+        SECTION("Separate arrays")
+        {
+            std::vector<sf::Vertex> result(vertices.size());
+            transform.transformPoints(&vertices[0], &result[0], vertices.size());
+
+            for (std::size_t i = 0; i < vertices.size(); ++i)
+            {
+                sf::Vector2f expected = transform.transformPoint(vertices[i].position);
+                CHECK(result[i].position.x == Approx(expected.x));
+                CHECK(result[i].position.y == Approx(expected.y));
+                CHECK(result[i].color == vertices[i].color);
+                CHECK(result[i].texCoords == vertices[i].texCoords);
+            }
+        }
+
+        SECTION("In place")
+        {
+            std::vector<sf::Vertex> result = vertices;
+            transform.transformPoints(&result[0], &result[0], result.size());
+
+            for (std::size_t i = 0; i < vertices.size(); ++i)
+            {
+                sf::Vector2f expected = transform.transformPoint(vertices[i].position);
+                CHECK(result[i].position.x == Approx(expected.x));
+                CHECK(result[i].position.y == Approx(expected.y));
+                CHECK(result[i].color == vertices[i].color);
+                CHECK(result[i].texCoords == vertices[i].texCoords);
+            }
+        }
+    }
+
+    SECTION("transformRect")
+    {
+        sf::Transform transform;
+        transform.translate(5.f, 5.f).scale(2.f, 3.f);
+
+        sf::FloatRect rect = transform.transformRect(sf::FloatRect(1.f, 2.f, 10.f, 20.f));
+        CHECK(rect.left == Approx(7.f));
+        CHECK(rect.top == Approx(11.f));
+        CHECK(rect.width == Approx(20.f));
+        CHECK(rect.height == Approx(60.f));
+    }
+}